@@ -278,6 +278,11 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
     case CommandLineController::ConvertType::Batch:
         ret = converter()->batchConvert(task.inputFile, stylePath, forceMode);
         break;
+    case CommandLineController::ConvertType::BatchParallel: {
+        size_t workersCount = task.params[CommandLineController::ParamKey::BatchWorkersCount].toUInt();
+        io::path_t reportPath = task.params[CommandLineController::ParamKey::BatchReportPath].toString();
+        ret = converter()->batchConvertParallel(task.inputFile, workersCount, reportPath, stylePath, forceMode);
+    } break;
     case CommandLineController::ConvertType::ConvertScoreParts:
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
         break;
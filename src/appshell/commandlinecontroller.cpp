@@ -54,6 +54,13 @@ void CommandLineController::parse(const QStringList& args)
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("job-workers",
+                                          "Use with '-j <file>', process jobs concurrently on the given number of workers (0 - one per CPU core) "
+                                          "and continue on failures",
+                                          "count"));
+    m_parser.addOption(QCommandLineOption("job-report",
+                                          "Use with '--job-workers', write a JSON summary of the job results to 'file' instead of stdout",
+                                          "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -209,6 +216,20 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::Batch;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("job-workers")) {
+            std::optional<int> val = intValue("job-workers");
+            if (val && val.value() >= 0) {
+                m_converterTask.type = ConvertType::BatchParallel;
+                m_converterTask.params[CommandLineController::ParamKey::BatchWorkersCount] = val.value();
+            } else {
+                LOGE() << "Option: --job-workers not recognized workers count: " << m_parser.value("job-workers");
+            }
+        }
+
+        if (m_parser.isSet("job-report")) {
+            m_converterTask.params[CommandLineController::ParamKey::BatchReportPath] = m_parser.value("job-report");
+        }
     }
 
     if (m_parser.isSet("score-media")) {
@@ -57,6 +57,7 @@ public:
     enum class ConvertType {
         File,
         Batch,
+        BatchParallel,
         ConvertScoreParts,
         ExportScoreMedia,
         ExportScoreMeta,
@@ -73,6 +74,8 @@ public:
         ScoreSource,
         ScoreTransposeOptions,
         ForceMode,
+        BatchWorkersCount,
+        BatchReportPath,
 
         // Video
     };
@@ -36,6 +36,8 @@ public:
     virtual Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                             bool forceMode = false) = 0;
     virtual Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
+    virtual Ret batchConvertParallel(const io::path_t& batchJobFile, size_t workersCount, const io::path_t& reportPath = io::path_t(),
+                                     const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
     virtual Ret convertScoreParts(const io::path_t& in, const io::path_t& out,
                                   const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
 
@@ -32,9 +32,12 @@
 
 #include "io/buffer.h"
 
+#include "concurrency/concurrency.h"
+
 #include "engraving/compat/scoreaccess.h"
 #include "engraving/infrastructure/io/mscwriter.h"
 #include "engraving/libmscore/excerpt.h"
+#include "engraving/libmscore/page.h"
 
 #include "backendjsonwriter.h"
 #include "notationmeta.h"
@@ -223,16 +226,6 @@ RetVal<project::INotationProjectPtr> BackendApi::openProject(const io::path_t& p
     return RetVal<INotationProjectPtr>::make_ok(notationProject);
 }
 
-PageList BackendApi::pages(const INotationPtr notation)
-{
-    auto elements = notation->elements();
-    if (!elements) {
-        return {};
-    }
-
-    return elements->pages();
-}
-
 QVariantMap BackendApi::readBeatsColors(const io::path_t& filePath)
 {
     TRACEFUNC
@@ -281,27 +274,21 @@ Ret BackendApi::exportScorePngs(const INotationPtr notation, BackendJsonWriter&
     jsonWriter.addKey("pngs");
     jsonWriter.openArray();
 
-    PageList notationPages = pages(notation);
+    INotationWriter::Options options {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
+    };
+
+    std::vector<RetVal<QByteArray> > pngs = writePages(pngWriter, notation, options);
 
     bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray pngData;
-        QBuffer pngDevice(&pngData);
-        pngDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
-        };
-
-        Ret writeRet = pngWriter->write(notation, pngDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
+    for (size_t i = 0; i < pngs.size(); ++i) {
+        if (!pngs[i].ret) {
+            LOGW() << pngs[i].ret.toString();
             result = false;
         }
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(pngData.toBase64(), !lastArrayValue);
+        bool lastArrayValue = ((pngs.size() - 1) == i);
+        jsonWriter.addValue(pngs[i].val, !lastArrayValue);
     }
 
     jsonWriter.closeArray(addSeparator);
@@ -323,29 +310,24 @@ Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const io::path_t& h
     jsonWriter.addKey("svgs");
     jsonWriter.openArray();
 
-    PageList notationPages = pages(notation);
     QVariantMap beatsColors = readBeatsColors(highlightConfigPath);
 
+    INotationWriter::Options options {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
+        { INotationWriter::OptionKey::BEATS_COLORS, Val(beatsColors) }
+    };
+
+    std::vector<RetVal<QByteArray> > svgs = writePages(svgWriter, notation, options);
+
     bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray svgData;
-        QBuffer svgDevice(&svgData);
-        svgDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
-            { INotationWriter::OptionKey::BEATS_COLORS, Val(beatsColors) }
-        };
-
-        Ret writeRet = svgWriter->write(notation, svgDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
+    for (size_t i = 0; i < svgs.size(); ++i) {
+        if (!svgs[i].ret) {
+            LOGW() << svgs[i].ret.toString();
             result = false;
         }
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(svgData.toBase64(), !lastArrayValue);
+        bool lastArrayValue = ((svgs.size() - 1) == i);
+        jsonWriter.addValue(svgs[i].val, !lastArrayValue);
     }
 
     jsonWriter.closeArray(addSeparator);
@@ -353,6 +335,66 @@ Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const io::path_t& h
     return result ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
 }
 
+std::vector<RetVal<QByteArray> > BackendApi::writePages(INotationWriterPtr writer, const INotationPtr notation,
+                                                         const INotationWriter::Options& options)
+{
+    TRACEFUNC
+
+    Score* score = notation->elements()->msScore();
+    const std::vector<Page*>& scorePages = score->pages();
+
+    std::vector<RetVal<QByteArray> > result(scorePages.size());
+
+    auto writePage = [writer, notation, &options, &result](size_t pageIndex) {
+        QByteArray data;
+        QBuffer device(&data);
+        device.open(QIODevice::ReadWrite);
+
+        INotationWriter::Options pageOptions = options;
+        pageOptions[INotationWriter::OptionKey::PAGE_NUMBER] = Val(static_cast<int>(pageIndex));
+
+        RetVal<QByteArray>& pageResult = result[pageIndex];
+        pageResult.ret = writer->write(notation, device, pageOptions);
+        pageResult.val = data.toBase64();
+    };
+
+    if (scorePages.empty()) {
+        return result;
+    }
+
+    //! NOTE The first page is written on the calling thread,
+    //! it resolves the lazy dependencies of the writer and fills the caches of the score (fonts, header and footer texts, repeat list),
+    //! after that the pages are only read by the writers, so the rest of them are written concurrently
+    writePage(0);
+
+    size_t threadsCount = canWritePagesConcurrently(score) ? concurrency::idealThreadCount() : 1;
+    if (threadsCount > 1) {
+        for (Page* page : scorePages) {
+            page->ensureBspTree();
+        }
+    }
+
+    concurrency::parallelFor(scorePages.size() - 1, threadsCount, [&writePage](size_t i) {
+        writePage(i + 1);
+    }, "page_writer");
+
+    return result;
+}
+
+bool BackendApi::canWritePagesConcurrently(const Score* score)
+{
+    //! NOTE Images are drawn through QPixmap, that can be used only in the GUI thread
+    for (const Page* page : score->pages()) {
+        for (const EngravingItem* element : page->elements()) {
+            if (element->isImage()) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 Ret BackendApi::exportScoreElementsPositions(const std::string& elementsPositionsWriterName, const INotationPtr notation,
                                              BackendJsonWriter& jsonWriter, bool addSeparator)
 {
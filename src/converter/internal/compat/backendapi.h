@@ -61,13 +61,15 @@ private:
     static RetVal<project::INotationProjectPtr> openProject(const io::path_t& path,
                                                             const io::path_t& stylePath = io::path_t(), bool forceMode = false);
 
-    static notation::PageList pages(const notation::INotationPtr notation);
-
     static QVariantMap readBeatsColors(const io::path_t& filePath);
 
     static Ret exportScorePngs(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScoreSvgs(const notation::INotationPtr notation, const io::path_t& highlightConfigPath, BackendJsonWriter& jsonWriter,
                                bool addSeparator = false);
+    static std::vector<RetVal<QByteArray> > writePages(project::INotationWriterPtr writer, const notation::INotationPtr notation,
+                                                       const project::INotationWriter::Options& options);
+    static bool canWritePagesConcurrently(const mu::engraving::Score* score);
+
     static Ret exportScoreElementsPositions(const std::string& elementsPositionsWriterName, const notation::INotationPtr notation,
                                             BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScorePdf(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
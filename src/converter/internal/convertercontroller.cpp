@@ -26,10 +26,12 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QElapsedTimer>
 
 #include "convertercodes.h"
 #include "stringutils.h"
 #include "compat/backendapi.h"
+#include "concurrency/concurrency.h"
 
 #include "log.h"
 
@@ -62,39 +64,155 @@ mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const
     return ret;
 }
 
+mu::Ret ConverterController::batchConvertParallel(const io::path_t& batchJobFile, size_t workersCount, const io::path_t& reportPath,
+                                                  const io::path_t& stylePath, bool forceMode)
+{
+    TRACEFUNC;
+
+    RetVal<BatchJob> batchJob = parseBatchJob(batchJobFile);
+    if (!batchJob.ret) {
+        LOGE() << "failed parse batch job file, err: " << batchJob.ret.toString();
+        return batchJob.ret;
+    }
+
+    if (workersCount == 0) {
+        workersCount = concurrency::idealThreadCount();
+    }
+
+    const std::vector<Job> jobs(batchJob.val.begin(), batchJob.val.end());
+    std::vector<JobResult> results(jobs.size());
+
+    //! NOTE Only the writers that can be instantiated for every job run in parallel,
+    //! the jobs of the other writers (audio, ...) share the registered writer and run one by one afterwards
+    std::vector<project::INotationWriterPtr> jobWriters(jobs.size());
+    std::vector<size_t> parallelJobs;
+    std::vector<size_t> serialJobs;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobWriters[i] = writers()->newWriter(io::suffix(jobs[i].out));
+        if (jobWriters[i]) {
+            parallelJobs.push_back(i);
+        } else {
+            serialJobs.push_back(i);
+        }
+    }
+
+    LOGI() << "jobs: " << jobs.size() << ", parallel: " << parallelJobs.size() << ", workers: " << workersCount;
+
+    auto runJob = [&](size_t i, project::INotationWriterPtr writer, bool makeCurrent) {
+        const Job& job = jobs[i];
+
+        QElapsedTimer timer;
+        timer.start();
+
+        LOGI() << "in: " << job.in << ", out: " << job.out;
+
+        JobResult& result = results[i];
+        if (writer) {
+            RetVal<project::INotationProjectPtr> project = loadProject(job.in, stylePath, forceMode);
+            result.ret = project.ret;
+
+            if (project.ret) {
+                if (makeCurrent) {
+                    globalContext()->setCurrentProject(project.val);
+                }
+
+                //! NOTE Unlike fileConvert, that only fails if the score can't be loaded, the report records a failed export too
+                result.ret = exportProject(writer, project.val, job.out);
+            }
+        } else {
+            result.ret = make_ret(Err::ConvertTypeUnknown);
+        }
+        result.elapsedMs = timer.elapsed();
+
+        if (!result.ret) {
+            LOGE() << "failed convert, err: " << result.ret.toString() << ", in: " << job.in << ", out: " << job.out;
+        }
+    };
+
+    //! NOTE Every parallel job owns its project, its score and its writer, and its project isn't made current.
+    //! What the jobs still share is made safe for concurrent use:
+    //! - the measure index of a score is rebuilt under a mutex into an immutable snapshot (Score::measureIndex);
+    //! - the render state (printing, pixel ratio) is per thread (RenderContext);
+    //! - symbols are drawn with a copy of the shared score font, and each page caches its own header and footer texts.
+    //! A failed job is recorded in the report and doesn't stop the others.
+    concurrency::parallelFor(parallelJobs.size(), workersCount, [&](size_t n) {
+        size_t i = parallelJobs[n];
+        runJob(i, jobWriters[i], false);
+    }, "converter");
+
+    for (size_t i : serialJobs) {
+        runJob(i, writers()->writer(io::suffix(jobs[i].out)), true);
+    }
+
+    Ret ret = writeBatchReport(jobs, results, reportPath);
+    if (!ret) {
+        return ret;
+    }
+
+    for (const JobResult& result : results) {
+        if (!result.ret) {
+            return result.ret;
+        }
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode)
 {
     TRACEFUNC;
 
     LOGI() << "in: " << in << ", out: " << out;
-    auto notationProject = notationCreator()->newProject();
-    IF_ASSERT_FAILED(notationProject) {
-        return make_ret(Err::UnknownError);
-    }
 
-    std::string suffix = io::suffix(out);
-    auto writer = writers()->writer(suffix);
+    auto writer = writers()->writer(io::suffix(out));
     if (!writer) {
         return make_ret(Err::ConvertTypeUnknown);
     }
 
-    Ret ret = notationProject->load(in, stylePath, forceMode);
-    if (!ret) {
-        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
-        return make_ret(Err::InFileFailedLoad);
+    RetVal<project::INotationProjectPtr> project = loadProject(in, stylePath, forceMode);
+    if (!project.ret) {
+        return project.ret;
     }
 
-    globalContext()->setCurrentProject(notationProject);
+    globalContext()->setCurrentProject(project.val);
 
-    if (isConvertPageByPage(suffix)) {
-        ret = convertPageByPage(writer, notationProject->masterNotation()->notation(), out);
-    } else {
-        ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
-    }
+    exportProject(writer, project.val, out);
 
     return make_ret(Ret::Code::Ok);
 }
 
+mu::RetVal<INotationProjectPtr> ConverterController::loadProject(const io::path_t& in, const io::path_t& stylePath, bool forceMode)
+{
+    TRACEFUNC;
+
+    RetVal<INotationProjectPtr> rv;
+    rv.val = notationCreator()->newProject();
+    IF_ASSERT_FAILED(rv.val) {
+        rv.ret = make_ret(Err::UnknownError);
+        return rv;
+    }
+
+    rv.ret = rv.val->load(in, stylePath, forceMode);
+    if (!rv.ret) {
+        LOGE() << "failed load notation, err: " << rv.ret.toString() << ", path: " << in;
+        rv.ret = make_ret(Err::InFileFailedLoad);
+    }
+
+    return rv;
+}
+
+mu::Ret ConverterController::exportProject(project::INotationWriterPtr writer, INotationProjectPtr notationProject,
+                                           const io::path_t& out) const
+{
+    TRACEFUNC;
+
+    if (isConvertPageByPage(io::suffix(out))) {
+        return convertPageByPage(writer, notationProject->masterNotation()->notation(), out);
+    }
+
+    return convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
+}
+
 mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const mu::io::path_t& out, const mu::io::path_t& stylePath,
                                                bool forceMode)
 {
@@ -165,6 +283,55 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     return rv;
 }
 
+mu::Ret ConverterController::writeBatchReport(const std::vector<Job>& jobs, const std::vector<JobResult>& results,
+                                             const io::path_t& reportPath) const
+{
+    TRACEFUNC;
+
+    QJsonArray jobsArr;
+    size_t failedCount = 0;
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const Job& job = jobs.at(i);
+        const JobResult& result = results.at(i);
+
+        QJsonObject obj;
+        obj["in"] = job.in.toQString();
+        obj["out"] = job.out.toQString();
+        obj["success"] = result.ret.success();
+        obj["code"] = result.ret.code();
+        obj["elapsedMs"] = static_cast<qint64>(result.elapsedMs);
+        if (!result.ret) {
+            obj["error"] = QString::fromStdString(result.ret.toString());
+            ++failedCount;
+        }
+
+        jobsArr.append(obj);
+    }
+
+    QJsonObject rootObj;
+    rootObj["total"] = static_cast<int>(jobs.size());
+    rootObj["failed"] = static_cast<int>(failedCount);
+    rootObj["jobs"] = jobsArr;
+
+    QFile file;
+    bool ok = false;
+    if (!reportPath.empty()) {
+        file.setFileName(reportPath.toQString());
+        ok = file.open(QFile::WriteOnly);
+    } else {
+        ok = file.open(stdout, QFile::WriteOnly);
+    }
+
+    if (!ok) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    ok = file.write(QJsonDocument(rootObj).toJson(QJsonDocument::Compact)) != -1;
+
+    return ok ? make_ret(Ret::Code::Ok) : make_ret(Err::OutFileFailedWrite);
+}
+
 bool ConverterController::isConvertPageByPage(const std::string& suffix) const
 {
     QList<std::string> types {
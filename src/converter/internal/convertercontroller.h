@@ -23,6 +23,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -48,6 +49,8 @@ public:
     Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                     bool forceMode = false) override;
     Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+    Ret batchConvertParallel(const io::path_t& batchJobFile, size_t workersCount, const io::path_t& reportPath = io::path_t(),
+                             const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                           bool forceMode = false) override;
 
@@ -76,7 +79,16 @@ private:
 
     using BatchJob = std::list<Job>;
 
+    struct JobResult {
+        Ret ret;
+        int64_t elapsedMs = 0;
+    };
+
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
+    Ret writeBatchReport(const std::vector<Job>& jobs, const std::vector<JobResult>& results, const io::path_t& reportPath) const;
+
+    RetVal<project::INotationProjectPtr> loadProject(const io::path_t& in, const io::path_t& stylePath, bool forceMode);
+    Ret exportProject(project::INotationWriterPtr writer, project::INotationProjectPtr notationProject, const io::path_t& out) const;
 
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
@@ -24,6 +24,7 @@
 
 #include <string>
 #include <map>
+#include <mutex>
 
 #include "../iengravingelementsprovider.h"
 
@@ -66,6 +67,9 @@ private:
         int unregCount = 0;
     };
 
+    //! NOTE Elements can be created and deleted by the parallel phase of the layout
+    std::mutex m_mutex;
+
     std::map<std::string, ObjectStatistic> m_statistics;
 
     EngravingObjectList m_elements;
@@ -205,6 +205,18 @@ void EventList::insert(const Event& e)
     push_back(e);
 }
 
+//---------------------------------------------------------
+//   EventMap::merge
+//    moves the events of the other map into this one,
+//    after the events of this map with the same time
+//---------------------------------------------------------
+
+void EventMap::merge(EventMap& other)
+{
+    std::multimap<int, NPlayEvent>::merge(other);
+    registerChannel(other._highestChannel);
+}
+
 //---------------------------------------------------------
 //   class EventMap::fixupMIDI
 //---------------------------------------------------------
@@ -168,6 +168,7 @@ class EventMap : public std::multimap<int, NPlayEvent>
     int _highestChannel = 15;
 public:
     void fixupMIDI();
+    void merge(EventMap& other);
     void registerChannel(int c)
     {
         if (c > _highestChannel) {
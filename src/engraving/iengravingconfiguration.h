@@ -46,6 +46,9 @@ public:
     virtual QString partStyleFilePath() const = 0;
     virtual void setPartStyleFilePath(const QString& path) = 0;
 
+    //! NOTE The dir, where the metrics of the score fonts are cached between the runs
+    virtual QString scoreFontsCachePath() const = 0;
+
     virtual std::string iconsFontFamily() const = 0;
 
     virtual draw::Color defaultColor() const = 0;
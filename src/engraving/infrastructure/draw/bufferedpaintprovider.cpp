@@ -107,8 +107,39 @@ const DrawData::State& BufferedPaintProvider::currentState() const
     return currentData().state;
 }
 
-DrawData::Data& BufferedPaintProvider::editableData()
+DrawData::Data& BufferedPaintProvider::editableData(DrawKind kind)
 {
+    //! NOTE Draws of different kinds are stored separately, so to keep the order of the draws,
+    //! start a new data if a draw of a kind, that is replayed later, has already been added
+    DrawData::Data& data = m_currentObjects.top().datas.back();
+    bool hasLaterDraws = false;
+    switch (kind) {
+    case DrawKind::Path:
+        hasLaterDraws = !data.polygons.empty();
+    // fall through
+    case DrawKind::Polygon:
+        hasLaterDraws = hasLaterDraws || !data.texts.empty();
+    // fall through
+    case DrawKind::Text:
+        hasLaterDraws = hasLaterDraws || !data.rectTexts.empty();
+    // fall through
+    case DrawKind::RectText:
+        hasLaterDraws = hasLaterDraws || !data.pixmaps.empty();
+    // fall through
+    case DrawKind::Pixmap:
+        hasLaterDraws = hasLaterDraws || !data.tiledPixmap.empty();
+    // fall through
+    case DrawKind::TiledPixmap:
+        break;
+    }
+
+    if (!hasLaterDraws) {
+        return data;
+    }
+
+    DrawData::Data newData;
+    newData.state = data.state;
+    m_currentObjects.top().datas.push_back(std::move(newData));
     return m_currentObjects.top().datas.back();
 }
 
@@ -174,10 +205,17 @@ const Brush& BufferedPaintProvider::brush() const
 
 void BufferedPaintProvider::save()
 {
+    m_savedStates.push(currentState());
 }
 
 void BufferedPaintProvider::restore()
 {
+    if (m_savedStates.empty()) {
+        return;
+    }
+
+    editableState() = m_savedStates.top();
+    m_savedStates.pop();
 }
 
 void BufferedPaintProvider::setTransform(const Transform& transform)
@@ -202,7 +240,8 @@ void BufferedPaintProvider::drawPath(const PainterPath& path)
     } else if (st.brush.style() == BrushStyle::NoBrush) {
         mode = DrawMode::Stroke;
     }
-    editableData().paths.push_back({ path, st.pen, st.brush, mode });
+    DrawPath pathData { path, st.pen, st.brush, mode };
+    editableData(DrawKind::Path).paths.push_back(std::move(pathData));
 }
 
 void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount, PolygonMode mode)
@@ -211,17 +250,17 @@ void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount,
     for (size_t i = 0; i < pointCount; ++i) {
         pol[i] = PointF(points[i].x(), points[i].y());
     }
-    editableData().polygons.push_back(DrawPolygon { pol, mode });
+    editableData(DrawKind::Polygon).polygons.push_back(DrawPolygon { pol, mode });
 }
 
 void BufferedPaintProvider::drawText(const PointF& point, const QString& text)
 {
-    editableData().texts.push_back(DrawText { point, text });
+    editableData(DrawKind::Text).texts.push_back(DrawText { point, text });
 }
 
 void BufferedPaintProvider::drawText(const RectF& rect, int flags, const QString& text)
 {
-    editableData().rectTexts.push_back(DrawRectText { rect, flags, text });
+    editableData(DrawKind::RectText).rectTexts.push_back(DrawRectText { rect, flags, text });
 }
 
 void BufferedPaintProvider::drawTextWorkaround(const Font& f, const PointF& pos, const QString& text)
@@ -237,23 +276,23 @@ void BufferedPaintProvider::drawSymbol(const PointF& point, uint ucs4Code)
 
 void BufferedPaintProvider::drawPixmap(const PointF& p, const Pixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, pm });
+    editableData(DrawKind::Pixmap).pixmaps.push_back(DrawPixmap { p, pm });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
+    editableData(DrawKind::TiledPixmap).tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
 }
 
 #ifndef NO_QT_SUPPORT
 void BufferedPaintProvider::drawPixmap(const PointF& p, const QPixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, Pixmap::fromQPixmap(pm) });
+    editableData(DrawKind::Pixmap).pixmaps.push_back(DrawPixmap { p, Pixmap::fromQPixmap(pm) });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, Pixmap::fromQPixmap(pm), offset });
+    editableData(DrawKind::TiledPixmap).tiledPixmap.push_back(DrawTiledPixmap { rect, Pixmap::fromQPixmap(pm), offset });
 }
 
 #endif
@@ -278,4 +317,6 @@ void BufferedPaintProvider::clear()
     m_buf = DrawData();
     std::stack<DrawData::Object> empty;
     m_currentObjects.swap(empty);
+    std::stack<DrawData::State> emptyStates;
+    m_savedStates.swap(emptyStates);
 }
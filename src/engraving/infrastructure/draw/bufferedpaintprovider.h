@@ -93,14 +93,25 @@ public:
 
 private:
 
+    //! NOTE The kinds of draws in the order they are replayed within one data
+    enum class DrawKind {
+        Path,
+        Polygon,
+        Text,
+        RectText,
+        Pixmap,
+        TiledPixmap
+    };
+
     const DrawData::Data& currentData() const;
-    DrawData::Data& editableData();
+    DrawData::Data& editableData(DrawKind kind);
 
     const DrawData::State& currentState() const;
     DrawData::State& editableState();
 
     DrawData m_buf;
     std::stack<DrawData::Object> m_currentObjects;
+    std::stack<DrawData::State> m_savedStates;
     bool m_isActive = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
 };
@@ -94,6 +94,11 @@ RectF FontMetrics::tightBoundingRect(const QString& string) const
     return fontProvider()->tightBoundingRect(m_font, string);
 }
 
+std::vector<qreal> FontMetrics::characterPositions(const QString& string) const
+{
+    return fontProvider()->characterPositions(m_font, string);
+}
+
 bool FontMetrics::inFont(QChar ch) const
 {
     return fontProvider()->inFont(m_font, ch);
@@ -52,6 +52,8 @@ public:
     RectF boundingRect(const RectF& r, int flags, const QString& string) const;
     RectF tightBoundingRect(const QString& string) const;
 
+    std::vector<qreal> characterPositions(const QString& string) const;
+
     bool inFont(QChar ch) const;
     bool inFontUcs4(uint ucs4) const;
 
@@ -23,6 +23,9 @@
 #ifndef MU_DRAW_IFONTPROVIDER_H
 #define MU_DRAW_IFONTPROVIDER_H
 
+#include <cstdint>
+#include <vector>
+
 #include "modularity/imoduleexport.h"
 
 #include "font.h"
@@ -57,9 +60,23 @@ public:
     virtual RectF boundingRect(const Font& f, const RectF& r, int flags, const QString& string) const = 0;
     virtual RectF tightBoundingRect(const Font& f, const QString& string) const = 0;
 
+    // The horizontal advance of the string up to (and including) each of its UTF-16 code units
+    virtual std::vector<qreal> characterPositions(const Font& f, const QString& string) const = 0;
+
     // Score symbols
     virtual RectF symBBox(const Font& f, uint ucs4, qreal DPI_F) const = 0;
     virtual qreal symAdvance(const Font& f, uint ucs4, qreal DPI_F) const = 0;
+
+    // Metrics cache
+    struct CacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+
+        double hitRate() const { return hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    virtual CacheStats cacheStats() const = 0;
+    virtual void resetCacheStats() = 0;
 };
 }
 
@@ -0,0 +1,39 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_DRAW_DRAWDATAPAINT_H
+#define MU_DRAW_DRAWDATAPAINT_H
+
+#include "../buffereddrawtypes.h"
+
+namespace mu::draw {
+class Painter;
+
+//! NOTE Replays draw data, recorded by BufferedPaintProvider, into any painter.
+//! The recorded transforms are combined with the current transform of the painter.
+class DrawDataPaint
+{
+public:
+    static void paint(Painter& painter, const DrawData& data, double fontScaling = 1.0);
+};
+}
+
+#endif // MU_DRAW_DRAWDATAPAINT_H
@@ -37,6 +37,8 @@ set (ENGRAVING_INFRASTRUCTURE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/draw/utils/drawjson.h
     ${CMAKE_CURRENT_LIST_DIR}/draw/utils/drawcomp.cpp
     ${CMAKE_CURRENT_LIST_DIR}/draw/utils/drawcomp.h
+    ${CMAKE_CURRENT_LIST_DIR}/draw/utils/drawdatapaint.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/draw/utils/drawdatapaint.h
 
     ${CMAKE_CURRENT_LIST_DIR}/interactive/messagebox.cpp
     ${CMAKE_CURRENT_LIST_DIR}/interactive/messagebox.h
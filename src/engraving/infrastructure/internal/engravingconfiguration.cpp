@@ -36,6 +36,10 @@ static const Settings::Key PART_STYLE_FILE_PATH("engraving", "engraving/style/pa
 
 static const Settings::Key INVERT_SCORE_COLOR("engraving", "engraving/scoreColorInversion");
 
+//! NOTE 0 - as many threads as cores, 1 - serial
+static const Settings::Key LAYOUT_THREADS("engraving", "engraving/layout/threads");
+static const Settings::Key MIDI_RENDER_THREADS("engraving", "engraving/midi/renderThreads");
+
 struct VoiceColorKey {
     Settings::Key key;
     Color color;
@@ -57,6 +61,20 @@ void EngravingConfiguration::init()
         m_scoreInversionChanged.notify();
     });
 
+    settings()->setDefaultValue(LAYOUT_THREADS, Val(1));
+    settings()->setCanBeManuallyEdited(LAYOUT_THREADS, true);
+    settings()->valueChanged(LAYOUT_THREADS).onReceive(this, [](const Val& val) {
+        MScore::layoutThreads = val.toInt();
+    });
+    MScore::layoutThreads = settings()->value(LAYOUT_THREADS).toInt();
+
+    settings()->setDefaultValue(MIDI_RENDER_THREADS, Val(1));
+    settings()->setCanBeManuallyEdited(MIDI_RENDER_THREADS, true);
+    settings()->valueChanged(MIDI_RENDER_THREADS).onReceive(this, [](const Val& val) {
+        MScore::midiRenderThreads = val.toInt();
+    });
+    MScore::midiRenderThreads = settings()->value(MIDI_RENDER_THREADS).toInt();
+
     for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
         Settings::Key key("engraving", "engraving/colors/voice" + std::to_string(voice + 1));
 
@@ -93,6 +111,11 @@ void EngravingConfiguration::setPartStyleFilePath(const QString& path)
     settings()->setSharedValue(PART_STYLE_FILE_PATH, Val(path.toStdString()));
 }
 
+QString EngravingConfiguration::scoreFontsCachePath() const
+{
+    return (globalConfiguration()->userAppDataPath() + "/scorefonts").toQString();
+}
+
 std::string EngravingConfiguration::iconsFontFamily() const
 {
     return uiConfiguration()->iconsFontFamily();
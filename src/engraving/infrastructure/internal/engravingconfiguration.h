@@ -25,6 +25,7 @@
 #include "async/asyncable.h"
 
 #include "modularity/ioc.h"
+#include "iglobalconfiguration.h"
 #include "ui/iuiconfiguration.h"
 #include "accessibility/iaccessibilityconfiguration.h"
 
@@ -33,6 +34,7 @@
 namespace mu::engraving {
 class EngravingConfiguration : public IEngravingConfiguration, public async::Asyncable
 {
+    INJECT(engraving, mu::framework::IGlobalConfiguration, globalConfiguration)
     INJECT(engraving, mu::ui::IUiConfiguration, uiConfiguration)
     INJECT(engraving, mu::accessibility::IAccessibilityConfiguration, accessibilityConfiguration)
 
@@ -47,6 +49,8 @@ public:
     QString partStyleFilePath() const override;
     void setPartStyleFilePath(const QString& path) override;
 
+    QString scoreFontsCachePath() const override;
+
     std::string iconsFontFamily() const override;
 
     draw::Color defaultColor() const override;
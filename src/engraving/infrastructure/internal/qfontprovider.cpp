@@ -23,6 +23,7 @@
 
 #include <QFontDatabase>
 #include <QFontMetricsF>
+#include <QTextLayout>
 
 #include "libmscore/mscore.h"
 #include "fontengineft.h"
@@ -52,85 +53,256 @@ protected:
 
 static FontPaintDevice device;
 
+static constexpr int MAX_CACHED_TEXTS_PER_FONT = 10000;
+
 int QFontProvider::addApplicationFont(const QString& family, const QString& path)
 {
-    m_paths[family] = path;
+    {
+        std::lock_guard<std::mutex> lock(m_symEnginesMutex);
+        m_paths[family] = path;
+    }
+    clearCache();
     return QFontDatabase::addApplicationFont(path);
 }
 
 void QFontProvider::insertSubstitution(const QString& familyName, const QString& substituteName)
 {
     QFont::insertSubstitution(familyName, substituteName);
+    clearCache();
 }
 
 qreal QFontProvider::lineSpacing(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).lineSpacing();
+    return fontMetric(f, &FontCache::lineSpacing);
 }
 
 qreal QFontProvider::xHeight(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).xHeight();
+    return fontMetric(f, &FontCache::xHeight);
 }
 
 qreal QFontProvider::height(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).height();
+    return fontMetric(f, &FontCache::height);
 }
 
 qreal QFontProvider::ascent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).ascent();
+    return fontMetric(f, &FontCache::ascent);
 }
 
 qreal QFontProvider::descent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).descent();
+    return fontMetric(f, &FontCache::descent);
 }
 
 bool QFontProvider::inFont(const Font& f, QChar ch) const
 {
-    return QFontMetricsF(f.toQFont(), &device).inFont(ch);
+    return inFontUcs4(f, ch.unicode());
 }
 
 bool QFontProvider::inFontUcs4(const Font& f, uint ucs4) const
 {
-    return QFontMetricsF(f.toQFont(), &device).inFontUcs4(ucs4);
+    return glyphMetric(f, ucs4, &GlyphMetrics::inFont, [ucs4](const QFontMetricsF& fm) {
+        return fm.inFontUcs4(ucs4);
+    });
 }
 
 qreal QFontProvider::horizontalAdvance(const Font& f, const QString& string) const
 {
-    return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(string);
+    return textMetric(f, string, &TextMetrics::advance, [&string](const QFontMetricsF& fm) {
+        return fm.horizontalAdvance(string);
+    });
 }
 
 qreal QFontProvider::horizontalAdvance(const Font& f, const QChar& ch) const
 {
-    return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(ch);
+    return glyphMetric(f, ch.unicode(), &GlyphMetrics::advance, [ch](const QFontMetricsF& fm) {
+        return fm.horizontalAdvance(ch);
+    });
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const QString& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(string));
+    return textMetric(f, string, &TextMetrics::boundingRect, [&string](const QFontMetricsF& fm) {
+        return RectF::fromQRectF(fm.boundingRect(string));
+    });
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const QChar& ch) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(ch));
+    return glyphMetric(f, ch.unicode(), &GlyphMetrics::boundingRect, [ch](const QFontMetricsF& fm) {
+        return RectF::fromQRectF(fm.boundingRect(ch));
+    });
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const RectF& r, int flags, const QString& string) const
 {
+    //! NOTE Depends on the rect and the flags, so isn't cached
     return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(r.toQRectF(), flags, string));
 }
 
 RectF QFontProvider::tightBoundingRect(const Font& f, const QString& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).tightBoundingRect(string));
+    return textMetric(f, string, &TextMetrics::tightBoundingRect, [&string](const QFontMetricsF& fm) {
+        return RectF::fromQRectF(fm.tightBoundingRect(string));
+    });
+}
+
+std::vector<qreal> QFontProvider::characterPositions(const Font& f, const QString& string) const
+{
+    return textMetric(f, string, &TextMetrics::positions, [&string, &f](const QFontMetricsF&) {
+        //! NOTE The string is shaped once, instead of measuring each of its prefixes.
+        //! cursorToX() gives the visual positions, but the prefixes are measured in the logical order,
+        //! so the direction is forced to left-to-right, also for the right-to-left characters (by the override mark)
+        static const QChar LEFT_TO_RIGHT_OVERRIDE(0x202D);
+
+        QTextOption option;
+        option.setTextDirection(Qt::LeftToRight);
+
+        QTextLayout layout(LEFT_TO_RIGHT_OVERRIDE + string, f.toQFont(), &device);
+        layout.setTextOption(option);
+        layout.beginLayout();
+        QTextLine line = layout.createLine();
+        layout.endLayout();
+
+        std::vector<qreal> positions;
+        positions.reserve(string.size());
+        for (int i = 1; i <= string.size(); ++i) {
+            positions.push_back(line.isValid() ? line.cursorToX(i + 1) : 0.0);
+        }
+        return positions;
+    });
+}
+
+// Cache
+IFontProvider::CacheStats QFontProvider::cacheStats() const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    return m_cacheStats;
+}
+
+void QFontProvider::resetCacheStats()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cacheStats = CacheStats();
+}
+
+//! NOTE The fonts compare the point size fuzzily, which can't be hashed,
+//! so the cache compares it rounded, the same way it hashes it
+static qint64 roundedPointSize(const Font& f)
+{
+    return qRound64(f.pointSizeF() * 100.0);
+}
+
+size_t QFontProvider::FontHash::operator()(const Font& f) const
+{
+    return qHash(f.family()) ^ qHash(roundedPointSize(f)) ^ (static_cast<size_t>(f.weight()) << 8)
+           ^ (static_cast<size_t>(f.bold()) << 16) ^ (static_cast<size_t>(f.italic()) << 17)
+           ^ (static_cast<size_t>(f.underline()) << 18) ^ (static_cast<size_t>(f.strike()) << 19)
+           ^ (static_cast<size_t>(f.noFontMerging()) << 20) ^ (static_cast<size_t>(f.hinting()) << 21);
+}
+
+bool QFontProvider::FontEqual::operator()(const Font& f1, const Font& f2) const
+{
+    return f1.family() == f2.family()
+           && roundedPointSize(f1) == roundedPointSize(f2)
+           && f1.weight() == f2.weight()
+           && f1.bold() == f2.bold()
+           && f1.italic() == f2.italic()
+           && f1.underline() == f2.underline()
+           && f1.strike() == f2.strike()
+           && f1.noFontMerging() == f2.noFontMerging()
+           && f1.hinting() == f2.hinting();
+}
+
+qreal QFontProvider::fontMetric(const Font& f, qreal FontCache::* metric) const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (m_fontCaches.find(f) != m_fontCaches.end()) {
+        ++m_cacheStats.hits;
+    } else {
+        ++m_cacheStats.misses;
+    }
+    return fontCache(f)->*metric;
+}
+
+//! NOTE Must be called with the cache locked
+QFontProvider::FontCache* QFontProvider::fontCache(const Font& f) const
+{
+    auto it = m_fontCaches.find(f);
+    if (it != m_fontCaches.end()) {
+        return it->second.get();
+    }
+
+    QFontMetricsF fm(f.toQFont(), &device);
+    std::unique_ptr<FontCache> cache = std::make_unique<FontCache>();
+    cache->lineSpacing = fm.lineSpacing();
+    cache->xHeight = fm.xHeight();
+    cache->height = fm.height();
+    cache->ascent = fm.ascent();
+    cache->descent = fm.descent();
+
+    return m_fontCaches.emplace(f, std::move(cache)).first->second.get();
+}
+
+void QFontProvider::clearCache()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_fontCaches.clear();
+}
+
+template<typename T, typename Compute>
+T QFontProvider::glyphMetric(const Font& f, uint ucs4, std::optional<T> GlyphMetrics::* metric, Compute compute) const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        const FontCache* cache = fontCache(f);
+        auto it = cache->glyphs.find(ucs4);
+        if (it != cache->glyphs.end() && (it->second.*metric).has_value()) {
+            ++m_cacheStats.hits;
+            return *(it->second.*metric);
+        }
+        ++m_cacheStats.misses;
+    }
+
+    //! NOTE Qt is asked without the lock, so the other threads aren't blocked meanwhile
+    T value = compute(QFontMetricsF(f.toQFont(), &device));
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    fontCache(f)->glyphs[ucs4].*metric = value;
+    return value;
+}
+
+template<typename T, typename Compute>
+T QFontProvider::textMetric(const Font& f, const QString& string, std::optional<T> TextMetrics::* metric, Compute compute) const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        const FontCache* cache = fontCache(f);
+        auto it = cache->texts.constFind(string);
+        if (it != cache->texts.constEnd() && (it.value().*metric).has_value()) {
+            ++m_cacheStats.hits;
+            return *(it.value().*metric);
+        }
+        ++m_cacheStats.misses;
+    }
+
+    T value = compute(QFontMetricsF(f.toQFont(), &device));
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    FontCache* cache = fontCache(f);
+    if (cache->texts.size() >= MAX_CACHED_TEXTS_PER_FONT && !cache->texts.contains(string)) {
+        cache->texts.clear();
+    }
+    cache->texts[string].*metric = value;
+    return value;
 }
 
 // Score symbols
 RectF QFontProvider::symBBox(const Font& f, uint ucs4, qreal dpi_f) const
 {
+    std::lock_guard<std::mutex> lock(m_symEnginesMutex);
     FontEngineFT* engine = symEngine(f);
     if (!engine) {
         return RectF();
@@ -140,6 +312,7 @@ RectF QFontProvider::symBBox(const Font& f, uint ucs4, qreal dpi_f) const
 
 qreal QFontProvider::symAdvance(const Font& f, uint ucs4, qreal dpi_f) const
 {
+    std::lock_guard<std::mutex> lock(m_symEnginesMutex);
     FontEngineFT* engine = symEngine(f);
     if (!engine) {
         return 0.0;
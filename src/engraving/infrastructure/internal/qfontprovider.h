@@ -22,6 +22,11 @@
 #ifndef MU_DRAW_QFONTPROVIDER_H
 #define MU_DRAW_QFONTPROVIDER_H
 
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 #include <QHash>
 #include "infrastructure/draw/ifontprovider.h"
 
@@ -53,16 +58,68 @@ public:
     RectF boundingRect(const Font& f, const RectF& r, int flags, const QString& string) const override;
     RectF tightBoundingRect(const Font& f, const QString& string) const override;
 
+    std::vector<qreal> characterPositions(const Font& f, const QString& string) const override;
+
     // Score symbols
     RectF symBBox(const Font& f, uint ucs4, qreal DPI_F) const override;
     qreal symAdvance(const Font& f, uint ucs4, qreal DPI_F) const override;
 
+    CacheStats cacheStats() const override;
+    void resetCacheStats() override;
+
 private:
 
+    //! NOTE Qt is asked once for the metrics of a font, a character or a string,
+    //! then they are served from the cache, until the fonts change
+    struct GlyphMetrics {
+        std::optional<qreal> advance;
+        std::optional<RectF> boundingRect;
+        std::optional<bool> inFont;
+    };
+
+    struct TextMetrics {
+        std::optional<qreal> advance;
+        std::optional<RectF> boundingRect;
+        std::optional<RectF> tightBoundingRect;
+        std::optional<std::vector<qreal> > positions;
+    };
+
+    struct FontCache {
+        qreal lineSpacing = 0.0;
+        qreal xHeight = 0.0;
+        qreal height = 0.0;
+        qreal ascent = 0.0;
+        qreal descent = 0.0;
+        std::unordered_map<uint /*ucs4*/, GlyphMetrics> glyphs;
+        QHash<QString, TextMetrics> texts;
+    };
+
+    struct FontHash {
+        size_t operator()(const Font& f) const;
+    };
+
+    struct FontEqual {
+        bool operator()(const Font& f1, const Font& f2) const;
+    };
+
+    qreal fontMetric(const Font& f, qreal FontCache::* metric) const;
+    FontCache* fontCache(const Font& f) const;
+    void clearCache();
+
+    template<typename T, typename Compute>
+    T glyphMetric(const Font& f, uint ucs4, std::optional<T> GlyphMetrics::* metric, Compute compute) const;
+    template<typename T, typename Compute>
+    T textMetric(const Font& f, const QString& string, std::optional<T> TextMetrics::* metric, Compute compute) const;
+
     FontEngineFT* symEngine(const Font& f) const;
 
+    mutable std::unordered_map<Font, std::unique_ptr<FontCache>, FontHash, FontEqual> m_fontCaches;
+    mutable CacheStats m_cacheStats;
+    mutable std::mutex m_cacheMutex; // the metrics are asked from the layout threads concurrently
+
     QHash<QString /*family*/, QString /*path*/> m_paths;
     mutable QHash<QString /*path*/, FontEngineFT*> m_symEngines;
+    mutable std::mutex m_symEnginesMutex; // the engines are created lazily and aren't reentrant, guards m_paths too
 };
 }
 
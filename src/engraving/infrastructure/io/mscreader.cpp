@@ -156,6 +156,11 @@ ByteArray MscReader::readScoreFile() const
     return fileData(mscxFileName);
 }
 
+bool MscReader::isConcurrentReadingSupported() const
+{
+    return reader()->isConcurrentReadingSupported();
+}
+
 std::vector<QString> MscReader::excerptNames() const
 {
     if (!reader()->isContainer()) {
@@ -285,6 +290,12 @@ bool MscReader::ZipFileReader::isContainer() const
     return true;
 }
 
+bool MscReader::ZipFileReader::isConcurrentReadingSupported() const
+{
+    //! NOTE ZipReader serializes the access to the device, only inflating runs concurrently
+    return true;
+}
+
 StringList MscReader::ZipFileReader::fileList() const
 {
     IF_ASSERT_FAILED(m_zip) {
@@ -354,6 +365,12 @@ bool MscReader::DirReader::isContainer() const
     return FileInfo::exists(m_rootPath + "/META-INF/container.xml");
 }
 
+bool MscReader::DirReader::isConcurrentReadingSupported() const
+{
+    //! NOTE Every file is opened separately
+    return true;
+}
+
 StringList MscReader::DirReader::fileList() const
 {
     StringList files;
@@ -415,6 +432,12 @@ bool MscReader::XmlFileReader::isContainer() const
     return true;
 }
 
+bool MscReader::XmlFileReader::isConcurrentReadingSupported() const
+{
+    //! NOTE Every file is searched for and parsed from the beginning of the same device
+    return false;
+}
+
 StringList MscReader::XmlFileReader::fileList() const
 {
     if (!m_device) {
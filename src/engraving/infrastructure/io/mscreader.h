@@ -58,6 +58,10 @@ public:
     ByteArray readStyleFile() const;
     ByteArray readScoreFile() const;
 
+    //! NOTE Whether the files can be read from several threads at once:
+    //! true for a zip and a directory, false for a single xml file, which is parsed from one shared device
+    bool isConcurrentReadingSupported() const;
+
     std::vector<QString> excerptNames() const;
     ByteArray readExcerptStyleFile(const QString& name) const;
     ByteArray readExcerptFile(const QString& name) const;
@@ -84,6 +88,7 @@ private:
         //! it may happen that we are not reading a container (a directory with a certain structure),
         //! but only one file among others (`.mscx` from MU 3.x)
         virtual bool isContainer() const = 0;
+        virtual bool isConcurrentReadingSupported() const = 0;
         virtual StringList fileList() const = 0;
         virtual ByteArray fileData(const QString& fileName) const = 0;
     };
@@ -95,6 +100,7 @@ private:
         void close() override;
         bool isOpened() const override;
         bool isContainer() const override;
+        bool isConcurrentReadingSupported() const override;
         StringList fileList() const override;
         ByteArray fileData(const QString& fileName) const override;
     private:
@@ -109,6 +115,7 @@ private:
         void close() override;
         bool isOpened() const override;
         bool isContainer() const override;
+        bool isConcurrentReadingSupported() const override;
         StringList fileList() const override;
         ByteArray fileData(const QString& fileName) const override;
     private:
@@ -121,6 +128,7 @@ private:
         void close() override;
         bool isOpened() const override;
         bool isContainer() const override;
+        bool isConcurrentReadingSupported() const override;
         StringList fileList() const override;
         ByteArray fileData(const QString& fileName) const override;
     private:
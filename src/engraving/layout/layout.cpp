@@ -72,11 +72,37 @@ public:
     ~CmdStateLocker() { m_score->cmdState().unlock(); }
 };
 
+//---------------------------------------------------------
+//   markPagesChanged
+//    the pages collected again get a new revision when
+//    they are collected (Page::invalidateBspTree), the
+//    others keep their systems and elements; only if the
+//    number of pages changed, their headers and footers
+//    (page count macros) may have changed too
+//---------------------------------------------------------
+
+static void markPagesChanged(Score* score, size_t oldPagesCount)
+{
+    if (score->npages() == oldPagesCount) {
+        return;
+    }
+
+    for (Page* page : score->pages()) {
+        page->markContentChanged();
+    }
+}
+
 Layout::Layout(Score* score)
     : m_score(score)
 {
 }
 
+//! NOTE The range layout starts at the system before the range and lays out the systems
+//! until a new system ends where a system of the previous layout ended (see
+//! LayoutSystem::takeOverOldSystems) and a page ends where the same page ended before.
+//! There is no tracking of dirty systems or pages: everything from the start of the range
+//! up to that point is laid out again, and the pages only converge by position, so an edit
+//! that moves a system to another page collects all the following pages again.
 void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(m_score);
@@ -86,6 +112,8 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
     Fraction etick(et);
     Q_ASSERT(!(stick == Fraction(-1, 1) && etick == Fraction(-1, 1)));
 
+    const size_t oldPagesCount = m_score->npages();
+
     if (!m_score->last() || (options.isLinearMode() && !m_score->firstMeasure())) {
         LOGD("empty score");
         qDeleteAll(m_score->_systems);
@@ -93,6 +121,7 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         qDeleteAll(m_score->pages());
         m_score->pages().clear();
         LayoutPage::getNextPage(options, ctx);
+        m_lastStatistics = ctx.statistics;
         return;
     }
 
@@ -105,6 +134,7 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
     }
 
     ctx.endTick = etick;
+    ctx.statistics.layoutAll = layoutAll;
 
     if (m_score->cmdState().layoutFlags & LayoutFlag::REBUILD_MIDI_MAPPING) {
         if (m_score->isMaster()) {
@@ -147,6 +177,7 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         ctx.nextMeasure = m;         //_showVBox ? first() : firstMeasure();
         ctx.startTick   = m->tick();
         layoutLinear(layoutAll, options, ctx);
+        m_lastStatistics = ctx.statistics;
         return;
     }
 
@@ -160,6 +191,11 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         }
         ctx.curSystem   = system;
         ctx.systemList  = mu::mid(m_score->_systems, systemIndex);
+        for (const System* s : ctx.systemList) {
+            if (!s->measures().empty()) {
+                ctx.oldSystemEnds.insert(s->measures().back());
+            }
+        }
 
         if (systemIndex == 0) {
             ctx.nextMeasure = options.showVBox ? m_score->first() : m_score->firstMeasure();
@@ -215,6 +251,8 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         m_score->pages().clear();
 
         ctx.nextMeasure = options.showVBox ? m_score->first() : m_score->firstMeasure();
+
+        LayoutMeasure::layoutMeasuresInParallel(options, ctx);
     }
 
     ctx.prevMeasure = 0;
@@ -223,6 +261,13 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
     ctx.curSystem = LayoutSystem::collectSystem(options, ctx, m_score);
 
     doLayout(options, ctx);
+    markPagesChanged(m_score, oldPagesCount);
+
+    m_lastStatistics = ctx.statistics;
+    LOGD("layout range %s - %s: %zu measures (%zu in parallel), %zu systems collected, %zu systems reused, %zu pages",
+         qPrintable(stick.toString()), qPrintable(etick.toString()),
+         m_lastStatistics.layoutedMeasures, m_lastStatistics.parallelMeasures, m_lastStatistics.collectedSystems,
+         m_lastStatistics.reusedSystems, m_lastStatistics.collectedPages);
 }
 
 void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
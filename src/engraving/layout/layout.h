@@ -23,13 +23,13 @@
 #define MU_ENGRAVING_LAYOUT_H
 
 #include "layoutoptions.h"
+#include "layoutcontext.h"
 
 namespace mu::engraving {
 class Score;
 class System;
 class Tremolo;
 
-class LayoutContext;
 class Layout
 {
 public:
@@ -37,6 +37,8 @@ public:
 
     void doLayoutRange(const LayoutOptions& options, const Fraction&, const Fraction&);
 
+    const LayoutStatistics& lastStatistics() const { return m_lastStatistics; }
+
 private:
 
     void layoutLinear(const LayoutOptions& options, LayoutContext& ctx);
@@ -47,6 +49,7 @@ private:
     void doLayout(const LayoutOptions& options, LayoutContext& lc);
 
     Score* m_score = nullptr;
+    LayoutStatistics m_lastStatistics;
 };
 }
 
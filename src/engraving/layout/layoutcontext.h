@@ -33,8 +33,20 @@ class Score;
 class Page;
 class System;
 class Spanner;
+class Measure;
 class MeasureBase;
 
+//! NOTE Counts the work done by the last layout, to see how much of the score an edit has relaid out
+struct LayoutStatistics
+{
+    size_t layoutedMeasures = 0;    // measures and frames that went through getNextMeasure
+    size_t collectedSystems = 0;
+    size_t reusedSystems = 0;       // systems taken over unchanged from the previous layout
+    size_t collectedPages = 0;
+    size_t parallelMeasures = 0;    // measures laid out in advance by the parallel phase
+    bool layoutAll = false;
+};
+
 class LayoutContext
 {
 public:
@@ -53,12 +65,14 @@ public:
     Fraction tick{ 0, 1 };
 
     std::vector<System*> systemList; // reusable systems
+    std::set<const MeasureBase*> oldSystemEnds; // last measures of the systems in systemList before the layout
     std::set<Spanner*> processedSpanners;
+    std::set<const Measure*> preparedMeasures; // already laid out by LayoutMeasure::layoutMeasuresInParallel
+    std::set<const Measure*> stemsAndBeamsMeasures; // stems and beams already done by LayoutMeasure::layoutMeasuresInParallel
 
     System* prevSystem = nullptr; // used during page layout
     System* curSystem = nullptr;
 
-    MeasureBase* systemOldMeasure = nullptr;
     MeasureBase* pageOldMeasure = nullptr;
     bool rangeDone = false;
 
@@ -69,6 +83,8 @@ public:
     Fraction startTick;
     Fraction endTick;
 
+    LayoutStatistics statistics;
+
 private:
     Score* m_score = nullptr;
 };
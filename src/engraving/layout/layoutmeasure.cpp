@@ -21,6 +21,8 @@
  */
 #include "layoutmeasure.h"
 
+#include "concurrency/concurrency.h"
+
 #include "libmscore/factory.h"
 #include "libmscore/score.h"
 #include "libmscore/measure.h"
@@ -33,6 +35,13 @@
 #include "libmscore/lyrics.h"
 #include "libmscore/marker.h"
 #include "libmscore/part.h"
+#include "libmscore/beam.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/tie.h"
+#include "libmscore/tremolo.h"
+#include "libmscore/scorefont.h"
+#include "libmscore/stafftype.h"
 
 #include "layout.h"
 #include "layoutcontext.h"
@@ -44,6 +53,9 @@
 
 using namespace mu::engraving;
 
+//! NOTE For smaller scores starting the threads costs more than it saves
+static constexpr size_t PARALLEL_LAYOUT_MIN_MEASURES = 16;
+
 //---------------------------------------------------------
 //   createMMRest
 //    create a multimeasure rest
@@ -383,6 +395,7 @@ void LayoutMeasure::createMMRest(const LayoutOptions& options, Score* score, Mea
     MeasureBase* nm = options.showVBox ? lastMeasure->next() : lastMeasure->nextMeasure();
     mmrMeasure->setNext(nm);
     mmrMeasure->setPrev(firstMeasure->prev());
+    score->invalidateMeasureIndex();
 }
 
 //---------------------------------------------------------
@@ -590,6 +603,8 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
         return;
     }
 
+    ++ctx.statistics.layoutedMeasures;
+
     int mno = adjustMeasureNo(ctx, ctx.curMeasure);
 
     if (ctx.curMeasure->isMeasure()) {
@@ -652,6 +667,173 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
         return;
     }
 
+    if (!mu::contains(ctx.preparedMeasures, static_cast<const Measure*>(measure))) {
+        if (!mu::contains(ctx.stemsAndBeamsMeasures, static_cast<const Measure*>(measure))) {
+            layoutStemsAndBeams(ctx, measure);
+        }
+        layoutChordsAndSymbols(score, measure);
+        layoutLyrics(score, measure);
+        createShapes(measure);
+    }
+
+    ctx.tick += measure->ticks();
+}
+
+//---------------------------------------------------------
+//   layoutMeasuresInParallel
+//    Lays out all measures of the score in advance, before
+//    the systems are collected. Stems, beams and lyrics
+//    create and delete elements, so they are done serially
+//    in score order; the chords and the segment shapes only
+//    depend on their own measure and are computed on
+//    several threads. Measures sharing beams, tremolos or
+//    ties with their neighbours are left to getNextMeasure(),
+//    which only skips their stems and beams.
+//    The undo commands pushed by the threads are collected
+//    per measure and appended in score order.
+//---------------------------------------------------------
+
+void LayoutMeasure::layoutMeasuresInParallel(const LayoutOptions& options, LayoutContext& ctx)
+{
+    Score* score = ctx.score();
+    size_t threadsCount = MScore::layoutThreads > 0 ? static_cast<size_t>(MScore::layoutThreads) : concurrency::idealThreadCount();
+    if (threadsCount < 2 || options.isLinearMode() || score->styleB(Sid::createMultiMeasureRests)
+        || score->nmeasures() < PARALLEL_LAYOUT_MIN_MEASURES) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    //! NOTE Everything resolved lazily must be resolved before the threads start
+    score->tick2measure(Fraction(0, 1));
+    score->tick2measureMM(Fraction(0, 1));
+    ScoreFont::fallbackFont();
+    ScoreFont::fontProvider();
+    EngravingObject::elementsProvider();
+    EngravingItem::engravingConfiguration();
+    StaffType::engravingConfiguration();
+
+    std::vector<Measure*> measures;
+    MeasureBase* prevMeasure = ctx.prevMeasure;
+    Fraction tick = ctx.tick;
+    for (Measure* measure = score->firstMeasure(); measure; measure = measure->nextMeasure()) {
+        measure->moveTicks(tick - measure->tick());
+        tick += measure->ticks();
+
+        layoutStemsAndBeams(ctx, measure);
+        ctx.stemsAndBeamsMeasures.insert(measure);
+        ctx.prevMeasure = measure;
+
+        if (isLocalMeasure(measure)) {
+            measures.push_back(measure);
+        }
+    }
+    ctx.prevMeasure = prevMeasure;
+
+    std::vector<std::vector<UndoCommand*> > measureCommands(measures.size());
+
+    concurrency::parallelFor(measures.size(), threadsCount, [score, &measures, &measureCommands](size_t i) {
+        UndoStack::setCommandsCollector(&measureCommands[i]);
+        layoutChordsAndSymbols(score, measures[i]);
+        UndoStack::setCommandsCollector(nullptr);
+    }, "layout");
+
+    for (const std::vector<UndoCommand*>& commands : measureCommands) {
+        score->undoStack()->appendCollected(commands);
+    }
+
+    for (Measure* measure : measures) {
+        layoutLyrics(score, measure);
+    }
+
+    concurrency::parallelFor(measures.size(), threadsCount, [&measures](size_t i) {
+        createShapes(measures[i]);
+    }, "layout");
+
+    ctx.preparedMeasures.insert(measures.begin(), measures.end());
+    ctx.statistics.parallelMeasures = measures.size();
+}
+
+//---------------------------------------------------------
+//   isLocalMeasure
+//    whether the layout of the measure doesn't touch other
+//    measures
+//---------------------------------------------------------
+
+bool LayoutMeasure::isLocalMeasure(const Measure* measure)
+{
+    for (const Segment& segment : measure->segments()) {
+        if (!segment.isChordRestType()) {
+            continue;
+        }
+        for (const EngravingItem* e : segment.elist()) {
+            if (!e || !e->isChordRest()) {
+                continue;
+            }
+            const ChordRest* cr = toChordRest(e);
+            if (cr->crossMeasure() == CrossMeasure::FIRST || cr->crossMeasure() == CrossMeasure::SECOND) {
+                return false;
+            }
+            if (cr->isChord() && hasCrossMeasureTies(toChord(cr), measure)) {
+                return false;
+            }
+            const Beam* beam = cr->beam();
+            if (beam && !beam->elements().empty()
+                && (beam->elements().front()->measure() != measure || beam->elements().back()->measure() != measure)) {
+                return false;
+            }
+            if (cr->isChord()) {
+                const Tremolo* tremolo = toChord(cr)->tremolo();
+                if (tremolo && tremolo->twoNotes()
+                    && (!tremolo->chord1() || !tremolo->chord2()
+                        || tremolo->chord1()->measure() != measure || tremolo->chord2()->measure() != measure)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   hasCrossMeasureTies
+//    the chord layout calculates the direction of the ties,
+//    which are shared with the other measure
+//---------------------------------------------------------
+
+bool LayoutMeasure::hasCrossMeasureTies(const Chord* chord, const Measure* measure)
+{
+    for (const Chord* grace : chord->graceNotes()) {
+        if (hasCrossMeasureTies(grace, measure)) {
+            return true;
+        }
+    }
+
+    for (const Note* note : chord->notes()) {
+        const Tie* tieFor = note->tieFor();
+        if (tieFor && (!tieFor->endNote() || tieFor->endNote()->chord()->measure() != measure)) {
+            return true;
+        }
+        const Tie* tieBack = note->tieBack();
+        if (tieBack && (!tieBack->startNote() || tieBack->startNote()->chord()->measure() != measure)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------
+//   layoutStemsAndBeams
+//    calculate accidentals and note lines, create stems and
+//    beams; this creates and removes elements, so it has
+//    to be done measure by measure in score order
+//---------------------------------------------------------
+
+void LayoutMeasure::layoutStemsAndBeams(LayoutContext& ctx, Measure* measure)
+{
+    Score* score = ctx.score();
+
     measure->connectTremolo();
 
     //
@@ -767,20 +949,36 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
         }
     }
 
+    Segment* seg = measure->findSegmentR(SegmentType::StartRepeatBarLine, Fraction(0, 1));
+    if (measure->repeatStart()) {
+        if (!seg) {
+            seg = measure->getSegmentR(SegmentType::StartRepeatBarLine, Fraction(0, 1));
+        }
+        measure->barLinesSetSpan(seg);          // this also creates necessary barlines
+        for (size_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            BarLine* b = toBarLine(seg->element(staffIdx * VOICES));
+            if (b) {
+                b->setBarLineType(BarLineType::START_REPEAT);
+                b->layout();
+            }
+        }
+    } else if (seg) {
+        score->undoRemoveElement(seg);
+    }
+}
+
+//---------------------------------------------------------
+//   layoutChordsAndSymbols
+//    layout of the chords, breaths and symbols, which only
+//    depends on the measure itself
+//---------------------------------------------------------
+
+void LayoutMeasure::layoutChordsAndSymbols(Score* score, Measure* measure)
+{
     for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
         for (Segment& segment : measure->segments()) {
             if (segment.isChordRestType()) {
                 LayoutChords::layoutChords1(score, &segment, staffIdx);
-                for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
-                    ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
-                    if (cr) {
-                        for (Lyrics* l : cr->lyrics()) {
-                            if (l) {
-                                l->layout();
-                            }
-                        }
-                    }
-                }
             }
         }
     }
@@ -800,24 +998,38 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
             }
         }
     }
+}
 
-    Segment* seg = measure->findSegmentR(SegmentType::StartRepeatBarLine, Fraction(0, 1));
-    if (measure->repeatStart()) {
-        if (!seg) {
-            seg = measure->getSegmentR(SegmentType::StartRepeatBarLine, Fraction(0, 1));
-        }
-        measure->barLinesSetSpan(seg);          // this also creates necessary barlines
-        for (size_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
-            BarLine* b = toBarLine(seg->element(staffIdx * VOICES));
-            if (b) {
-                b->setBarLineType(BarLineType::START_REPEAT);
-                b->layout();
+//---------------------------------------------------------
+//   layoutLyrics
+//---------------------------------------------------------
+
+void LayoutMeasure::layoutLyrics(Score* score, Measure* measure)
+{
+    for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+        for (Segment& segment : measure->segments()) {
+            if (segment.isChordRestType()) {
+                for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
+                    ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
+                    if (cr) {
+                        for (Lyrics* l : cr->lyrics()) {
+                            if (l) {
+                                l->layout();
+                            }
+                        }
+                    }
+                }
             }
         }
-    } else if (seg) {
-        score->undoRemoveElement(seg);
     }
+}
 
+//---------------------------------------------------------
+//   createShapes
+//---------------------------------------------------------
+
+void LayoutMeasure::createShapes(Measure* measure)
+{
     for (Segment& s : measure->segments()) {
         if (s.isEndBarLineType()) {
             continue;
@@ -827,8 +1039,6 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
 
     measure->computeTicks(); // Must be called *after* Segment::createShapes() because it relies on the
     // Segment::visible() property, which is determined by Segment::createShapes().
-
-    ctx.tick += measure->ticks();
 }
 
 //---------------------------------------------------------
@@ -26,6 +26,7 @@
 
 namespace mu::engraving {
 class Score;
+class Chord;
 class Measure;
 class MeasureBase;
 
@@ -37,12 +38,20 @@ public:
     LayoutMeasure() = default;
 
     static void getNextMeasure(const LayoutOptions& options, LayoutContext& lc);
+    static void layoutMeasuresInParallel(const LayoutOptions& options, LayoutContext& lc);
 
 private:
 
     static void createMMRest(const LayoutOptions& options, Score* score, Measure* firstMeasure, Measure* lastMeasure, const Fraction& len);
 
     static int adjustMeasureNo(LayoutContext& lc, MeasureBase* m);
+
+    static void layoutStemsAndBeams(LayoutContext& lc, Measure* measure);
+    static void layoutChordsAndSymbols(Score* score, Measure* measure);
+    static void layoutLyrics(Score* score, Measure* measure);
+    static void createShapes(Measure* measure);
+    static bool isLocalMeasure(const Measure* measure);
+    static bool hasCrossMeasureTies(const Chord* chord, const Measure* measure);
 };
 }
 
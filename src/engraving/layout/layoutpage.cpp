@@ -103,6 +103,8 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
 {
     TRACEFUNC;
 
+    ++ctx.statistics.collectedPages;
+
     const qreal slb = ctx.score()->styleMM(Sid::staffLowerBorder);
     bool breakPages = ctx.score()->layoutMode() != LayoutMode::SYSTEM;
     qreal footerExtension = ctx.page->footerExtension();
@@ -196,6 +198,7 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
                 nextSystem = ctx.systemList.empty() ? 0 : mu::takeFirst(ctx.systemList);
                 if (nextSystem) {
                     ctx.score()->systems().push_back(nextSystem);
+                    ++ctx.statistics.reusedSystems;
                 }
             }
         } else {
@@ -307,8 +307,8 @@ System* LayoutSystem::collectSystem(const LayoutOptions& options, LayoutContext&
     if (ctx.endTick < ctx.prevMeasure->tick()) {
         // we've processed the entire range
         // but we need to continue layout until we reach a system whose last measure is the same as previous layout
-        if (ctx.prevMeasure == ctx.systemOldMeasure) {
-            // this system ends in the same place as the previous layout
+        if (takeOverOldSystems(ctx)) {
+            // this system ends in the same place as a system of the previous layout
             // ok to stop
             if (ctx.curMeasure && ctx.curMeasure->isMeasure()) {
                 // we may have previously processed first measure(s) of next system
@@ -487,14 +487,15 @@ System* LayoutSystem::getNextSystem(LayoutContext& ctx)
     Score* score = ctx.score();
     bool isVBox = ctx.curMeasure->isVBox();
     System* system = nullptr;
-    if (ctx.systemList.empty()) {
+    //! NOTE An old system is only recycled if it doesn't start after the current measure,
+    //! otherwise it may still hold measures which are taken over unchanged once the layout converges
+    if (ctx.systemList.empty() || !isRecyclable(ctx.systemList.front(), ctx.curMeasure)) {
         system = Factory::createSystem(score->dummy()->page());
-        ctx.systemOldMeasure = 0;
     } else {
         system = mu::takeFirst(ctx.systemList);
-        ctx.systemOldMeasure = system->measures().empty() ? 0 : system->measures().back();
         system->clear();       // remove measures from system
     }
+    ++ctx.statistics.collectedSystems;
     score->systems().push_back(system);
     if (!isVBox) {
         size_t nstaves = score->Score::nstaves();
@@ -506,6 +507,54 @@ System* LayoutSystem::getNextSystem(LayoutContext& ctx)
     return system;
 }
 
+bool LayoutSystem::isRecyclable(const System* system, const MeasureBase* curMeasure)
+{
+    return system->measures().empty() || system->measures().front()->tick() <= curMeasure->tick();
+}
+
+//---------------------------------------------------------
+//   takeOverOldSystems
+//    Checks whether the layout has converged: the system
+//    just collected ends where a system of the previous
+//    layout ended and the next old system starts with the
+//    current measure. If so, the old systems replaced by
+//    the new ones are deleted and the remaining ones can be
+//    taken over unchanged.
+//---------------------------------------------------------
+
+bool LayoutSystem::takeOverOldSystems(LayoutContext& ctx)
+{
+    if (!mu::contains(ctx.oldSystemEnds, static_cast<const MeasureBase*>(ctx.prevMeasure))) {
+        return false;
+    }
+
+    size_t replacedSystems = 0;
+    for (size_t i = 0; i < ctx.systemList.size(); ++i) {
+        const System* system = ctx.systemList.at(i);
+        if (!system->measures().empty() && system->measures().back() == ctx.prevMeasure) {
+            replacedSystems = i + 1;
+            break;
+        }
+    }
+
+    if (ctx.curMeasure) {
+        if (replacedSystems >= ctx.systemList.size()) {
+            return false;
+        }
+        const System* nextSystem = ctx.systemList.at(replacedSystems);
+        if (nextSystem->measures().empty() || nextSystem->measures().front() != ctx.curMeasure) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < replacedSystems; ++i) {
+        delete ctx.systemList.at(i);
+    }
+    ctx.systemList.erase(ctx.systemList.begin(), ctx.systemList.begin() + replacedSystems);
+
+    return true;
+}
+
 void LayoutSystem::hideEmptyStaves(Score* score, System* system, bool isFirstSystem)
 {
     size_t staves = score->nstaves();
@@ -903,6 +952,10 @@ void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutCont
     Fraction etick = useRange ? lc.endTick : system->measures().back()->endTick();
     auto spanners = score->spannerMap().findOverlapping(stick.ticks(), etick.ticks());
 
+    //! NOTE The spanners are autoplaced one after another, so the order matters:
+    //! it must not depend on the order, in which the spanners were added to the score
+    SpannerMap::sortByPosition(spanners);
+
     // ties
     doLayoutTies(system, sl, stick, etick);
 
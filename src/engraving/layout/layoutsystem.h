@@ -43,6 +43,8 @@ public:
 
 private:
     static System* getNextSystem(LayoutContext& lc);
+    static bool isRecyclable(const System* system, const MeasureBase* curMeasure);
+    static bool takeOverOldSystems(LayoutContext& lc);
     static void hideEmptyStaves(Score* score, System* system, bool isFirstSystem);
     static void processLines(System* system, std::vector<Spanner*> lines, bool align);
     static void layoutTies(Chord* ch, System* system, const Fraction& stick);
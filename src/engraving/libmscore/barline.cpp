@@ -731,7 +731,7 @@ void BarLine::draw(mu::draw::Painter* painter) const
         if (m->isIrregular() && score()->markIrregularMeasures() && !m->isMMRest()) {
             painter->setPen(engravingConfiguration()->formattingMarksColor());
             mu::draw::Font f("Edwin");
-            f.setPointSizeF(12 * spatium() * MScore::pixelRatio / SPATIUM20);
+            f.setPointSizeF(12 * spatium() * RenderContext::current().pixelRatio / SPATIUM20);
             f.setBold(true);
             QString str = m->ticks() > m->timesig() ? "+" : "-";
             RectF r = mu::draw::FontMetrics(f).boundingRect(str);
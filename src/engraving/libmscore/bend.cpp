@@ -274,7 +274,7 @@ void Bend::draw(mu::draw::Painter* painter) const
     painter->setPen(pen);
     painter->setBrush(Brush(curColor()));
 
-    mu::draw::Font f = font(_spatium * MScore::pixelRatio);
+    mu::draw::Font f = font(_spatium * RenderContext::current().pixelRatio);
     painter->setFont(f);
 
     qreal x  = m_noteWidth + _spatium * .2;
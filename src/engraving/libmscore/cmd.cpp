@@ -107,6 +107,7 @@ void CmdState::reset()
 {
     layoutFlags         = LayoutFlag::NO_FLAGS;
     _updateMode         = UpdateMode::DoNothing;
+    _updateAllRequested = false;
     _startTick          = Fraction(-1, 1);
     _endTick            = Fraction(-1, 1);
 
@@ -228,6 +229,9 @@ void CmdState::_setUpdateMode(UpdateMode m)
 
 void CmdState::setUpdateMode(UpdateMode m)
 {
+    if (m == UpdateMode::UpdateAll) {
+        _updateAllRequested = true;
+    }
     if (int(m) > int(_updateMode)) {
         _setUpdateMode(m);
     }
@@ -399,6 +403,10 @@ void Score::update(bool resetCmdState)
         ms->deletePostponed();
         if (cs.layoutRange()) {
             for (Score* s : ms->scoreList()) {
+                //! NOTE Will be laid out completely when it is needed
+                if (s->isLayoutDeferred()) {
+                    continue;
+                }
                 s->doLayoutRange(cs.startTick(), cs.endTick());
             }
             updateAll = true;
@@ -410,6 +418,20 @@ void Score::update(bool resetCmdState)
         CmdState& cs = ms->cmdState();
         if (updateAll || cs.updateAll()) {
             for (Score* s : scoreList()) {
+                //! NOTE The layout gives a new revision to the pages it collects again,
+                //! the other pages need one only if their drawing changed without a relayout
+                RectF refresh;
+                if (s->_updateState.refresh.isValid()) {
+                    qreal d = s->spatium() * .5;
+                    refresh = s->_updateState.refresh.adjusted(-d, -d, 2 * d, 2 * d);
+                }
+                for (Page* page : s->pages()) {
+                    if (cs.updateAllRequested() || (refresh.isValid() && page->canvasBoundingRect().intersects(refresh))) {
+                        page->markContentChanged();
+                    }
+                }
+                s->_updateState.refresh = RectF();
+
                 for (MuseScoreView* v : s->viewer) {
                     v->updateAll();
                 }
@@ -418,6 +440,11 @@ void Score::update(bool resetCmdState)
             // updateRange updates only current score
             qreal d = spatium() * .5;
             _updateState.refresh.adjust(-d, -d, 2 * d, 2 * d);
+            for (Page* page : pages()) {
+                if (page->canvasBoundingRect().intersects(_updateState.refresh)) {
+                    page->markContentChanged();
+                }
+            }
             for (MuseScoreView* v : viewer) {
                 v->dataChanged(_updateState.refresh);
             }
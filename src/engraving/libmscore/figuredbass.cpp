@@ -631,7 +631,7 @@ void FiguredBassItem::draw(mu::draw::Painter* painter) const
 
     // (use the same font selection as used in layout() above)
     qreal m = score()->styleD(Sid::figuredBassFontSize) * spatium() / SPATIUM20;
-    f.setPointSizeF(m * MScore::pixelRatio);
+    f.setPointSizeF(m * RenderContext::current().pixelRatio);
 
     painter->setFont(f);
     painter->setBrush(BrushStyle::NoBrush);
@@ -1602,7 +1602,7 @@ void Harmony::draw(mu::draw::Painter* painter) const
     painter->setPen(color);
     for (const TextSegment* ts : textList) {
         mu::draw::Font f(ts->m_font);
-        f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+        f.setPointSizeF(f.pointSizeF() * RenderContext::current().pixelRatio);
 #ifndef Q_OS_MACOS
         TextBase::drawTextWorkaround(painter, f, ts->pos(), ts->text);
 #else
@@ -166,7 +166,7 @@ void Image::draw(mu::draw::Painter* painter) const
             } else {
                 s = _size * DPMM;
             }
-            if (score() && score()->printing() && !MScore::svgPrinting) {
+            if (score() && score()->printing() && !RenderContext::current().svgPrinting) {
                 // use original image size for printing, but not for svg for reasonable file size.
                 painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
                 painter->drawPixmap(PointF(0, 0), *rasterDoc);
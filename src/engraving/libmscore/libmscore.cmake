@@ -267,6 +267,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/spacer.h
     ${CMAKE_CURRENT_LIST_DIR}/spanner.cpp
     ${CMAKE_CURRENT_LIST_DIR}/spanner.h
+    ${CMAKE_CURRENT_LIST_DIR}/spannerintervaltree.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/spannerintervaltree.h
     ${CMAKE_CURRENT_LIST_DIR}/spannermap.cpp
     ${CMAKE_CURRENT_LIST_DIR}/spannermap.h
     ${CMAKE_CURRENT_LIST_DIR}/splitMeasure.cpp
@@ -256,6 +256,9 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
             for (const Excerpt* excerpt : qAsConst(this->excerpts())) {
                 Score* partScore = excerpt->excerptScore();
                 if (partScore != this) {
+                    //! NOTE Writing relies on the layout (e.g. mmrests), the part may not be laid out yet
+                    partScore->ensureLayout();
+
                     // Write excerpt style
                     {
                         ByteArray excerptStyleData;
@@ -330,6 +333,8 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
 
 bool MasterScore::exportPart(MscWriter& mscWriter, Score* partScore)
 {
+    partScore->ensureLayout();
+
     // Write excerpt style as main
     {
         ByteArray excerptStyleData;
@@ -1003,7 +1003,7 @@ void Measure::add(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = toMeasure(e);
+        setMMRest(toMeasure(e));
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -1122,7 +1122,7 @@ void Measure::remove(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = 0;
+        setMMRest(nullptr);
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -2868,7 +2868,7 @@ bool Measure::setProperty(Pid propertyId, const PropertyValue& value)
         m_timesig = value.value<Fraction>();
         break;
     case Pid::TIMESIG_ACTUAL:
-        _len = value.value<Fraction>();
+        setTicks(value.value<Fraction>());
         break;
     case Pid::MEASURE_NUMBER_MODE:
         setMeasureNumberMode(MeasureNumberMode(value.toInt()));
@@ -2947,6 +2947,16 @@ Measure* Measure::mmRestLast() const
     return score()->lastMeasure();
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    m_mmRest = m;
+    score()->invalidateMeasureIndex();
+}
+
 //---------------------------------------------------------
 //   mmRest1
 //    return the multi measure rest this measure is covered
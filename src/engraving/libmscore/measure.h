@@ -307,7 +307,7 @@ public:
     bool isMMRest() const { return m_mmRestCount > 0; }
     Measure* mmRest() const { return m_mmRest; }
     const Measure* mmRest1() const;
-    void setMMRest(Measure* m) { m_mmRest = m; }
+    void setMMRest(Measure* m);
     int mmRestCount() const { return m_mmRestCount; }            // number of measures m_mmRest spans
     void setMMRestCount(int n) { m_mmRestCount = n; }
     Measure* mmRestFirst() const;
@@ -691,6 +691,24 @@ int MeasureBase::index() const
     return -1;
 }
 
+//---------------------------------------------------------
+//   setTick
+//---------------------------------------------------------
+
+void MeasureBase::setTick(const Fraction& f)
+{
+    if (_tick == f) {
+        return;
+    }
+
+    _tick = f;
+
+    //! NOTE The score searches its measures by tick
+    if (score()) {
+        score()->invalidateMeasureIndex();
+    }
+}
+
 //---------------------------------------------------------
 //   measureIndex
 //    returns index of measure counting only Measures but
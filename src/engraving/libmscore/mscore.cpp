@@ -111,10 +111,12 @@ int MScore::mtcType;
 
 bool MScore::noExcerpts = false;
 bool MScore::noImages = false;
-bool MScore::pdfPrinting = false;
-bool MScore::svgPrinting = false;
+int MScore::layoutThreads = 1;
+int MScore::playbackThreads = 0;
+int MScore::midiRenderThreads = 1;
 
-double MScore::pixelRatio  = 0.8;         // DPI / logicalDPI
+static const RenderContext s_defaultRenderContext;
+static thread_local const RenderContext* s_currentRenderContext = nullptr;
 
 extern void initDrumset();
 
@@ -166,6 +168,26 @@ std::vector<MScoreError> MScore::errorList {
 
 MsError MScore::_error { MsError::MS_NO_ERROR };
 
+//---------------------------------------------------------
+//   RenderContext
+//---------------------------------------------------------
+
+const RenderContext& RenderContext::current()
+{
+    return s_currentRenderContext ? *s_currentRenderContext : s_defaultRenderContext;
+}
+
+RenderContext::Scope::Scope(const RenderContext& context)
+    : m_context(context), m_previous(s_currentRenderContext)
+{
+    s_currentRenderContext = &m_context;
+}
+
+RenderContext::Scope::~Scope()
+{
+    s_currentRenderContext = m_previous;
+}
+
 //---------------------------------------------------------
 //   init
 //---------------------------------------------------------
@@ -242,6 +242,40 @@ struct MScoreError {
     const char* txt;
 };
 
+//---------------------------------------------------------
+//   RenderContext
+//    paint-time state of the elements draw() functions,
+//    every thread has its own current context, so pages
+//    and scores can be painted concurrently
+//---------------------------------------------------------
+
+struct RenderContext {
+    double pixelRatio = 0.8;        // DPI / logicalDPI of the paint device
+    bool printing = false;          // true if we are drawing to a printer or exporting
+    bool pdfPrinting = false;
+    bool svgPrinting = false;
+
+    //! NOTE The context of the calling thread, default one if no scope is active
+    static const RenderContext& current();
+
+    class Scope;
+};
+
+//! NOTE Makes the context current for the calling thread until the scope is left
+class RenderContext::Scope
+{
+public:
+    explicit Scope(const RenderContext& context);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    RenderContext m_context;
+    const RenderContext* m_previous = nullptr;
+};
+
 //---------------------------------------------------------
 //   MScore
 //    MuseScore application object
@@ -303,9 +337,9 @@ public:
     static bool noExcerpts;
     static bool noImages;
 
-    static bool pdfPrinting;
-    static bool svgPrinting;
-    static double pixelRatio;
+    static int layoutThreads; // threads for the parallel phase of a full layout, 0 - as many as cores, 1 (default) - serial
+    static int playbackThreads; // threads for rendering the playback events of the tracks, 0 - as many as cores
+    static int midiRenderThreads; // threads for rendering the MIDI events of the staves, 0 - as many as cores, 1 (default) - serial
 
     static qreal verticalPageGap;
     static qreal horizontalPageGapEven;
@@ -1352,7 +1352,7 @@ void Note::draw(mu::draw::Painter* painter) const
             }
         }
         mu::draw::Font f(tab->fretFont());
-        f.setPointSizeF(f.pointSizeF() * magS() * MScore::pixelRatio);
+        f.setPointSizeF(f.pointSizeF() * magS() * RenderContext::current().pixelRatio);
         painter->setFont(f);
         painter->setPen(c);
         painter->drawText(PointF(bbox().x(), tab->fretFontYOffset()), _fretString);
@@ -22,6 +22,8 @@
 
 #include "page.h"
 
+#include <atomic>
+
 #include <QDateTime>
 
 #include "style/style.h"
@@ -54,6 +56,8 @@ namespace mu::engraving {
 //extern QString revision;
 static QString revision;
 
+static std::atomic<uint64_t> s_pageContentRevision { 0 };
+
 //---------------------------------------------------------
 //   Page
 //---------------------------------------------------------
@@ -62,6 +66,27 @@ Page::Page(RootItem* parent)
     : EngravingItem(ElementType::PAGE, parent, ElementFlag::NOT_SELECTABLE), _no(0)
 {
     bspTreeValid = false;
+    markContentChanged();
+}
+
+//---------------------------------------------------------
+//   invalidateBspTree
+//    the tree is invalidated whenever the content of the page changes
+//---------------------------------------------------------
+
+void Page::invalidateBspTree()
+{
+    bspTreeValid = false;
+    markContentChanged();
+}
+
+//---------------------------------------------------------
+//   markContentChanged
+//---------------------------------------------------------
+
+void Page::markContentChanged()
+{
+    _contentRevision = ++s_pageContentRevision;
 }
 
 //---------------------------------------------------------
@@ -70,18 +95,25 @@ Page::Page(RootItem* parent)
 
 std::vector<EngravingItem*> Page::items(const RectF& rect)
 {
-    if (!bspTreeValid) {
-        doRebuildBspTree();
-    }
+    ensureBspTree();
     return bspTree.items(rect);
 }
 
 std::vector<EngravingItem*> Page::items(const mu::PointF& point)
+{
+    ensureBspTree();
+    return bspTree.items(point);
+}
+
+//---------------------------------------------------------
+//   ensureBspTree
+//---------------------------------------------------------
+
+void Page::ensureBspTree()
 {
     if (!bspTreeValid) {
         doRebuildBspTree();
     }
-    return bspTree.items(point);
 }
 
 //---------------------------------------------------------
@@ -149,20 +181,45 @@ void Page::draw(mu::draw::Painter* painter) const
     }
 }
 
+//---------------------------------------------------------
+//   ~HeaderFooterCache
+//---------------------------------------------------------
+
+Page::HeaderFooterCache::~HeaderFooterCache()
+{
+    for (Text* text : texts) {
+        delete text;
+    }
+}
+
 //---------------------------------------------------------
 //   drawHeaderFooter
+//    the header and footer texts of the score are shared
+//    by all pages, and pages may be drawn concurrently,
+//    so the page draws a text of its own
 //---------------------------------------------------------
 
 void Page::drawHeaderFooter(mu::draw::Painter* p, int area, const QString& ss) const
 {
-    Text* text = layoutHeaderFooter(area, ss);
-    if (!text) {
+    QString s = replaceTextMacros(ss);
+    if (s.isEmpty()) {
         return;
     }
+
+    Text*& text = _headerFooterCache.texts[area];
+    if (!text) {
+        text = createHeaderFooterText(area);
+    }
+
+    if (_headerFooterCache.revisions[area] != _contentRevision || _headerFooterCache.xmlTexts[area] != s) {
+        layoutHeaderFooterText(text, area, s);
+        _headerFooterCache.xmlTexts[area] = s;
+        _headerFooterCache.revisions[area] = _contentRevision;
+    }
+
     p->translate(text->pos());
     text->draw(p);
     p->translate(-text->pos());
-    text->resetExplicitParent();
 }
 
 //---------------------------------------------------------
@@ -180,22 +237,39 @@ Text* Page::layoutHeaderFooter(int area, const QString& ss) const
     if (area < MAX_HEADERS) {
         text = score()->headerText(area);
         if (!text) {
-            text = Factory::createText((Page*)this, TextStyleType::HEADER);
-            text->setFlag(ElementFlag::MOVABLE, false);
-            text->setFlag(ElementFlag::GENERATED, true);       // set to disable editing
-            text->setLayoutToParentWidth(true);
+            text = createHeaderFooterText(area);
             score()->setHeaderText(text, area);
         }
     } else {
         text = score()->footerText(area - MAX_HEADERS);     // because they are 3 4 5
         if (!text) {
-            text = Factory::createText((Page*)this, TextStyleType::FOOTER);
-            text->setFlag(ElementFlag::MOVABLE, false);
-            text->setFlag(ElementFlag::GENERATED, true);       // set to disable editing
-            text->setLayoutToParentWidth(true);
+            text = createHeaderFooterText(area);
             score()->setFooterText(text, area - MAX_HEADERS);
         }
     }
+    layoutHeaderFooterText(text, area, s);
+    return text;
+}
+
+//---------------------------------------------------------
+//   createHeaderFooterText
+//---------------------------------------------------------
+
+Text* Page::createHeaderFooterText(int area) const
+{
+    Text* text = Factory::createText((Page*)this, area < MAX_HEADERS ? TextStyleType::HEADER : TextStyleType::FOOTER);
+    text->setFlag(ElementFlag::MOVABLE, false);
+    text->setFlag(ElementFlag::GENERATED, true);       // set to disable editing
+    text->setLayoutToParentWidth(true);
+    return text;
+}
+
+//---------------------------------------------------------
+//   layoutHeaderFooterText
+//---------------------------------------------------------
+
+void Page::layoutHeaderFooterText(Text* text, int area, const QString& s) const
+{
     text->setParent((Page*)this);
     Align align = { AlignH::LEFT, AlignV::TOP };
     switch (area) {
@@ -215,7 +289,6 @@ Text* Page::layoutHeaderFooter(int area, const QString& ss) const
     text->setAlign(align);
     text->setXmlText(s);
     text->layout();
-    return text;
 }
 
 //---------------------------------------------------------
@@ -23,6 +23,7 @@
 #ifndef __PAGE_H__
 #define __PAGE_H__
 
+#include <array>
 #include <vector>
 
 #include "config.h"
@@ -51,6 +52,21 @@ class Page final : public EngravingItem
 
     BspTree bspTree;
     bool bspTreeValid;
+    uint64_t _contentRevision = 0;
+
+    //! NOTE The texts the page draws its header and footer with,
+    //! laid out again only when the content of the page or the text changes
+    struct HeaderFooterCache {
+        std::array<Text*, MAX_HEADERS + MAX_FOOTERS> texts {};
+        std::array<QString, MAX_HEADERS + MAX_FOOTERS> xmlTexts;
+        std::array<uint64_t, MAX_HEADERS + MAX_FOOTERS> revisions {};
+
+        HeaderFooterCache() = default;
+        HeaderFooterCache(const HeaderFooterCache&) {}
+        HeaderFooterCache& operator=(const HeaderFooterCache&) { return *this; }
+        ~HeaderFooterCache();
+    };
+    mutable HeaderFooterCache _headerFooterCache;
 
     void doRebuildBspTree();
 
@@ -60,6 +76,8 @@ class Page final : public EngravingItem
     QString replaceTextMacros(const QString&) const;
     void drawHeaderFooter(mu::draw::Painter*, int area, const QString&) const;
     Text* layoutHeaderFooter(int area, const QString& ss) const;
+    Text* createHeaderFooterText(int area) const;
+    void layoutHeaderFooterText(Text* text, int area, const QString& s) const;
 
 public:
 
@@ -92,7 +110,15 @@ public:
 
     std::vector<EngravingItem*> items(const mu::RectF& r);
     std::vector<EngravingItem*> items(const mu::PointF& p);
-    void invalidateBspTree() { bspTreeValid = false; }
+    void invalidateBspTree();
+
+    //! NOTE items() rebuilds the tree lazily, call this before querying the page from several threads
+    void ensureBspTree();
+
+    //! NOTE The revision changes whenever the content of the page may have changed,
+    //! it is unique across all pages, so it can be used as a key for caches of the page drawing
+    uint64_t contentRevision() const { return _contentRevision; }
+    void markContentChanged();
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     mu::RectF tbbox();                             // tight bounding box, excluding white space
@@ -30,6 +30,8 @@
 #include <set>
 #include <cmath>
 
+#include "concurrency/concurrency.h"
+
 #include "style/style.h"
 #include "compat/midi/event.h"
 #include "types/constants.h"
@@ -2442,6 +2444,36 @@ void MidiRenderer::renderMetronome(EventMap* events, Measure const* m, const Fra
     }
 }
 
+//---------------------------------------------------------
+//   removeDuplicateControllerEvents
+//---------------------------------------------------------
+
+static void removeDuplicateControllerEvents(EventMap* events)
+{
+    // NOTE:JT this is a temporary fix for duplicate events until polyphonic aftertouch support
+    // can be implemented. This removes duplicate SND events.
+    int lastChannel = -1;
+    int lastController = -1;
+    int lastValue = -1;
+    for (auto i = events->begin(); i != events->end();) {
+        if (i->second.type() == ME_CONTROLLER) {
+            auto& event = i->second;
+            if (event.channel() == lastChannel
+                && event.controller() == lastController
+                && event.value() == lastValue) {
+                i = events->erase(i);
+            } else {
+                lastChannel = event.channel();
+                lastController = event.controller();
+                lastValue = event.value();
+                i++;
+            }
+        } else {
+            i++;
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   renderMidi
 //    export score to event list
@@ -2467,19 +2499,89 @@ void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, con
 void MidiRenderer::renderScore(EventMap* events, const Context& ctx)
 {
     updateState();
+
+    size_t threads = MScore::midiRenderThreads > 0 ? static_cast<size_t>(MScore::midiRenderThreads) : concurrency::idealThreadCount();
+    if (threads > 1 && score->nstaves() > 1) {
+        renderScoreParallel(events, ctx, threads);
+        return;
+    }
+
     for (const Chunk& chunk : chunks) {
-        renderChunk(chunk, events, ctx);
+        renderChunkEvents(chunk, events, ctx);
     }
+
+    //! NOTE Done once for the whole map, the same way as in renderScoreParallel
+    events->fixupMIDI();
+    removeDuplicateControllerEvents(events);
 }
 
-void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Context& ctx)
+//---------------------------------------------------------
+//   MidiRenderer::renderScoreParallel
+///   Renders the staves on several threads, each staff
+///   into its own event maps, and merges them in the
+///   order in which renderChunk inserts the events.
+//---------------------------------------------------------
+
+void MidiRenderer::renderScoreParallel(EventMap* events, const Context& ctx, size_t threads)
 {
-    // TODO: avoid doing it multiple times for the same measures
-    score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
+    TRACEFUNC;
+
+    //! NOTE Everything that changes the score is done before the staves are rendered
+    for (const Chunk& chunk : chunks) {
+        score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
+    }
 
     score->updateChannel();
     score->updateVelo();
 
+    const std::vector<Staff*>& staves = score->staves();
+    for (Staff* st : staves) {
+        st->velocities().cleanup();
+        st->velocityMultiplications().cleanup();
+    }
+
+    const StaffContext defaultCtx = staffContext(ctx);
+
+    //! NOTE A staff is rendered on one thread from the first chunk to the last one,
+    //! because the same measures are rendered in several chunks when the repeats are expanded
+    //! and the realized harmonies are computed on the first access
+    std::vector<std::vector<EventMap> > staffEvents(staves.size(), std::vector<EventMap>(chunks.size()));
+
+    concurrency::parallelFor(staves.size(), threads, [&](size_t staffIdx) {
+        StaffContext sctx = defaultCtx;
+        sctx.staff = staves[staffIdx];
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            renderStaffChunk(chunks[i], &staffEvents[staffIdx][i], sctx);
+        }
+    }, "midi");
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        for (std::vector<EventMap>& chunkEvents : staffEvents) {
+            events->merge(chunkEvents[i]);
+        }
+
+        // create sustain pedal events
+        renderSpanners(chunks[i], events);
+
+        if (ctx.metronome) {
+            renderMetronome(chunks[i], events);
+        }
+    }
+
+    //! NOTE This is done once for the whole map, not after every chunk: the events of a chunk
+    //! don't start before the chunk, so the events of the earlier chunks are processed the same way
+    events->fixupMIDI();
+    removeDuplicateControllerEvents(events);
+}
+
+//---------------------------------------------------------
+//   MidiRenderer::staffContext
+///   The staff context with the dynamics settings
+///   of the score, without a staff
+//---------------------------------------------------------
+
+MidiRenderer::StaffContext MidiRenderer::staffContext(const Context& ctx) const
+{
     SynthesizerState s = score->synthesizerState();
     int method = s.method();
     int cc = s.ccToUse();
@@ -2514,16 +2616,42 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
         break;
     }
 
+    StaffContext sctx;
+    sctx.method = renderMethod;
+    sctx.cc = cc;
+    sctx.renderHarmony = ctx.renderHarmony;
+    return sctx;
+}
+
+void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Context& ctx)
+{
+    renderChunkEvents(chunk, events, ctx);
+
+    events->fixupMIDI();
+    removeDuplicateControllerEvents(events);
+}
+
+//---------------------------------------------------------
+//   MidiRenderer::renderChunkEvents
+///   Renders the events of a chunk, without fixing up
+///   the events of the whole map
+//---------------------------------------------------------
+
+void MidiRenderer::renderChunkEvents(const Chunk& chunk, EventMap* events, const Context& ctx)
+{
+    // TODO: avoid doing it multiple times for the same measures
+    score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
+
+    score->updateChannel();
+    score->updateVelo();
+
+    StaffContext sctx = staffContext(ctx);
+
     // create note & other events
     for (Staff* st : score->staves()) {
-        StaffContext sctx;
         sctx.staff = st;
-        sctx.method = renderMethod;
-        sctx.cc = cc;
-        sctx.renderHarmony = ctx.renderHarmony;
         renderStaffChunk(chunk, events, sctx);
     }
-    events->fixupMIDI();
 
     // create sustain pedal events
     renderSpanners(chunk, events);
@@ -2531,29 +2659,6 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
     if (ctx.metronome) {
         renderMetronome(chunk, events);
     }
-
-    // NOTE:JT this is a temporary fix for duplicate events until polyphonic aftertouch support
-    // can be implemented. This removes duplicate SND events.
-    int lastChannel = -1;
-    int lastController = -1;
-    int lastValue = -1;
-    for (auto i = events->begin(); i != events->end();) {
-        if (i->second.type() == ME_CONTROLLER) {
-            auto& event = i->second;
-            if (event.channel() == lastChannel
-                && event.controller() == lastController
-                && event.value() == lastValue) {
-                i = events->erase(i);
-            } else {
-                lastChannel = event.channel();
-                lastController = event.controller();
-                lastValue = event.value();
-                i++;
-            }
-        } else {
-            i++;
-        }
-    }
 }
 
 //---------------------------------------------------------
@@ -143,6 +143,11 @@ public:
     static const int ARTICULATION_CONV_FACTOR { 100000 };
 
     std::vector<Chunk> chunksFromRange(const int fromTick, const int toTick);
+
+private:
+    StaffContext staffContext(const Context& ctx) const;
+    void renderChunkEvents(const Chunk&, EventMap* events, const Context& ctx);
+    void renderScoreParallel(EventMap* events, const Context& ctx, size_t threads);
 };
 
 class Spanner;
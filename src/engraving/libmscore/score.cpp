@@ -132,6 +132,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    ++_generation;
     ++_size;
     if (_last) {
         _last->setNext(e);
@@ -152,6 +153,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    ++_generation;
     ++_size;
     if (_first) {
         _first->setPrev(e);
@@ -183,6 +185,7 @@ void MeasureBaseList::add(MeasureBase* e)
         return;
     }
     ++_size;
+    ++_generation;
     e->setPrev(el->prev());
     el->prev()->setNext(e);
     el->setPrev(e);
@@ -195,6 +198,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    ++_generation;
     --_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -214,6 +218,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    ++_generation;
     ++_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++_size;
@@ -239,6 +244,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    ++_generation;
     --_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --_size;
@@ -263,6 +269,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    ++_generation;
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -821,7 +828,12 @@ void Score::setShowInvisible(bool v)
 
 void Score::setShowUnprintable(bool v)
 {
+    if (_showUnprintable == v) {
+        return;
+    }
+
     _showUnprintable = v;
+    markPagesContentChanged();
 }
 
 //---------------------------------------------------------
@@ -830,7 +842,12 @@ void Score::setShowUnprintable(bool v)
 
 void Score::setShowFrames(bool v)
 {
+    if (_showFrames == v) {
+        return;
+    }
+
     _showFrames = v;
+    markPagesContentChanged();
 }
 
 //---------------------------------------------------------
@@ -839,7 +856,12 @@ void Score::setShowFrames(bool v)
 
 void Score::setShowPageborders(bool v)
 {
+    if (_showPageborders == v) {
+        return;
+    }
+
     _showPageborders = v;
+    markPagesContentChanged();
 }
 
 //---------------------------------------------------------
@@ -848,7 +870,12 @@ void Score::setShowPageborders(bool v)
 
 void Score::setMarkIrregularMeasures(bool v)
 {
+    if (_markIrregularMeasures == v) {
+        return;
+    }
+
     _markIrregularMeasures = v;
+    markPagesContentChanged();
 }
 
 //---------------------------------------------------------
@@ -5259,6 +5286,19 @@ void Score::rebuildBspTree()
     }
 }
 
+//---------------------------------------------------------
+//   markPagesContentChanged
+//    the pages are drawn differently, but the layout
+//    is the same
+//---------------------------------------------------------
+
+void Score::markPagesContentChanged()
+{
+    for (Page* page : pages()) {
+        page->markContentChanged();
+    }
+}
+
 //---------------------------------------------------------
 //   scanElements
 //    scan all elements
@@ -5398,10 +5438,33 @@ void Score::doLayout()
     doLayoutRange(Fraction(0, 1), Fraction(-1, 1));
 }
 
+//---------------------------------------------------------
+//   ensureLayout
+//    lay out the score if its layout was deferred
+//---------------------------------------------------------
+
+void Score::ensureLayout()
+{
+    if (!_layoutDeferred) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    doLayout();
+}
+
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
     TRACEFUNC;
 
+    //! NOTE The score has never been laid out, so a range is not enough
+    if (_layoutDeferred) {
+        _layoutDeferred = false;
+        doLayoutRange(Fraction(0, 1), Fraction(-1, 1));
+        return;
+    }
+
     _scoreFont = ScoreFont::fontByName(style().value(Sid::MusicalSymbolFont).toString());
     _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
@@ -5417,13 +5480,42 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 }
 
-void Score::createPaddingTable()
+//---------------------------------------------------------
+//   PaddingTable
+//---------------------------------------------------------
+
+void PaddingTable::fill(double value)
+{
+    for (Row& row : m_rows) {
+        row.fill(value);
+    }
+}
+
+void PaddingTable::setRow(ElementType type, double value)
+{
+    m_rows[size_t(type)].fill(value);
+}
+
+void PaddingTable::setColumn(ElementType type, double value)
+{
+    for (Row& row : m_rows) {
+        row[type] = value;
+    }
+}
+
+void PaddingTable::updateMaxValue()
 {
-    for (int i=0; i < int(ElementType::MAXTYPE); ++i) {
-        for (int j=0; j < int(ElementType::MAXTYPE); ++j) {
-            _paddingTable[ElementType(i)][ElementType(j)] = _minimumPaddingUnit;
+    m_maxValue = -std::numeric_limits<double>::max();
+    for (const Row& row : m_rows) {
+        for (double value : row) {
+            m_maxValue = std::max(m_maxValue, value);
         }
     }
+}
+
+void Score::createPaddingTable()
+{
+    _paddingTable.fill(_minimumPaddingUnit);
 
     const double ledgerPad = 0.25 * spatium();
     const double ledgerLength = styleMM(Sid::ledgerLineLength);
@@ -5538,11 +5630,9 @@ void Score::createPaddingTable()
     _paddingTable[ElementType::TIMESIG][ElementType::TIMESIG] = 1.0 * spatium();
 
     // Obtain the Stem -> * and * -> Stem values from the note equivalents
-    for (auto& elem : _paddingTable[ElementType::STEM]) {
-        elem.second = _paddingTable[ElementType::NOTE][elem.first];
-    }
-    for (auto& elem: _paddingTable) {
-        elem.second[ElementType::STEM] = _paddingTable[elem.first][ElementType::NOTE];
+    _paddingTable[ElementType::STEM] = _paddingTable[ElementType::NOTE];
+    for (int i = 0; i < int(ElementType::MAXTYPE); ++i) {
+        _paddingTable[ElementType(i)][ElementType::STEM] = _paddingTable[ElementType(i)][ElementType::NOTE];
     }
     _paddingTable[ElementType::STEM][ElementType::NOTE] = styleMM(Sid::minNoteDistance);
     _paddingTable[ElementType::STEM][ElementType::STEM] = 0.85 * spatium();
@@ -5551,23 +5641,17 @@ void Score::createPaddingTable()
     _paddingTable[ElementType::LEDGER_LINE][ElementType::STEM] = 0.35 * spatium();
 
     // Ambitus
-    for (auto& elem : _paddingTable[ElementType::AMBITUS]) {
-        elem.second = styleMM(Sid::ambitusMargin);
-    }
-    for (auto& elem: _paddingTable) {
-        elem.second[ElementType::AMBITUS] = styleMM(Sid::ambitusMargin);
-    }
+    _paddingTable.setRow(ElementType::AMBITUS, styleMM(Sid::ambitusMargin));
+    _paddingTable.setColumn(ElementType::AMBITUS, styleMM(Sid::ambitusMargin));
 
     // Breath
-    for (auto& elem : _paddingTable[ElementType::BREATH]) {
-        elem.second = 1.0 * spatium();
-    }
-    for (auto& elem: _paddingTable) {
-        elem.second[ElementType::BREATH] = 1.0 * spatium();
-    }
+    _paddingTable.setRow(ElementType::BREATH, 1.0 * spatium());
+    _paddingTable.setColumn(ElementType::BREATH, 1.0 * spatium());
 
     // Temporary hack, because some padding is already constructed inside the lyrics themselves.
     _paddingTable[ElementType::BAR_LINE][ElementType::LYRICS] = 0.0 * spatium();
+
+    _paddingTable.updateMaxValue();
 }
 
 //--------------------------------------------------------
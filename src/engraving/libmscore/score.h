@@ -28,6 +28,9 @@
  Definition of Score class.
 */
 
+#include <array>
+#include <memory>
+#include <mutex>
 #include <set>
 
 #include <QQueue>
@@ -169,6 +172,7 @@ class MeasureBaseList
     int _size;
     MeasureBase* _first = nullptr;
     MeasureBase* _last = nullptr;
+    size_t _generation = 0;     // incremented on every change of the list
 
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
@@ -177,7 +181,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return _first; }
     MeasureBase* last()  const { return _last; }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; ++_generation; }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -185,6 +189,7 @@ public:
     void change(MeasureBase* o, MeasureBase* n);
     int size() const { return _size; }
     bool empty() const { return _size == 0; }
+    size_t generation() const { return _generation; }
     void fixupSystems();
 };
 
@@ -276,6 +281,7 @@ class CmdState
     bool _oneMeasureBase = true;
 
     bool _locked = false;
+    bool _updateAllRequested = false;     // UpdateAll was requested, even if a layout is done anyway
 
     void setMeasureBase(const MeasureBase* mb);
 
@@ -292,6 +298,7 @@ public:
     bool layoutRange() const { return _updateMode == UpdateMode::Layout; }
     bool updateAll() const { return int(_updateMode) >= int(UpdateMode::UpdateAll); }
     bool updateRange() const { return _updateMode == UpdateMode::Update; }
+    bool updateAllRequested() const { return _updateAllRequested; }
     void setTick(const Fraction& t);
     void setStaff(staff_idx_t staff);
     void setElement(const EngravingItem* e);
@@ -368,7 +375,44 @@ public:
 //
 //    a Score has always an associated MasterScore
 //---------------------------------------------------------------------------------------
-typedef std::map<ElementType, std::map<ElementType, double> > PaddingTable;
+
+//---------------------------------------------------------
+//   PaddingTable
+//    minimum horizontal distances between items of two
+//    element types, kept in a flat table so that lookups
+//    during horizontal spacing are plain array accesses
+//---------------------------------------------------------
+
+class PaddingTable
+{
+public:
+    static constexpr size_t TYPES = size_t(ElementType::MAXTYPE);
+
+    class Row : public std::array<double, TYPES>
+    {
+    public:
+        double& operator[](ElementType type) { return std::array<double, TYPES>::operator[](size_t(type)); }
+        double operator[](ElementType type) const { return std::array<double, TYPES>::operator[](size_t(type)); }
+        double at(ElementType type) const { return std::array<double, TYPES>::operator[](size_t(type)); }
+    };
+
+    Row& operator[](ElementType type) { return m_rows[size_t(type)]; }
+    const Row& operator[](ElementType type) const { return m_rows[size_t(type)]; }
+    const Row& at(ElementType type) const { return m_rows[size_t(type)]; }
+
+    void fill(double value);
+    void setRow(ElementType type, double value);
+    void setColumn(ElementType type, double value);
+
+    //! NOTE Upper bound of all the values, valid after updateMaxValue()
+    double maxValue() const { return m_maxValue; }
+    void updateMaxValue();
+
+private:
+    std::array<Row, TYPES> m_rows;
+    double m_maxValue = 0.0;
+};
+
 class Score : public EngravingObject
 {
     INJECT(engraving, mu::draw::IImageProvider, imageProvider)
@@ -419,6 +463,24 @@ private:
     UpdateState _updateState;
 
     MeasureBaseList _measures;            // here are the notes
+
+    //! NOTE Measures in score order for the binary search in tick2measure*.
+    //! Only the order is cached, the ticks are read from the measures,
+    //! so the index is rebuilt only after the measure list, the mmrests or a measure tick change.
+    //! tick2measure* may be called from several threads (parallel layout and midi rendering),
+    //! so the index is rebuilt under the mutex and never changed once built:
+    //! a reader keeps its snapshot even if another thread replaces the index
+    struct MeasureIndex {
+        std::vector<Measure*> measures;
+        size_t listGeneration = 0;
+        bool createMMRests = false;
+        bool ticksAscending = true;     // otherwise the binary search can't be used
+    };
+    using MeasureIndexPtr = std::shared_ptr<const MeasureIndex>;
+
+    mutable MeasureIndexPtr m_measureIndex;
+    mutable MeasureIndexPtr m_measureMMIndex;
+    mutable std::mutex m_measureIndexMutex;
     std::vector<Part*> _parts;
     std::vector<Staff*> _staves;
     std::vector<Staff*> systemObjectStaves;
@@ -442,7 +504,6 @@ private:
     bool _showPageborders       { false };
     bool _markIrregularMeasures { true };
     bool _showInstrumentNames   { true };
-    bool _printing              { false };        ///< True if we are drawing to a printer
     bool _savedCapture          { false };        ///< True if we saved an image capture
 
     ScoreOrder _scoreOrder;                     ///< used for score ordering
@@ -451,6 +512,7 @@ private:
     int _mscVersion { MSCVERSION };     ///< version of current loading *.msc file
 
     bool _isOpen { true };
+    bool _layoutDeferred { false };
 
     std::map<QString, QString> _metaTags;
 
@@ -519,6 +581,11 @@ private:
     void assignIdIfNeed(Staff& staff) const;
     void assignIdIfNeed(Part& part) const;
 
+    MeasureIndexPtr measureIndex() const;
+    MeasureIndexPtr measureMMIndex() const;
+    static std::shared_ptr<MeasureIndex> buildMeasureIndex(Measure* first, bool mmRests);
+    static Measure* findMeasure(const MeasureIndex& index, const Fraction& tick);
+
     PaddingTable _paddingTable;
     double _minimumPaddingUnit = 0.1 * spatium(); // Maybe style setting in future
 
@@ -570,6 +637,7 @@ public:
     mu::async::Channel<EngravingItem*> elementDestroyed();
 
     void rebuildBspTree();
+    void markPagesContentChanged();
     bool noStaves() const { return _staves.empty(); }
     void insertPart(Part*, staff_idx_t);
     void appendPart(Part*);
@@ -856,6 +924,7 @@ public:
     Segment* tick2segmentMM(const Fraction& tick, bool first, SegmentType st) const;
     Segment* tick2segmentMM(const Fraction& tick) const;
     Segment* tick2segmentMM(const Fraction& tick, bool first) const;
+    void invalidateMeasureIndex();
     Segment* tick2leftSegment(const Fraction& tick, bool useMMrest = false) const;
     Segment* tick2rightSegment(const Fraction& tick, bool useMMrest = false) const;
     Segment* tick2leftSegmentMM(const Fraction& tick) { return tick2leftSegment(tick, /* useMMRest */ true); }
@@ -875,8 +944,7 @@ public:
     ScoreContentState state() const;
     bool savedCapture() const { return _savedCapture; }
     void setSavedCapture(bool v) { _savedCapture = v; }
-    bool printing() const { return _printing; }
-    void setPrinting(bool val) { _printing = val; }
+    bool printing() const { return RenderContext::current().printing; }     ///< True if we are drawing to a printer
     virtual bool playlistDirty() const;
     virtual void setPlaylistDirty();
 
@@ -1065,6 +1133,13 @@ public:
     void doLayout();
     void doLayoutRange(const Fraction& st, const Fraction& et);
 
+    //! NOTE A score with deferred layout (e.g. a part that is not open) has no pages and is skipped by update(),
+    //! it is laid out completely when ensureLayout() is called by whoever needs its pages first:
+    //! the painting and the elements of its notation (view, image export), the exporters and saving
+    bool isLayoutDeferred() const { return _layoutDeferred; }
+    void deferLayout() { _layoutDeferred = true; }
+    void ensureLayout();
+
     SynthesizerState& synthesizerState() { return _synthesizerState; }
     void setSynthesizerState(const SynthesizerState& s);
 
@@ -1112,6 +1187,7 @@ public:
     const LayoutOptions& layoutOptions() const { return m_layoutOptions; }
     void setLayoutMode(LayoutMode lm) { m_layoutOptions.mode = lm; }
     void setShowVBox(bool v) { m_layoutOptions.showVBox = v; }
+    const LayoutStatistics& layoutStatistics() const { return m_layout.lastStatistics(); }
 
     // temporary methods
     bool isLayoutMode(LayoutMode lm) const { return m_layoutOptions.isMode(lm); }
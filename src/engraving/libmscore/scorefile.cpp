@@ -293,8 +293,9 @@ std::shared_ptr<mu::draw::Pixmap> Score::createThumbnail()
 
     auto pixmap = imageProvider()->createPixmap(w, h, dpm, mu::draw::Color::white);
 
-    double pr = MScore::pixelRatio;
-    MScore::pixelRatio = 1.0;
+    RenderContext renderContext = RenderContext::current();
+    renderContext.pixelRatio = 1.0;
+    RenderContext::Scope renderScope(renderContext);
 
     auto painterProvider = imageProvider()->painterForImage(pixmap);
     mu::draw::Painter p(painterProvider, "thumbnail");
@@ -304,8 +305,6 @@ std::shared_ptr<mu::draw::Pixmap> Score::createThumbnail()
     print(&p, 0);
     p.endDraw();
 
-    MScore::pixelRatio = pr;
-
     if (layoutMode() != mode) {
         setLayoutMode(mode);
         doLayout();
@@ -413,8 +412,11 @@ bool Score::writeScore(io::IODevice* f, bool msczFormat, bool onlySelection, com
 
 void Score::print(mu::draw::Painter* painter, int pageNo)
 {
-    _printing  = true;
-    MScore::pdfPrinting = true;
+    RenderContext renderContext = RenderContext::current();
+    renderContext.printing = true;
+    renderContext.pdfPrinting = true;
+    RenderContext::Scope renderScope(renderContext);
+
     Page* page = pages().at(pageNo);
     RectF fr  = page->abbox();
 
@@ -429,8 +431,6 @@ void Score::print(mu::draw::Painter* painter, int pageNo)
         e->draw(painter);
         painter->restore();
     }
-    MScore::pdfPrinting = false;
-    _printing = false;
 }
 
 //---------------------------------------------------------
@@ -511,6 +511,7 @@ void Score::writeSegments(XmlWriter& xml, track_idx_t strack, track_idx_t etrack
 
     std::list<Spanner*> spanners;
     auto sl = spannerMap().findOverlapping(sseg->tick().ticks(), endTick.ticks());
+    SpannerMap::sortByPosition(sl);
     for (auto i : sl) {
         Spanner* s = i.value;
         if (s->generated() || !xml.context()->canWrite(s)) {
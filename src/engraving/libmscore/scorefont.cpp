@@ -21,10 +21,17 @@
  */
 #include "scorefont.h"
 
+#include <cstring>
+#include <mutex>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QSaveFile>
 
 #include "io/file.h"
 #include "draw/painter.h"
@@ -51,6 +58,51 @@ std::vector<ScoreFont> ScoreFont::s_scoreFonts {
 };
 
 std::array<uint, size_t(SymId::lastSym) + 1> ScoreFont::s_symIdCodes { { 0 } };
+static std::once_flag s_symIdCodesInit;
+
+//! NOTE The metrics of a font are cached in a binary file: the header, the codes of all symbols
+//! (from the glyph names), then the symbols, the anchors and the engraving defaults of the font
+static const char CACHE_MAGIC[4] = { 'M', 'S', 'F', 'C' };
+static constexpr uint32_t CACHE_BYTE_ORDER = 0x01020304;
+static constexpr uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t byteOrder = 0;
+    uint32_t version = 0;
+    uint32_t symIdCount = 0;
+    uint64_t key = 0;
+    uint32_t symCount = 0;
+    uint32_t anchorCount = 0;
+    uint32_t defaultCount = 0;
+    uint32_t reserved = 0;
+    double textEnclosureThickness = 0.0;
+};
+
+struct CacheSym {
+    uint32_t id = 0;
+    uint32_t code = 0;
+    double x = 0.0;
+    double y = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+    double advance = 0.0;
+};
+
+struct CacheAnchor {
+    uint32_t symId = 0;
+    uint32_t anchorId = 0;
+    double x = 0.0;
+    double y = 0.0;
+};
+
+struct CacheDefault {
+    int32_t sid = 0;
+    uint32_t reserved = 0;
+    double value = 0.0;
+};
+
+static_assert(sizeof(uint) == sizeof(uint32_t), "the codes of the symbols are cached as uint32_t");
 
 // =============================================
 // ScoreFont
@@ -110,24 +162,6 @@ double ScoreFont::textEnclosureThickness()
 
 void ScoreFont::initScoreFonts()
 {
-    QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
-    IF_ASSERT_FAILED(!glyphNamesJson.empty()) {
-        LOGE() << "Could not read glyph names JSON";
-        return;
-    }
-
-    for (size_t i = 0; i < s_symIdCodes.size(); ++i) {
-        QString name(SymNames::nameForSymId(static_cast<SymId>(i)).toQLatin1String());
-
-        bool ok;
-        uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
-        if (ok) {
-            s_symIdCodes[i] = code;
-        } else if (MScore::debugMode) {
-            LOGD() << "could not read codepoint for glyph " << name;
-        }
-    }
-
     fontProvider()->insertSubstitution("Leland Text",    "Bravura Text");
     fontProvider()->insertSubstitution("Bravura Text",   "Leland Text");
     fontProvider()->insertSubstitution("MScore Text",    "Leland Text");
@@ -139,6 +173,31 @@ void ScoreFont::initScoreFonts()
     fallbackFont(); // load fallback font
 }
 
+//! NOTE The codes are read from the cache of the first loaded font, if it is valid,
+//! so the glyph names are only parsed if the metrics of a font have to be computed
+void ScoreFont::initSymIdCodes()
+{
+    std::call_once(s_symIdCodesInit, []() {
+        QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
+        IF_ASSERT_FAILED(!glyphNamesJson.empty()) {
+            LOGE() << "Could not read glyph names JSON";
+            return;
+        }
+
+        for (size_t i = 0; i < s_symIdCodes.size(); ++i) {
+            QString name(SymNames::nameForSymId(static_cast<SymId>(i)).toQLatin1String());
+
+            bool ok;
+            uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
+            if (ok) {
+                s_symIdCodes[i] = code;
+            } else if (MScore::debugMode) {
+                LOGD() << "could not read codepoint for glyph " << name;
+            }
+        }
+    });
+}
+
 QJsonObject ScoreFont::initGlyphNamesJson()
 {
     File file(":fonts/smufl/glyphnames.json");
@@ -193,9 +252,7 @@ ScoreFont* ScoreFont::fontByName(const QString& name)
         return font;
     }
 
-    if (!font->m_loaded) {
-        font->load();
-    }
+    font->ensureLoaded();
 
     return font;
 }
@@ -204,9 +261,7 @@ ScoreFont* ScoreFont::fallbackFont()
 {
     ScoreFont* font = &s_scoreFonts[FALLBACK_FONT_INDEX];
 
-    if (!font->m_loaded) {
-        font->load();
-    }
+    font->ensureLoaded();
 
     return font;
 }
@@ -220,6 +275,20 @@ const char* ScoreFont::fallbackTextFont()
 // Load
 // =============================================
 
+void ScoreFont::ensureLoaded()
+{
+    if (m_loaded) {
+        return;
+    }
+
+    //! NOTE Fonts are loaded on first use, which may happen on several layout threads at once
+    static std::mutex loadMutex;
+    std::lock_guard<std::mutex> lock(loadMutex);
+    if (!m_loaded) {
+        load();
+    }
+}
+
 void ScoreFont::load()
 {
     QString facePath = m_fontPath + m_filename;
@@ -234,6 +303,30 @@ void ScoreFont::load()
     m_font.setNoFontMerging(true);
     m_font.setHinting(mu::draw::Font::Hinting::PreferVerticalHinting);
 
+    //! NOTE The metrics are computed from the font and the metadata only once,
+    //! the next runs read them from the cache, as long as the font files are the same
+    QString cachePath = cacheFilePath();
+    uint64_t key = cachePath.isEmpty() ? 0 : cacheKey();
+    if (!cachePath.isEmpty() && readCache(cachePath, key)) {
+        m_loaded = true;
+        return;
+    }
+
+    if (!loadMetrics()) {
+        return;
+    }
+
+    if (!cachePath.isEmpty()) {
+        writeCache(cachePath, key);
+    }
+
+    m_loaded = true;
+}
+
+bool ScoreFont::loadMetrics()
+{
+    initSymIdCodes();
+
     for (size_t id = 0; id < s_symIdCodes.size(); ++id) {
         uint code = s_symIdCodes[id];
         if (code == 0) {
@@ -246,7 +339,7 @@ void ScoreFont::load()
     File metadataFile(m_fontPath + "metadata.json");
     if (!metadataFile.open(IODevice::ReadOnly)) {
         LOGE() << "Failed to open glyph metadata file: " << metadataFile.filePath();
-        return;
+        return false;
     }
 
     QJsonParseError error;
@@ -254,7 +347,7 @@ void ScoreFont::load()
     if (error.error != QJsonParseError::NoError) {
         LOGE() << "Json parse error in " << metadataFile.filePath()
                << ", offset " << error.offset << ": " << error.errorString();
-        return;
+        return false;
     }
 
     loadGlyphsWithAnchors(metadataJson.value("glyphsWithAnchors").toObject());
@@ -262,7 +355,7 @@ void ScoreFont::load()
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
     loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
-    m_loaded = true;
+    return true;
 }
 
 void ScoreFont::loadGlyphsWithAnchors(const QJsonObject& glyphsWithAnchors)
@@ -580,6 +673,213 @@ void ScoreFont::computeMetrics(ScoreFont::Sym& sym, uint code)
     sym.advance = fontProvider()->symAdvance(m_font, code, DPI_F);
 }
 
+// =============================================
+// Metrics cache
+// =============================================
+
+QString ScoreFont::cacheFilePath() const
+{
+    if (!engravingConfiguration()) {
+        return QString();
+    }
+
+    QString dir = engravingConfiguration()->scoreFontsCachePath();
+    if (dir.isEmpty()) {
+        return QString();
+    }
+
+    return dir + "/" + m_name + ".metrics";
+}
+
+static uint64_t hashData(const ByteArray& data, uint64_t hash)
+{
+    //! NOTE FNV-1a over 64 bit words, it is only used to notice that the files have changed
+    static constexpr uint64_t PRIME = 0x100000001b3;
+
+    const uint8_t* bytes = data.constData();
+    size_t size = data.size();
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * PRIME;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * PRIME;
+    }
+
+    return (hash ^ size) * PRIME;
+}
+
+uint64_t ScoreFont::cacheKey() const
+{
+    uint64_t key = 0xcbf29ce484222325;
+
+    for (const QString& path : { m_fontPath + m_filename, m_fontPath + "metadata.json", QString(":fonts/smufl/glyphnames.json") }) {
+        File file(path);
+        if (!file.open(IODevice::ReadOnly)) {
+            return 0;
+        }
+        key = hashData(file.readAll(), key);
+    }
+
+    const double dpi = DPI_F;
+    ByteArray params;
+    params.push_back(reinterpret_cast<const uint8_t*>(&dpi), sizeof(dpi));
+    params.push_back(reinterpret_cast<const uint8_t*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+
+    return hashData(params, key);
+}
+
+bool ScoreFont::readCache(const QString& path, uint64_t key)
+{
+    TRACEFUNC;
+
+    QFile file(path);
+    if (key == 0 || !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(file.size());
+    const uchar* data = file.map(0, file.size());
+    if (!data || size < sizeof(CacheHeader)) {
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+        || header.byteOrder != CACHE_BYTE_ORDER
+        || header.version != CACHE_VERSION
+        || header.key != key
+        || header.symIdCount != s_symIdCodes.size()) {
+        LOGI() << "the metrics cache of " << m_name << " is out of date, it will be rebuilt";
+        return false;
+    }
+
+    const size_t expectedSize = sizeof(CacheHeader)
+                                + header.symIdCount * sizeof(uint32_t)
+                                + header.symCount * sizeof(CacheSym)
+                                + header.anchorCount * sizeof(CacheAnchor)
+                                + header.defaultCount * sizeof(CacheDefault);
+    if (size != expectedSize) {
+        LOGW() << "the metrics cache of " << m_name << " is corrupted: " << path;
+        return false;
+    }
+
+    const uchar* codes = data + sizeof(CacheHeader);
+    const uchar* syms = codes + header.symIdCount * sizeof(uint32_t);
+    const uchar* anchors = syms + header.symCount * sizeof(CacheSym);
+    const uchar* defaults = anchors + header.anchorCount * sizeof(CacheAnchor);
+
+    for (uint32_t i = 0; i < header.symCount; ++i) {
+        CacheSym s;
+        std::memcpy(&s, syms + i * sizeof(CacheSym), sizeof(s));
+        if (s.id >= m_symbols.size()) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.anchorCount; ++i) {
+        CacheAnchor a;
+        std::memcpy(&a, anchors + i * sizeof(CacheAnchor), sizeof(a));
+        if (a.symId >= m_symbols.size() || a.anchorId > static_cast<uint32_t>(SmuflAnchorId::opticalCenter)) {
+            return false;
+        }
+    }
+
+    std::call_once(s_symIdCodesInit, [codes]() {
+        std::memcpy(s_symIdCodes.data(), codes, s_symIdCodes.size() * sizeof(uint32_t));
+    });
+
+    for (uint32_t i = 0; i < header.symCount; ++i) {
+        CacheSym s;
+        std::memcpy(&s, syms + i * sizeof(CacheSym), sizeof(s));
+        Sym& sym = m_symbols[s.id];
+        sym.code = s.code;
+        sym.bbox = RectF(s.x, s.y, s.width, s.height);
+        sym.advance = s.advance;
+    }
+
+    for (uint32_t i = 0; i < header.anchorCount; ++i) {
+        CacheAnchor a;
+        std::memcpy(&a, anchors + i * sizeof(CacheAnchor), sizeof(a));
+        m_symbols[a.symId].smuflAnchors[static_cast<SmuflAnchorId>(a.anchorId)] = PointF(a.x, a.y);
+    }
+
+    loadComposedGlyphs();
+
+    for (uint32_t i = 0; i < header.defaultCount; ++i) {
+        CacheDefault d;
+        std::memcpy(&d, defaults + i * sizeof(CacheDefault), sizeof(d));
+        m_engravingDefaults.push_back({ static_cast<Sid>(d.sid), d.value });
+    }
+    m_engravingDefaults.push_back({ Sid::MusicalTextFont, QString("%1 Text").arg(m_family) });
+    m_textEnclosureThickness = header.textEnclosureThickness;
+
+    return true;
+}
+
+void ScoreFont::writeCache(const QString& path, uint64_t key) const
+{
+    TRACEFUNC;
+
+    if (key == 0) {
+        return;
+    }
+
+    std::vector<CacheSym> syms;
+    std::vector<CacheAnchor> anchors;
+    for (size_t id = 0; id < m_symbols.size(); ++id) {
+        const Sym& sym = m_symbols[id];
+        //! NOTE The composed symbols have no code, they are composed again on reading
+        if (sym.code != 0) {
+            syms.push_back({ static_cast<uint32_t>(id), sym.code, sym.bbox.x(), sym.bbox.y(), sym.bbox.width(), sym.bbox.height(),
+                             sym.advance });
+        }
+        for (const auto& anchor : sym.smuflAnchors) {
+            anchors.push_back({ static_cast<uint32_t>(id), static_cast<uint32_t>(anchor.first), anchor.second.x(), anchor.second.y() });
+        }
+    }
+
+    std::vector<CacheDefault> defaults;
+    for (const auto& d : m_engravingDefaults) {
+        if (d.first != Sid::MusicalTextFont) {
+            defaults.push_back({ static_cast<int32_t>(d.first), 0, d.second.toDouble() });
+        }
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.byteOrder = CACHE_BYTE_ORDER;
+    header.version = CACHE_VERSION;
+    header.symIdCount = static_cast<uint32_t>(s_symIdCodes.size());
+    header.key = key;
+    header.symCount = static_cast<uint32_t>(syms.size());
+    header.anchorCount = static_cast<uint32_t>(anchors.size());
+    header.defaultCount = static_cast<uint32_t>(defaults.size());
+    header.textEnclosureThickness = m_textEnclosureThickness;
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    //! NOTE The file is replaced at once, so the other running instances never read a half written cache
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGW() << "failed to write the metrics cache of " << m_name << ": " << path;
+        return;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(s_symIdCodes.data()), s_symIdCodes.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(syms.data()), syms.size() * sizeof(CacheSym));
+    file.write(reinterpret_cast<const char*>(anchors.data()), anchors.size() * sizeof(CacheAnchor));
+    file.write(reinterpret_cast<const char*>(defaults.data()), defaults.size() * sizeof(CacheDefault));
+
+    if (!file.commit()) {
+        LOGW() << "failed to write the metrics cache of " << m_name << ": " << path;
+    }
+}
+
 // =============================================
 // Symbol properties
 // =============================================
@@ -602,6 +902,7 @@ uint ScoreFont::symCode(SymId id) const
     }
 
     // fallback: search in the common SMuFL table
+    initSymIdCodes();
     return s_symIdCodes.at(static_cast<size_t>(id));
 }
 
@@ -726,11 +1027,13 @@ void ScoreFont::draw(SymId id, Painter* painter, const SizeF& mag, const PointF&
         return;
     }
 
+    //! NOTE The font is shared by all threads drawing with it, so the size is set on a copy
+    mu::draw::Font font = m_font;
+    font.setPointSizeF(20.0 * RenderContext::current().pixelRatio);
+
     painter->save();
-    qreal size = 20.0 * MScore::pixelRatio;
-    m_font.setPointSizeF(size);
     painter->scale(mag.width(), mag.height());
-    painter->setFont(m_font);
+    painter->setFont(font);
     painter->drawSymbol(PointF(pos.x() / mag.width(), pos.y() / mag.height()), symCode(id));
     painter->restore();
 }
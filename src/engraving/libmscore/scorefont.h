@@ -22,12 +22,16 @@
 #ifndef MS_SCOREFONT_H
 #define MS_SCOREFONT_H
 
+#include <atomic>
+#include <cstdint>
+
 #include "style/style.h"
 
 #include "infrastructure/draw/geometry.h"
 
 #include "modularity/ioc.h"
 #include "infrastructure/draw/ifontprovider.h"
+#include "iengravingconfiguration.h"
 
 namespace mu::draw {
 class Painter;
@@ -37,6 +41,7 @@ namespace mu::engraving {
 class ScoreFont
 {
     INJECT_STATIC(score, mu::draw::IFontProvider, fontProvider)
+    INJECT_STATIC(score, IEngravingConfiguration, engravingConfiguration)
 
 public:
     ScoreFont(const char* name, const char* family, const char* path, const char* filename);
@@ -55,6 +60,8 @@ public:
     static ScoreFont* fallbackFont();
     static const char* fallbackTextFont();
 
+    void ensureLoaded();
+
     uint symCode(SymId id) const;
     SymId fromCode(uint code) const;
     QString toString(SymId id) const;
@@ -101,20 +108,27 @@ private:
     };
 
     static QJsonObject initGlyphNamesJson();
+    static void initSymIdCodes();
 
     void load();
+    bool loadMetrics();
     void loadGlyphsWithAnchors(const QJsonObject& glyphsWithAnchors);
     void loadComposedGlyphs();
     void loadStylisticAlternates(const QJsonObject& glyphsWithAlternatesObject);
     void loadEngravingDefaults(const QJsonObject& engravingDefaultsObject);
     void computeMetrics(Sym& sym, uint code);
 
+    QString cacheFilePath() const;
+    uint64_t cacheKey() const;
+    bool readCache(const QString& path, uint64_t key);
+    void writeCache(const QString& path, uint64_t key) const;
+
     Sym& sym(SymId id);
     const Sym& sym(SymId id) const;
 
-    bool m_loaded = false;
+    std::atomic<bool> m_loaded { false };
     std::vector<Sym> m_symbols;
-    mutable mu::draw::Font m_font;
+    mu::draw::Font m_font;
 
     QString m_name;
     QString m_family;
@@ -21,6 +21,9 @@
  */
 
 #include "shape.h"
+
+#include <algorithm>
+
 #include "segment.h"
 #include "chord.h"
 #include "score.h"
@@ -34,6 +37,9 @@ using namespace mu;
 using namespace mu::draw;
 
 namespace mu::engraving {
+//! NOTE Below this number of element pairs sorting costs more than it saves
+static constexpr size_t SWEEP_MIN_PAIRS = 64;
+
 //---------------------------------------------------------
 //   addHorizontalSpacing
 //    This methods creates "walls". They are represented by
@@ -92,6 +98,118 @@ Shape Shape::translated(const PointF& pt) const
     return s;
 }
 
+//-------------------------------------------------------------------
+//   addHorizontalDistance
+//    r2 is located right of r1.
+//    Raises dist to the distance needed between r1 and r2.
+//    The kerning type is only computed when it can change dist.
+//-------------------------------------------------------------------
+
+static void addHorizontalDistance(const ShapeElement& r1, const ShapeElement& r2, double verticalClearance, qreal& dist)
+{
+    const EngravingItem* item1 = r1.toItem;
+    const EngravingItem* item2 = r2.toItem;
+    bool collision = mu::engraving::intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom(), verticalClearance)
+                     || (r1.width() == 0 || r2.width() == 0) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
+                     || (!item1 && item2 && item2->isLyrics()); // Temporary hack: avoids collision with melisma line
+
+    if (!item1 || !item2) { // non-kerning, without padding
+        double padding = 0;
+        dist = qMax(dist, r1.right() - r2.left() + padding);
+        return;
+    }
+
+    double padding = item1->computePadding(item2);
+    qreal distance = r1.right() - r2.left() + padding;
+    qreal originDistance = r1.left() - r2.left();
+
+    bool kerningDecidesDistance = !collision && distance > dist;
+    if (collision) {
+        dist = qMax(dist, distance);
+    }
+    if (!kerningDecidesDistance && originDistance <= dist) {
+        return;
+    }
+
+    KerningType kerningType = item1->computeKerningType(item2);
+    if (kerningDecidesDistance && kerningType == KerningType::NON_KERNING) {
+        dist = qMax(dist, distance);
+    }
+    if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
+        dist = qMax(dist, originDistance);
+    }
+}
+
+//-------------------------------------------------------------------
+//   paddingUpperBound
+//    No pair of items of the two shapes can get a larger padding.
+//    Must stay in sync with EngravingItem::computePadding() and
+//    its overrides.
+//-------------------------------------------------------------------
+
+static double paddingUpperBound(const Shape& s1, const Shape& s2, const Score* score)
+{
+    qreal maxMag = 0.0;
+    for (const Shape* s : { &s1, &s2 }) {
+        for (const ShapeElement& e : *s) {
+            if (e.toItem) {
+                maxMag = std::max(maxMag, e.toItem->mag());
+            }
+        }
+    }
+
+    double padding = std::max(score->paddingTable().maxValue(), static_cast<double>(score->styleMM(Sid::minNoteDistance)));
+    padding *= maxMag;
+    padding = std::max(padding, static_cast<double>(score->styleMM(Sid::graceToGraceNoteDist)));
+    padding = std::max(padding, static_cast<double>(score->styleMM(Sid::graceToMainNoteDist)));
+    return std::max(padding, 0.0);
+}
+
+//-------------------------------------------------------------------
+//   addOverlappingDistances
+//    Sweeps over the elements of both shapes sorted by their top
+//    and adds the distances of all vertically overlapping pairs.
+//-------------------------------------------------------------------
+
+static void addOverlappingDistances(const Shape& s1, const Shape& s2, double verticalClearance, qreal& dist)
+{
+    struct Interval {
+        qreal top = 0.0;
+        qreal bottom = 0.0;
+        const ShapeElement* element = nullptr;
+        bool isLeftShape = false;
+    };
+
+    std::vector<Interval> intervals;
+    intervals.reserve(s1.size() + s2.size());
+    for (const ShapeElement& e : s1) {
+        intervals.push_back({ e.top(), e.bottom() + verticalClearance, &e, true });
+    }
+    for (const ShapeElement& e : s2) {
+        intervals.push_back({ e.top(), e.bottom() + verticalClearance, &e, false });
+    }
+    std::sort(intervals.begin(), intervals.end(), [](const Interval& i1, const Interval& i2) {
+        return i1.top < i2.top;
+    });
+
+    std::vector<const Interval*> active[2];
+    for (const Interval& interval : intervals) {
+        std::vector<const Interval*>& others = active[interval.isLeftShape ? 1 : 0];
+        others.erase(std::remove_if(others.begin(), others.end(), [&interval](const Interval* other) {
+            return other->bottom <= interval.top;
+        }), others.end());
+
+        for (const Interval* other : others) {
+            if (interval.isLeftShape) {
+                addHorizontalDistance(*interval.element, *other->element, verticalClearance, dist);
+            } else {
+                addHorizontalDistance(*other->element, *interval.element, verticalClearance, dist);
+            }
+        }
+        active[interval.isLeftShape ? 0 : 1].push_back(&interval);
+    }
+}
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
@@ -103,33 +221,44 @@ qreal Shape::minHorizontalDistance(const Shape& a, Score* score) const
 {
     qreal dist = -1000000.0;        // min real
     double verticalClearance = 0.2 * score->spatium();
-    for (const ShapeElement& r2 : a) {
-        const EngravingItem* item2 = r2.toItem;
-        qreal by1 = r2.top();
-        qreal by2 = r2.bottom();
-        for (const ShapeElement& r1 : *this) {
-            const EngravingItem* item1 = r1.toItem;
-            qreal ay1 = r1.top();
-            qreal ay2 = r1.bottom();
-            bool intersection = mu::engraving::intersects(ay1, ay2, by1, by2, verticalClearance);
-            double padding = 0;
-            KerningType kerningType = KerningType::NON_KERNING;
-            if (item1 && item2) {
-                padding = item1->computePadding(item2);
-                kerningType = item1->computeKerningType(item2);
-            }
-            if (intersection
-                || (r1.width() == 0 || r2.width() == 0) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
-                || (!item1 && item2 && item2->isLyrics()) // Temporary hack: avoids collision with melisma line
-                || kerningType == KerningType::NON_KERNING) {
-                dist = qMax(dist, r1.right() - r2.left() + padding);
+
+    if (size() * a.size() < SWEEP_MIN_PAIRS) {
+        for (const ShapeElement& r2 : a) {
+            for (const ShapeElement& r1 : *this) {
+                addHorizontalDistance(r1, r2, verticalClearance, dist);
             }
-            if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
-                qreal origin = r1.left();
-                dist = qMax(dist, origin - r2.left());
+        }
+        return dist;
+    }
+
+    // Vertically overlapping pairs usually decide the distance,
+    // so take them first to have a good lower bound early
+    addOverlappingDistances(*this, a, verticalClearance, dist);
+
+    // Any other pair can only raise the distance by its horizontal extent plus the padding.
+    // With the elements of a sorted by their left edge, stop as soon as that can't exceed dist.
+    std::vector<const ShapeElement*> elements;
+    elements.reserve(a.size());
+    for (const ShapeElement& r2 : a) {
+        elements.push_back(&r2);
+    }
+    std::sort(elements.begin(), elements.end(), [](const ShapeElement* r1, const ShapeElement* r2) {
+        return r1->left() < r2->left();
+    });
+
+    const double maxPadding = paddingUpperBound(*this, a, score);
+    for (const ShapeElement& r1 : *this) {
+        qreal r1Left = r1.left();
+        qreal r1Right = r1.right();
+        for (const ShapeElement* r2 : elements) {
+            qreal r2Left = r2->left();
+            if (r1Right - r2Left + maxPadding <= dist && r1Left - r2Left <= dist) {
+                break;
             }
+            addHorizontalDistance(r1, *r2, verticalClearance, dist);
         }
     }
+
     return dist;
 }
 
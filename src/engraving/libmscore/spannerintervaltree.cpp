@@ -0,0 +1,361 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "spannerintervaltree.h"
+
+#include <algorithm>
+
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   ~SpannerIntervalTree
+//---------------------------------------------------------
+
+SpannerIntervalTree::~SpannerIntervalTree()
+{
+    destroy(m_root);
+}
+
+//---------------------------------------------------------
+//   build
+//    the intervals are given in the order of insertion
+//---------------------------------------------------------
+
+void SpannerIntervalTree::build(const std::vector<Interval>& intervals)
+{
+    clear();
+
+    std::vector<Node*> nodes;
+    nodes.reserve(intervals.size());
+
+    for (const Interval& interval : intervals) {
+        Node* node = new Node(interval, m_nextOrder++);
+        nodes.push_back(node);
+        m_nodes.emplace(interval.value, node);
+    }
+
+    std::stable_sort(nodes.begin(), nodes.end(), [](const Node* n1, const Node* n2) {
+        return n1->interval.start < n2->interval.start;
+    });
+
+    m_root = buildBalanced(nodes, 0, nodes.size());
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void SpannerIntervalTree::insert(const Interval& interval)
+{
+    Node* node = new Node(interval, m_nextOrder++);
+    m_nodes.emplace(interval.value, node);
+    m_root = insert(m_root, node);
+}
+
+//---------------------------------------------------------
+//   remove
+//    removes one interval of the value
+//---------------------------------------------------------
+
+bool SpannerIntervalTree::remove(const Spanner* value)
+{
+    auto it = m_nodes.find(value);
+    if (it == m_nodes.end()) {
+        return false;
+    }
+
+    Node* node = it->second;
+    m_nodes.erase(it);
+
+    m_root = remove(m_root, node->key());
+    delete node;
+
+    return true;
+}
+
+//---------------------------------------------------------
+//   update
+//    moves the intervals of the value, keeping their order of insertion
+//---------------------------------------------------------
+
+bool SpannerIntervalTree::update(const Spanner* value, int start, int stop)
+{
+    auto range = m_nodes.equal_range(value);
+    if (range.first == range.second) {
+        return false;
+    }
+
+    for (auto it = range.first; it != range.second; ++it) {
+        Node* node = it->second;
+
+        m_root = remove(m_root, node->key());
+
+        node->interval.start = start;
+        node->interval.stop = stop;
+        node->maxStop = stop;
+        node->height = 1;
+        node->left = nullptr;
+        node->right = nullptr;
+
+        m_root = insert(m_root, node);
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerIntervalTree::clear()
+{
+    destroy(m_root);
+    m_root = nullptr;
+    m_nodes.clear();
+    m_nextOrder = 0;
+}
+
+bool SpannerIntervalTree::contains(const Spanner* value) const
+{
+    return m_nodes.find(value) != m_nodes.end();
+}
+
+size_t SpannerIntervalTree::size() const
+{
+    return m_nodes.size();
+}
+
+//---------------------------------------------------------
+//   findOverlapping
+//    intervals with start <= stop and stop >= start, ordered by start
+//---------------------------------------------------------
+
+void SpannerIntervalTree::findOverlapping(int start, int stop, std::vector<Interval>& result) const
+{
+    findOverlapping(m_root, start, stop, result);
+}
+
+void SpannerIntervalTree::findOverlapping(const Node* node, int start, int stop, std::vector<Interval>& result)
+{
+    if (!node || node->maxStop < start) {
+        return;
+    }
+
+    findOverlapping(node->left, start, stop, result);
+
+    if (node->interval.start > stop) {
+        return;
+    }
+
+    if (node->interval.stop >= start) {
+        result.push_back(node->interval);
+    }
+
+    findOverlapping(node->right, start, stop, result);
+}
+
+//---------------------------------------------------------
+//   findContained
+//    intervals with start >= start and stop <= stop, ordered by start
+//---------------------------------------------------------
+
+void SpannerIntervalTree::findContained(int start, int stop, std::vector<Interval>& result) const
+{
+    findContained(m_root, start, stop, result);
+}
+
+void SpannerIntervalTree::findContained(const Node* node, int start, int stop, std::vector<Interval>& result)
+{
+    if (!node) {
+        return;
+    }
+
+    if (node->interval.start >= start) {
+        findContained(node->left, start, stop, result);
+    }
+
+    if (node->interval.start > stop) {
+        return;
+    }
+
+    if (node->interval.start >= start && node->interval.stop <= stop) {
+        result.push_back(node->interval);
+    }
+
+    findContained(node->right, start, stop, result);
+}
+
+//---------------------------------------------------------
+//   AVL
+//---------------------------------------------------------
+
+int SpannerIntervalTree::height(const Node* node)
+{
+    return node ? node->height : 0;
+}
+
+void SpannerIntervalTree::updateNode(Node* node)
+{
+    node->height = 1 + std::max(height(node->left), height(node->right));
+    node->maxStop = node->interval.stop;
+
+    if (node->left) {
+        node->maxStop = std::max(node->maxStop, node->left->maxStop);
+    }
+
+    if (node->right) {
+        node->maxStop = std::max(node->maxStop, node->right->maxStop);
+    }
+}
+
+SpannerIntervalTree::Node* SpannerIntervalTree::rotateLeft(Node* node)
+{
+    Node* right = node->right;
+    node->right = right->left;
+    right->left = node;
+
+    updateNode(node);
+    updateNode(right);
+
+    return right;
+}
+
+SpannerIntervalTree::Node* SpannerIntervalTree::rotateRight(Node* node)
+{
+    Node* left = node->left;
+    node->left = left->right;
+    left->right = node;
+
+    updateNode(node);
+    updateNode(left);
+
+    return left;
+}
+
+SpannerIntervalTree::Node* SpannerIntervalTree::balance(Node* node)
+{
+    updateNode(node);
+
+    int diff = height(node->left) - height(node->right);
+
+    if (diff > 1) {
+        if (height(node->left->left) < height(node->left->right)) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+
+    if (diff < -1) {
+        if (height(node->right->right) < height(node->right->left)) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+
+    return node;
+}
+
+SpannerIntervalTree::Node* SpannerIntervalTree::insert(Node* root, Node* node)
+{
+    if (!root) {
+        return node;
+    }
+
+    if (node->key() < root->key()) {
+        root->left = insert(root->left, node);
+    } else {
+        root->right = insert(root->right, node);
+    }
+
+    return balance(root);
+}
+
+SpannerIntervalTree::Node* SpannerIntervalTree::takeMin(Node* root, Node*& min)
+{
+    if (!root->left) {
+        min = root;
+        return root->right;
+    }
+
+    root->left = takeMin(root->left, min);
+
+    return balance(root);
+}
+
+SpannerIntervalTree::Node* SpannerIntervalTree::remove(Node* root, const Key& key)
+{
+    if (!root) {
+        return nullptr;
+    }
+
+    if (key < root->key()) {
+        root->left = remove(root->left, key);
+        return balance(root);
+    }
+
+    if (root->key() < key) {
+        root->right = remove(root->right, key);
+        return balance(root);
+    }
+
+    //! NOTE The node itself isn't deleted here, it is owned by the caller
+    if (!root->right) {
+        return root->left;
+    }
+
+    Node* min = nullptr;
+    Node* right = takeMin(root->right, min);
+
+    min->left = root->left;
+    min->right = right;
+
+    return balance(min);
+}
+
+SpannerIntervalTree::Node* SpannerIntervalTree::buildBalanced(const std::vector<Node*>& nodes, size_t from, size_t to)
+{
+    if (from >= to) {
+        return nullptr;
+    }
+
+    size_t middle = from + (to - from) / 2;
+
+    Node* node = nodes[middle];
+    node->left = buildBalanced(nodes, from, middle);
+    node->right = buildBalanced(nodes, middle + 1, to);
+
+    updateNode(node);
+
+    return node;
+}
+
+void SpannerIntervalTree::destroy(Node* node)
+{
+    if (!node) {
+        return;
+    }
+
+    destroy(node->left);
+    destroy(node->right);
+
+    delete node;
+}
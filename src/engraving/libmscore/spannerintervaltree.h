@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_SPANNERINTERVALTREE_H
+#define MU_ENGRAVING_SPANNERINTERVALTREE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "thirdparty/intervaltree/IntervalTree.h"
+
+namespace mu::engraving {
+class Spanner;
+
+//---------------------------------------------------------
+//   SpannerIntervalTree
+//    balanced (AVL) tree of the spanner intervals, ordered by start and then
+//    by the order of insertion; every node keeps the max stop of its subtree,
+//    so insert, remove and update are O(log n) and a query is O(log n + k).
+//    The queries don't modify anything and can be run concurrently
+//---------------------------------------------------------
+
+class SpannerIntervalTree
+{
+public:
+    using Interval = interval_tree::Interval<Spanner*>;
+
+    SpannerIntervalTree() = default;
+    SpannerIntervalTree(const SpannerIntervalTree&) = delete;
+    SpannerIntervalTree& operator=(const SpannerIntervalTree&) = delete;
+    ~SpannerIntervalTree();
+
+    void build(const std::vector<Interval>& intervals);
+    void insert(const Interval& interval);
+    bool remove(const Spanner* value);
+    bool update(const Spanner* value, int start, int stop);
+    void clear();
+
+    bool contains(const Spanner* value) const;
+    size_t size() const;
+
+    void findOverlapping(int start, int stop, std::vector<Interval>& result) const;
+    void findContained(int start, int stop, std::vector<Interval>& result) const;
+
+private:
+    struct Key {
+        int start = 0;
+        uint64_t order = 0;
+
+        bool operator<(const Key& other) const
+        {
+            return start < other.start || (start == other.start && order < other.order);
+        }
+    };
+
+    struct Node {
+        Interval interval;
+        uint64_t order = 0;
+        int maxStop = 0;
+        int height = 1;
+        Node* left = nullptr;
+        Node* right = nullptr;
+
+        Node(const Interval& i, uint64_t o)
+            : interval(i), order(o), maxStop(i.stop) {}
+
+        Key key() const { return { interval.start, order }; }
+    };
+
+    static int height(const Node* node);
+    static void updateNode(Node* node);
+    static Node* rotateLeft(Node* node);
+    static Node* rotateRight(Node* node);
+    static Node* balance(Node* node);
+    static Node* insert(Node* root, Node* node);
+    static Node* takeMin(Node* root, Node*& min);
+    static Node* remove(Node* root, const Key& key);
+    static Node* buildBalanced(const std::vector<Node*>& nodes, size_t from, size_t to);
+    static void destroy(Node* node);
+
+    static void findOverlapping(const Node* node, int start, int stop, std::vector<Interval>& result);
+    static void findContained(const Node* node, int start, int stop, std::vector<Interval>& result);
+
+    Node* m_root = nullptr;
+    uint64_t m_nextOrder = 0;
+    std::unordered_multimap<const Spanner*, Node*> m_nodes;
+};
+} // namespace mu::engraving
+
+#endif // MU_ENGRAVING_SPANNERINTERVALTREE_H
@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "spannermap.h"
 #include "spanner.h"
 
@@ -44,12 +46,39 @@ SpannerMap::SpannerMap()
 //---------------------------------------------------------
 
 void SpannerMap::update() const
+{
+    std::lock_guard<std::mutex> lock(treeMutex);
+    rebuildTree();
+}
+
+//---------------------------------------------------------
+//   ensureTree
+//---------------------------------------------------------
+
+void SpannerMap::ensureTree() const
+{
+    if (!dirty) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(treeMutex);
+    if (dirty) {
+        rebuildTree();
+    }
+}
+
+//---------------------------------------------------------
+//   rebuildTree
+//---------------------------------------------------------
+
+void SpannerMap::rebuildTree() const
 {
     std::vector<interval_tree::Interval<Spanner*> > intervals;
+    intervals.reserve(size());
     for (auto i : *this) {
         intervals.push_back(interval_tree::Interval<Spanner*>(i.second->tick().ticks(), i.second->tick2().ticks(), i.second));
     }
-    tree = interval_tree::IntervalTree<Spanner*>(intervals);
+    tree.build(intervals);
     dirty = false;
 }
 
@@ -57,12 +86,11 @@ void SpannerMap::update() const
 //   findContained
 //---------------------------------------------------------
 
-const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findContained(int start, int stop)
+std::vector<interval_tree::Interval<Spanner*> > SpannerMap::findContained(int start, int stop) const
 {
-    if (dirty) {
-        update();
-    }
-    results.clear();
+    ensureTree();
+
+    std::vector<interval_tree::Interval<Spanner*> > results;
     tree.findContained(start, stop, results);
     return results;
 }
@@ -71,12 +99,11 @@ const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findContained
 //   findOverlapping
 //---------------------------------------------------------
 
-const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findOverlapping(int start, int stop)
+std::vector<interval_tree::Interval<Spanner*> > SpannerMap::findOverlapping(int start, int stop) const
 {
-    if (dirty) {
-        update();
-    }
-    results.clear();
+    ensureTree();
+
+    std::vector<interval_tree::Interval<Spanner*> > results;
     tree.findOverlapping(start, stop, results);
     return results;
 }
@@ -88,7 +115,9 @@ const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findOverlappi
 void SpannerMap::addSpanner(Spanner* s)
 {
     insert(std::pair<int, Spanner*>(s->tick().ticks(), s));
-    dirty = true;
+    if (!dirty) {
+        tree.insert(interval_tree::Interval<Spanner*>(s->tick().ticks(), s->tick2().ticks(), s));
+    }
 }
 
 //---------------------------------------------------------
@@ -100,7 +129,9 @@ bool SpannerMap::removeSpanner(Spanner* s)
     for (auto i = begin(); i != end(); ++i) {
         if (i->second == s) {
             erase(i);
-            dirty = true;
+            if (!dirty) {
+                tree.remove(s);
+            }
             return true;
         }
     }
@@ -108,6 +139,53 @@ bool SpannerMap::removeSpanner(Spanner* s)
     return false;
 }
 
+//---------------------------------------------------------
+//   updateSpanner
+//    moves the interval of the spanner in the tree,
+//    does nothing if the spanner isn't in the map
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(const Spanner* s)
+{
+    if (!dirty) {
+        tree.update(s, s->tick().ticks(), s->tick2().ticks());
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+{
+    std::multimap<int, Spanner*>::clear();
+    tree.clear();
+    dirty = false;
+}
+
+//---------------------------------------------------------
+//   sortByPosition
+//---------------------------------------------------------
+
+void SpannerMap::sortByPosition(std::vector<interval_tree::Interval<Spanner*> >& spanners)
+{
+    std::stable_sort(spanners.begin(), spanners.end(), [](const interval_tree::Interval<Spanner*>& i1,
+                                                          const interval_tree::Interval<Spanner*>& i2) {
+        const Spanner* s1 = i1.value;
+        const Spanner* s2 = i2.value;
+        if (s1->tick() != s2->tick()) {
+            return s1->tick() < s2->tick();
+        }
+        if (s1->track() != s2->track()) {
+            return s1->track() < s2->track();
+        }
+        if (s1->tick2() != s2->tick2()) {
+            return s1->tick2() < s2->tick2();
+        }
+        return s1->track2() < s2->track2();
+    });
+}
+
 #ifndef NDEBUG
 //---------------------------------------------------------
 //   dump
@@ -23,8 +23,11 @@
 #ifndef __SPANNERMAP_H__
 #define __SPANNERMAP_H__
 
+#include <atomic>
 #include <map>
-#include "thirdparty/intervaltree/IntervalTree.h"
+#include <mutex>
+
+#include "spannerintervaltree.h"
 
 namespace mu::engraving {
 class Spanner;
@@ -33,16 +36,25 @@ class Spanner;
 //   SpannerMap
 //---------------------------------------------------------
 
+//! NOTE The interval tree is kept up to date on every change,
+//! it is only rebuilt on the next query after setDirty().
+//! The queries can be run concurrently, as long as the map isn't changed meanwhile
+//! The spanners are found in the order of their start ticks, then in the order they were added,
+//! whoever depends on the order (layout, file writing, export) must sort them with sortByPosition()
+
 class SpannerMap : std::multimap<int, Spanner*>
 {
-    mutable bool dirty;
-    mutable interval_tree::IntervalTree<Spanner*> tree;
-    std::vector<interval_tree::Interval<Spanner*> > results;
+    mutable std::atomic<bool> dirty;
+    mutable std::mutex treeMutex;
+    mutable SpannerIntervalTree tree;
+
+    void ensureTree() const;
+    void rebuildTree() const;
 
 public:
     SpannerMap();
-    const std::vector<interval_tree::Interval<Spanner*> >& findContained(int start, int stop);
-    const std::vector<interval_tree::Interval<Spanner*> >& findOverlapping(int start, int stop);
+    std::vector<interval_tree::Interval<Spanner*> > findContained(int start, int stop) const;
+    std::vector<interval_tree::Interval<Spanner*> > findOverlapping(int start, int stop) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
     std::multimap<int, Spanner*>::const_reverse_iterator crbegin() const { return std::multimap<int, Spanner*>::crbegin(); }
     std::multimap<int, Spanner*>::const_reverse_iterator crend() const { return std::multimap<int, Spanner*>::crend(); }
@@ -50,9 +62,14 @@ public:
     std::multimap<int, Spanner*>::const_iterator cend() const { return std::multimap<int, Spanner*>::cend(); }
     void addSpanner(Spanner* s);
     bool removeSpanner(Spanner* s);
-    void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
+    void clear();
     void update() const;
-    void setDirty() const { dirty = true; }     // must be called if a spanner changes start/length
+    void updateSpanner(const Spanner* s);       // must be called if a spanner changes start/length
+    void setDirty() const { dirty = true; }     // rebuilds the tree on the next query
+
+    //! NOTE Sorts by start tick, track, end tick and end track,
+    //! so the order doesn't depend on the order, in which the spanners were added
+    static void sortByPosition(std::vector<interval_tree::Interval<Spanner*> >& spanners);
 #ifndef NDEBUG
     void dump() const;
 #endif
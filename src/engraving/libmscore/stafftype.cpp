@@ -1035,7 +1035,7 @@ void TabDurationSymbol::draw(mu::draw::Painter* painter) const
     if (_beamGrid == TabBeamGrid::NONE) {
         // if no beam grid, draw symbol
         mu::draw::Font f(_tab->durationFont());
-        f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+        f.setPointSizeF(f.pointSizeF() * RenderContext::current().pixelRatio);
         painter->setFont(f);
         painter->drawText(PointF(0.0, 0.0), _text);
     } else {
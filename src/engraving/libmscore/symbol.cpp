@@ -243,7 +243,7 @@ void FSymbol::draw(mu::draw::Painter* painter) const
 {
     QString s;
     mu::draw::Font f(_font);
-    f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+    f.setPointSizeF(f.pointSizeF() * RenderContext::current().pixelRatio);
     painter->setFont(f);
     if (_code & 0xffff0000) {
         s = QChar(QChar::highSurrogate(_code));
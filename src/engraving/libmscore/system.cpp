@@ -911,6 +911,7 @@ void System::layout2(const LayoutContext& ctx)
     Fraction stick = measures().front()->tick();
     Fraction etick = measures().back()->endTick();
     auto spanners = ctx.score()->spannerMap().findOverlapping(stick.ticks(), etick.ticks());
+    SpannerMap::sortByPosition(spanners);
 
     std::vector<Spanner*> spanner;
     for (auto interval : spanners) {
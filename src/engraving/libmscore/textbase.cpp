@@ -747,7 +747,7 @@ bool TextFragment::operator ==(const TextFragment& f) const
 void TextFragment::draw(mu::draw::Painter* p, const TextBase* t) const
 {
     mu::draw::Font f(font(t));
-    f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+    f.setPointSizeF(f.pointSizeF() * RenderContext::current().pixelRatio);
 #ifndef Q_OS_MACOS
     TextBase::drawTextWorkaround(p, f, pos, text);
 #else
@@ -763,7 +763,7 @@ void TextFragment::draw(mu::draw::Painter* p, const TextBase* t) const
 void TextBase::drawTextWorkaround(mu::draw::Painter* p, mu::draw::Font& f, const mu::PointF& pos, const QString& text)
 {
     qreal mm = p->worldTransform().m11();
-    if (!(MScore::pdfPrinting) && (mm < 1.0) && f.bold() && !(f.underline() || f.strike())) {
+    if (!(RenderContext::current().pdfPrinting) && (mm < 1.0) && f.bold() && !(f.underline() || f.strike())) {
         p->drawTextWorkaround(f, pos, text);
     } else {
         p->setFont(f);
@@ -1002,7 +1002,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
         if (column == col) {
             return f.pos.x();
         }
-        mu::draw::FontMetrics fm(f.font(t));
+        const std::vector<qreal> positions = mu::draw::FontMetrics(f.font(t)).characterPositions(f.text);
         int idx = 0;
         for (const QChar& c : qAsConst(f.text)) {
             ++idx;
@@ -1011,7 +1011,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
             }
             ++col;
             if (column == col) {
-                return f.pos.x() + fm.width(f.text.left(idx));
+                return f.pos.x() + positions[idx - 1];
             }
         }
     }
@@ -1102,13 +1102,13 @@ int TextBlock::column(qreal x, TextBase* t) const
             return col;
         }
         qreal px = 0.0;
+        const std::vector<qreal> positions = mu::draw::FontMetrics(f.font(t)).characterPositions(f.text);
         for (const QChar& c : qAsConst(f.text)) {
             ++idx;
             if (c.isHighSurrogate()) {
                 continue;
             }
-            mu::draw::FontMetrics fm(f.font(t));
-            qreal xo = fm.width(f.text.left(idx));
+            qreal xo = positions[idx - 1];
             if (x <= f.pos.x() + px + (xo - px) * .5) {
                 return col;
             }
@@ -2752,8 +2752,9 @@ bool TextBase::validateText(QString& s)
     QString ss = "<data>" + d + "</data>\n";
     QByteArray ba = ss.toUtf8();
     XmlReader xml(ByteArray::fromRawData(reinterpret_cast<const uint8_t*>(ba.constData()), ba.size()));
-    while (xml.readNextStartElement()) {
-        // LOGD("  token %d <%s>", int(xml.tokenType()), qPrintable(xml.name().toString()));
+    //! NOTE The reader is a pull parser, the whole text has to be read to be validated
+    while (!xml.atEnd()) {
+        xml.readNext();
     }
     if (xml.error() == XmlReader::NoError) {
         s = d;
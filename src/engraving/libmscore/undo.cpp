@@ -306,12 +306,16 @@ void UndoStack::beginMacro(Score* score)
     curCmd = new UndoMacro(score);
 }
 
+static thread_local std::vector<UndoCommand*>* s_commandsCollector = nullptr;
+
 //---------------------------------------------------------
 //   push
 //---------------------------------------------------------
 
 void UndoStack::push(UndoCommand* cmd, EditData* ed)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_pushMutex);
+
     if (!curCmd) {
         // this can happen for layout() outside of a command (load)
         if (!ScoreLoad::loading()) {
@@ -330,7 +334,11 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
         LOG_UNDO() << cmd->name();
     }
 #endif
-    curCmd->appendChild(cmd);
+    if (s_commandsCollector) {
+        s_commandsCollector->push_back(cmd);
+    } else {
+        curCmd->appendChild(cmd);
+    }
     cmd->redo(ed);
 }
 
@@ -340,13 +348,45 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
 
 void UndoStack::push1(UndoCommand* cmd)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_pushMutex);
+
     if (!curCmd) {
         if (!ScoreLoad::loading()) {
             LOGW("no active command, UndoStack %p", this);
         }
         return;
     }
-    curCmd->appendChild(cmd);
+    if (s_commandsCollector) {
+        s_commandsCollector->push_back(cmd);
+    } else {
+        curCmd->appendChild(cmd);
+    }
+}
+
+//---------------------------------------------------------
+//   setCommandsCollector
+//---------------------------------------------------------
+
+void UndoStack::setCommandsCollector(std::vector<UndoCommand*>* collector)
+{
+    s_commandsCollector = collector;
+}
+
+//---------------------------------------------------------
+//   appendCollected
+//---------------------------------------------------------
+
+void UndoStack::appendCollected(const std::vector<UndoCommand*>& commands)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_pushMutex);
+
+    IF_ASSERT_FAILED(curCmd || commands.empty()) {
+        return;
+    }
+
+    for (UndoCommand* cmd : commands) {
+        curCmd->appendChild(cmd);
+    }
 }
 
 //---------------------------------------------------------
@@ -29,6 +29,7 @@
 */
 
 #include <map>
+#include <mutex>
 
 #include "style/style.h"
 #include "compat/midi/midipatch.h"
@@ -210,6 +211,10 @@ class UndoStack
     int cleanState;
     size_t curIdx = 0;
 
+    //! NOTE The parallel phase of the layout may push commands from several threads,
+    //! they are executed one at a time and collected per thread (see setCommandsCollector())
+    std::recursive_mutex m_pushMutex;
+
     void remove(size_t idx);
 
 public:
@@ -239,6 +244,12 @@ public:
 
     void mergeCommands(size_t startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    //! NOTE While a collector is set, the commands pushed by the calling thread are executed at once,
+    //! but appended to the current command only by appendCollected(). So the order of the commands
+    //! pushed by worker threads doesn't depend on the scheduling
+    static void setCommandsCollector(std::vector<UndoCommand*>* collector);
+    void appendCollected(const std::vector<UndoCommand*>& commands);
 };
 
 //---------------------------------------------------------
@@ -22,6 +22,7 @@
 
 #include "utils.h"
 
+#include <algorithm>
 #include <cmath>
 #include <QtMath>
 #include <QRegularExpression>
@@ -61,6 +62,119 @@ RectF handleRect(const PointF& pos)
     return RectF(pos.x() - 4, pos.y() - 4, 8, 8);
 }
 
+//---------------------------------------------------------
+//   buildMeasureIndex
+//---------------------------------------------------------
+
+std::shared_ptr<Score::MeasureIndex> Score::buildMeasureIndex(Measure* first, bool mmRests)
+{
+    auto index = std::make_shared<MeasureIndex>();
+    for (Measure* m = first; m; m = mmRests ? m->nextMeasureMM() : m->nextMeasure()) {
+        if (!index->measures.empty() && m->tick() < index->measures.back()->tick()) {
+            index->ticksAscending = false;
+        }
+        index->measures.push_back(m);
+    }
+
+    return index;
+}
+
+//---------------------------------------------------------
+//   measureIndex
+//---------------------------------------------------------
+
+Score::MeasureIndexPtr Score::measureIndex() const
+{
+    std::lock_guard<std::mutex> lock(m_measureIndexMutex);
+
+    if (m_measureIndex && m_measureIndex->listGeneration == _measures.generation()) {
+        return m_measureIndex;
+    }
+
+    auto index = buildMeasureIndex(firstMeasure(), false);
+    index->listGeneration = _measures.generation();
+    m_measureIndex = index;
+
+    return m_measureIndex;
+}
+
+//---------------------------------------------------------
+//   measureMMIndex
+//---------------------------------------------------------
+
+Score::MeasureIndexPtr Score::measureMMIndex() const
+{
+    bool createMMRests = styleB(Sid::createMultiMeasureRests);
+
+    std::lock_guard<std::mutex> lock(m_measureIndexMutex);
+
+    if (m_measureMMIndex && m_measureMMIndex->listGeneration == _measures.generation()
+        && m_measureMMIndex->createMMRests == createMMRests) {
+        return m_measureMMIndex;
+    }
+
+    auto index = buildMeasureIndex(firstMeasureMM(), true);
+    index->listGeneration = _measures.generation();
+    index->createMMRests = createMMRests;
+    m_measureMMIndex = index;
+
+    return m_measureMMIndex;
+}
+
+//---------------------------------------------------------
+//   invalidateMeasureIndex
+//    called when measures are relinked outside of the
+//    measure list, e.g. by mmrests, or a measure tick changes
+//---------------------------------------------------------
+
+void Score::invalidateMeasureIndex()
+{
+    std::lock_guard<std::mutex> lock(m_measureIndexMutex);
+
+    m_measureIndex = nullptr;
+    m_measureMMIndex = nullptr;
+}
+
+//---------------------------------------------------------
+//   findMeasure
+//    the last measure, that starts at or before tick,
+//    the same result as a linear search from the first measure
+//---------------------------------------------------------
+
+Measure* Score::findMeasure(const MeasureIndex& index, const Fraction& tick)
+{
+    const std::vector<Measure*>& measures = index.measures;
+
+    std::vector<Measure*>::const_iterator it;
+    if (index.ticksAscending) {
+        it = std::upper_bound(measures.cbegin(), measures.cend(), tick, [](const Fraction& t, const Measure* m) {
+            return t < m->tick();
+        });
+    } else {
+        //! NOTE The ticks are being fixed, the binary search would not match the linear one
+        it = std::find_if(measures.cbegin(), measures.cend(), [&tick](const Measure* m) {
+            return tick < m->tick();
+        });
+    }
+
+    if (it == measures.cbegin()) {
+        Q_ASSERT(measures.empty());
+        return 0;
+    }
+
+    Measure* lm = *(it - 1);
+    if (it != measures.cend()) {
+        return lm;
+    }
+
+    // check last measure
+    if ((tick >= lm->tick()) && (tick <= lm->endTick())) {
+        return lm;
+    }
+
+    return 0;
+}
+
 //---------------------------------------------------------
 //   tick2measure
 //---------------------------------------------------------
@@ -74,20 +188,12 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
-    Measure* lm = 0;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        if (tick < m->tick()) {
-            Q_ASSERT(lm);
-            return lm;
-        }
-        lm = m;
+    MeasureIndexPtr index = measureIndex();
+    Measure* m = findMeasure(*index, tick);
+    if (!m) {
+        LOGD("tick2measure %d (max %d) not found", tick.ticks(), index->measures.empty() ? -1 : index->measures.back()->tick().ticks());
     }
-    // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
-        return lm;
-    }
-    LOGD("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-    return 0;
+    return m;
 }
 
 //---------------------------------------------------------
@@ -104,21 +210,13 @@ Measure* Score::tick2measureMM(const Fraction& t) const
         tick = Fraction(0, 1);
     }
 
-    Measure* lm = 0;
-
-    for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-        if (tick < m->tick()) {
-            Q_ASSERT(lm);
-            return lm;
-        }
-        lm = m;
+    MeasureIndexPtr index = measureMMIndex();
+    Measure* m = findMeasure(*index, tick);
+    if (!m) {
+        LOGD("tick2measureMM %d (max %d) not found", tick.ticks(),
+             index->measures.empty() ? -1 : index->measures.back()->tick().ticks());
     }
-    // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
-        return lm;
-    }
-    LOGD("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-    return 0;
+    return m;
 }
 
 //---------------------------------------------------------
@@ -127,11 +225,25 @@ Measure* Score::tick2measureMM(const Fraction& t) const
 
 MeasureBase* Score::tick2measureBase(const Fraction& tick) const
 {
-    for (MeasureBase* mb = first(); mb; mb = mb->next()) {
-        Fraction st = mb->tick();
-        Fraction l  = mb->ticks();
-        if (tick >= st && tick < (st + l)) {
-            return mb;
+    //! NOTE Frames have no length, so only measures can contain the tick
+    const std::vector<Measure*>& measures = measureIndex().measures;
+    auto end = std::upper_bound(measures.cbegin(), measures.cend(), tick, [](const Fraction& t, const Measure* m) {
+        return t < m->tick();
+    });
+
+    if (end == measures.cbegin()) {
+        return 0;
+    }
+
+    // the first of the measures, that start at the same tick
+    Fraction st = (*(end - 1))->tick();
+    auto it = std::lower_bound(measures.cbegin(), end, st, [](const Measure* m, const Fraction& t) {
+        return m->tick() < t;
+    });
+
+    for (; it != end; ++it) {
+        if (tick < (*it)->endTick()) {
+            return *it;
         }
     }
 //      LOGD("tick2measureBase %d not found", tick);
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "pagedisplaylists.h"
+
+#include <algorithm>
+
+#include "infrastructure/draw/bufferedpaintprovider.h"
+#include "infrastructure/draw/utils/drawdatapaint.h"
+#include "libmscore/image.h"
+#include "libmscore/mscore.h"
+#include "libmscore/page.h"
+
+#include "paint.h"
+
+#include "log.h"
+
+using namespace mu::draw;
+using namespace mu::engraving;
+
+bool PageDisplayLists::paintPage(Painter& painter, const Page* page)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(page) {
+        return false;
+    }
+
+    const RenderContext& context = RenderContext::current();
+
+    DrawDataPtr data;
+    double recordedPixelRatio = context.pixelRatio;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(page);
+        if (it != m_entries.end() && it->second.revision == page->contentRevision()
+            && it->second.svgPrinting == context.svgPrinting) {
+            data = it->second.data;
+            recordedPixelRatio = it->second.pixelRatio;
+            ++m_statistics.replayed;
+        }
+    }
+
+    //! NOTE Recording happens outside of the lock, so different pages can be recorded concurrently
+    if (!data) {
+        data = record(page);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!data) {
+            m_entries.erase(page);
+            ++m_statistics.notRecordable;
+            return false;
+        }
+
+        Entry entry;
+        entry.revision = page->contentRevision();
+        entry.pixelRatio = context.pixelRatio;
+        entry.svgPrinting = context.svgPrinting;
+        entry.data = data;
+
+        m_entries.insert_or_assign(page, std::move(entry));
+        ++m_statistics.recorded;
+    }
+
+    //! NOTE The font sizes depend on the pixel ratio of the paint device, see RenderContext::pixelRatio
+    double fontScaling = context.pixelRatio / recordedPixelRatio;
+    DrawDataPaint::paint(painter, *data, fontScaling);
+
+    return true;
+}
+
+DrawDataPtr PageDisplayLists::record(const Page* page) const
+{
+    TRACEFUNC;
+
+    Page* p = const_cast<Page*>(page);
+    std::vector<EngravingItem*> elements = p->items(p->bbox());
+
+    //! NOTE Svg images are rendered by QSvgRenderer directly into the Qt painter, so they can't be recorded
+    for (const EngravingItem* item : elements) {
+        if (item->isImage() && toImage(item)->getImageType() == ImageType::SVG) {
+            return nullptr;
+        }
+    }
+
+    auto provider = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter painter(provider, "page_display_list");
+        painter.setAntialiasing(true);
+        Paint::paintElements(painter, elements, true);
+        painter.endDraw();
+    }
+
+    return std::make_shared<DrawData>(provider->drawData());
+}
+
+void PageDisplayLists::invalidate(const Page* page)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(page);
+}
+
+void PageDisplayLists::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+void PageDisplayLists::removeStale(const std::vector<Page*>& pages)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (std::find(pages.begin(), pages.end(), it->first) == pages.end()) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t PageDisplayLists::count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+PageDisplayLists::Statistics PageDisplayLists::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_PAGEDISPLAYLISTS_H
+#define MU_ENGRAVING_PAGEDISPLAYLISTS_H
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "infrastructure/draw/painter.h"
+#include "infrastructure/draw/buffereddrawtypes.h"
+
+namespace mu::engraving {
+class Page;
+
+//! NOTE Retained display lists of pages.
+//! The drawing of a page is recorded once (with BufferedPaintProvider)
+//! and replayed into any painter (Qt painter, pdf, png, printer) until the content of the page changes,
+//! so repeated paints of the same page skip the traversal of the elements.
+//! A page is re-recorded when its content revision changes, see Page::contentRevision.
+//! Different pages can be painted concurrently.
+class PageDisplayLists
+{
+public:
+    struct Statistics {
+        size_t recorded = 0;
+        size_t replayed = 0;
+        size_t notRecordable = 0;
+    };
+
+    //! NOTE Paints all elements of the page in printing mode (without selection and debug drawing),
+    //! returns false if the page can't be replayed from a display list,
+    //! then the page should be painted in the usual way
+    bool paintPage(mu::draw::Painter& painter, const Page* page);
+
+    void invalidate(const Page* page);
+    void clear();
+
+    //! NOTE Removes the display lists of pages, that are not in the given list
+    void removeStale(const std::vector<Page*>& pages);
+
+    size_t count() const;
+    Statistics statistics() const;
+
+private:
+    struct Entry {
+        uint64_t revision = 0;
+        double pixelRatio = 1.0;
+        bool svgPrinting = false;
+        mu::draw::DrawDataPtr data;
+    };
+
+    mu::draw::DrawDataPtr record(const Page* page) const;
+
+    std::map<const Page*, Entry> m_entries;
+    Statistics m_statistics;
+    mutable std::mutex m_mutex;
+};
+}
+
+#endif // MU_ENGRAVING_PAGEDISPLAYLISTS_H
@@ -36,6 +36,9 @@
 
 #include "utils/pitchutils.h"
 
+#include "concurrency/concurrency.h"
+#include "log.h"
+
 using namespace mu;
 using namespace mu::engraving;
 using namespace mu::mpe;
@@ -60,12 +63,13 @@ void PlaybackModel::load(Score* score)
         TickBoundaries tickRange = tickBoundaries(range);
         TrackBoundaries trackRange = trackBoundaries(range);
 
+        ChangedTracks trackChanges;
+
         clearExpiredTracks();
         clearExpiredContexts(trackRange.trackFrom, trackRange.trackTo);
-        clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo);
+        clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges);
 
         InstrumentTrackIdSet existingTracks = existingTrackIdSet();
-        ChangedTrackIdSet trackChanges;
         update(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges);
         notifyAboutChanges(std::move(trackChanges), std::move(existingTracks));
     });
@@ -97,7 +101,7 @@ void PlaybackModel::reload()
     update(tickFrom, tickTo, trackFrom, trackTo);
 
     for (auto& pair : m_playbackDataMap) {
-        pair.second.mainStream.send(pair.second.originEvents);
+        pair.second.mainStream.send(PlaybackEventsDelta::full(pair.second.originEvents));
     }
 
     m_dataChanged.notify();
@@ -195,7 +199,7 @@ async::Channel<InstrumentTrackId> PlaybackModel::trackRemoved() const
 }
 
 void PlaybackModel::update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                           ChangedTrackIdSet* trackChanges)
+                           ChangedTracks* trackChanges)
 {
     updateSetupData();
     updateContext(trackFrom, trackTo);
@@ -237,10 +241,14 @@ void PlaybackModel::updateContext(const track_idx_t trackFrom, const track_idx_t
 }
 
 void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                                 ChangedTrackIdSet* trackChanges)
+                                 ChangedTracks* trackChanges)
 {
     std::set<ID> changedPartIdSet = m_score->partIdsFromRange(trackFrom, trackTo);
 
+    //! NOTE The score is walked once to collect what has to be rendered for every track,
+    //! the rendering itself is done by renderEvents()
+    TrackRenderJobs jobs;
+
     for (const RepeatSegment* repeatSegment : repeatList()) {
         int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
         int repeatStartTick = repeatSegment->tick;
@@ -270,6 +278,9 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                     continue;
                 }
 
+                timestamp_t segmentStartTimestamp = timestampFromTicks(m_score, segmentStartTick + tickPositionOffset);
+                timestamp_t segmentEndTimestamp = timestampFromTicks(m_score, segmentEndTick + tickPositionOffset);
+
                 for (const EngravingItem* item : segment->elist()) {
                     if (!item || !item->isChordRest() || !item->part()) {
                         continue;
@@ -295,19 +306,66 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                         continue;
                     }
 
-                    m_renderer.render(item, tickPositionOffset, ctx.appliableDynamicLevel(segmentStartTick + tickPositionOffset),
-                                      ctx.persistentArticulationType(segmentStartTick + tickPositionOffset), std::move(profile),
-                                      m_playbackDataMap[trackId].originEvents);
+                    RenderJob job;
+                    job.item = item;
+                    job.tickPositionOffset = tickPositionOffset;
+                    job.dynamicLevel = ctx.appliableDynamicLevel(segmentStartTick + tickPositionOffset);
+                    job.persistentArticulationType = ctx.persistentArticulationType(segmentStartTick + tickPositionOffset);
+                    job.profile = std::move(profile);
+                    jobs[trackId].push_back(std::move(job));
 
-                    collectChangesTracks(trackId, trackChanges);
+                    collectChangesTracks(trackId, segmentStartTimestamp, segmentEndTimestamp, trackChanges);
                 }
 
-                m_renderer.renderMetronome(m_score, segmentStartTick, segment->ticks().ticks(),
-                                           tickPositionOffset, m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
-                collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+                RenderJob metronomeJob;
+                metronomeJob.tickPositionOffset = tickPositionOffset;
+                metronomeJob.segmentStartTick = segmentStartTick;
+                metronomeJob.segmentTicks = segment->ticks().ticks();
+                jobs[METRONOME_TRACK_ID].push_back(std::move(metronomeJob));
+
+                collectChangesTracks(METRONOME_TRACK_ID, segmentStartTimestamp, segmentEndTimestamp, trackChanges);
             }
         }
     }
+
+    renderEvents(jobs);
+}
+
+void PlaybackModel::renderEvents(const TrackRenderJobs& jobs)
+{
+    TRACEFUNC;
+
+    //! NOTE Every track is rendered into its own events map, so the tracks don't share anything to be written
+    //! and can be rendered concurrently. The maps are resolved here, since operator[] isn't safe to call from the threads
+    std::vector<std::pair<const std::vector<RenderJob>*, PlaybackEventsMap*> > tracks;
+    tracks.reserve(jobs.size());
+
+    size_t jobsCount = 0;
+    for (const auto& pair : jobs) {
+        tracks.emplace_back(&pair.second, &m_playbackDataMap[pair.first].originEvents);
+        jobsCount += pair.second.size();
+    }
+
+    auto renderTrack = [this, &tracks](size_t i) {
+        PlaybackEventsMap& result = *tracks[i].second;
+
+        for (const RenderJob& job : *tracks[i].first) {
+            if (!job.item) {
+                m_renderer.renderMetronome(m_score, job.segmentStartTick, job.segmentTicks, job.tickPositionOffset, result);
+                continue;
+            }
+
+            m_renderer.render(job.item, job.tickPositionOffset, job.dynamicLevel, job.persistentArticulationType, job.profile, result);
+        }
+    };
+
+    //! NOTE Starting the threads isn't worth it for the small changes made while editing
+    static constexpr size_t MIN_JOBS_PER_THREAD = 64;
+
+    size_t threadsCount = MScore::playbackThreads > 0 ? static_cast<size_t>(MScore::playbackThreads) : concurrency::idealThreadCount();
+    threadsCount = std::min(threadsCount, jobsCount / MIN_JOBS_PER_THREAD);
+
+    concurrency::parallelFor(tracks.size(), threadsCount, renderTrack, "playback");
 }
 
 bool PlaybackModel::hasToReloadTracks(const std::unordered_set<ElementType>& changedTypes) const
@@ -388,43 +446,65 @@ void PlaybackModel::clearExpiredContexts(const track_idx_t trackFrom, const trac
     }
 }
 
-void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo)
+void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
+                                       ChangedTracks* trackChanges)
 {
     timestamp_t timestampFrom = timestampFromTicks(m_score, tickFrom);
     timestamp_t timestampTo = timestampFromTicks(m_score, tickTo);
 
+    //!Note See removeEvents()
+    timestamp_t removedFrom = timestampFrom == 0 ? std::numeric_limits<timestamp_t>::min() : timestampFrom;
+
     for (const Part* part : m_score->parts()) {
         if (part->startTrack() > trackTo || part->endTrack() <= trackFrom) {
             continue;
         }
 
         for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
+            if (!containsTrack(trackId)) {
+                continue;
+            }
+
             removeEvents(trackId, timestampFrom, timestampTo);
+            collectChangesTracks(trackId, removedFrom, timestampTo, trackChanges);
         }
     }
 
-    removeEvents(METRONOME_TRACK_ID, timestampFrom, timestampTo);
+    if (containsTrack(METRONOME_TRACK_ID)) {
+        removeEvents(METRONOME_TRACK_ID, timestampFrom, timestampTo);
+        collectChangesTracks(METRONOME_TRACK_ID, removedFrom, timestampTo, trackChanges);
+    }
 }
 
-void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result)
+void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, const timestamp_t timestampFrom, const timestamp_t timestampTo,
+                                         ChangedTracks* result)
 {
     if (!result) {
         return;
     }
 
-    result->insert(trackId);
+    std::vector<TimestampRange>& ranges = (*result)[trackId];
+
+    //! NOTE The segments are rendered one after another, so the ranges usually just grow
+    if (!ranges.empty() && timestampFrom >= ranges.back().first && timestampFrom <= ranges.back().second) {
+        ranges.back().second = std::max(ranges.back().second, timestampTo);
+        return;
+    }
+
+    ranges.emplace_back(timestampFrom, timestampTo);
 }
 
-void PlaybackModel::notifyAboutChanges(ChangedTrackIdSet&& trackChanges, InstrumentTrackIdSet&& existingTracks)
+void PlaybackModel::notifyAboutChanges(ChangedTracks&& trackChanges, InstrumentTrackIdSet&& existingTracks)
 {
-    for (const InstrumentTrackId& trackId : trackChanges) {
+    for (auto& pair : trackChanges) {
+        const InstrumentTrackId& trackId = pair.first;
         auto search = m_playbackDataMap.find(trackId);
 
         if (search == m_playbackDataMap.cend()) {
             continue;
         }
 
-        search->second.mainStream.send(search->second.originEvents);
+        search->second.mainStream.send(PlaybackEventsDelta::fromRanges(search->second.originEvents, std::move(pair.second)));
         search->second.dynamicLevelChanges.send(search->second.dynamicLevelMap);
 
         if (existingTracks.find(trackId) == existingTracks.cend()) {
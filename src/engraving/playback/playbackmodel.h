@@ -73,7 +73,22 @@ public:
 private:
     static const InstrumentTrackId METRONOME_TRACK_ID;
 
-    using ChangedTrackIdSet = InstrumentTrackIdSet;
+    //! NOTE The changed timestamp ranges of every changed track
+    using ChangedTracks = std::unordered_map<InstrumentTrackId, std::vector<mpe::TimestampRange> >;
+
+    //! NOTE What is rendered for a track, collected in the score order
+    struct RenderJob
+    {
+        const EngravingItem* item = nullptr; //! NOTE nullptr for the metronome
+        int tickPositionOffset = 0;
+        int segmentStartTick = 0;
+        int segmentTicks = 0;
+        mpe::dynamic_level_t dynamicLevel = 0;
+        mpe::ArticulationType persistentArticulationType = mpe::ArticulationType::Undefined;
+        mpe::ArticulationsProfilePtr profile;
+    };
+
+    using TrackRenderJobs = std::unordered_map<InstrumentTrackId, std::vector<RenderJob> >;
 
     struct TickBoundaries
     {
@@ -92,11 +107,12 @@ private:
     InstrumentTrackIdSet existingTrackIdSet() const;
 
     void update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                ChangedTrackIdSet* trackChanges = nullptr);
+                ChangedTracks* trackChanges = nullptr);
     void updateSetupData();
     void updateContext(const track_idx_t trackFrom, const track_idx_t trackTo);
     void updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                      ChangedTrackIdSet* trackChanges = nullptr);
+                      ChangedTracks* trackChanges = nullptr);
+    void renderEvents(const TrackRenderJobs& jobs);
 
     bool hasToReloadTracks(const std::unordered_set<ElementType>& changedTypes) const;
     bool hasToReloadScore(const std::unordered_set<ElementType>& changedTypes) const;
@@ -104,9 +120,11 @@ private:
     bool containsTrack(const InstrumentTrackId& trackId) const;
     void clearExpiredTracks();
     void clearExpiredContexts(const track_idx_t trackFrom, const track_idx_t trackTo);
-    void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo);
-    void collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result);
-    void notifyAboutChanges(ChangedTrackIdSet&& trackChanges, InstrumentTrackIdSet&& existingTracks);
+    void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
+                            ChangedTracks* trackChanges = nullptr);
+    void collectChangesTracks(const InstrumentTrackId& trackId, const mpe::timestamp_t timestampFrom, const mpe::timestamp_t timestampTo,
+                              ChangedTracks* result);
+    void notifyAboutChanges(ChangedTracks&& trackChanges, InstrumentTrackIdSet&& existingTracks);
 
     void removeEvents(const InstrumentTrackId& trackId, const mpe::timestamp_t timestampFrom, const mpe::timestamp_t timestampTo);
 
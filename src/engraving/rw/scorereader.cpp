@@ -22,6 +22,7 @@
 #include "scorereader.h"
 
 #include "io/buffer.h"
+#include "concurrency/concurrency.h"
 
 #include "compat/readstyle.h"
 #include "compat/read114.h"
@@ -103,36 +104,67 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
     // Read excerpts
     if (masterScore->mscVersion() >= 400) {
         std::vector<QString> excerptNames = mscReader.excerptNames();
-        for (const QString& excerptName : excerptNames) {
-            Score* partScore = masterScore->createScore();
 
-            compat::ReadStyleHook::setupDefaultStyle(partScore);
+        struct ExcerptFile {
+            Score* score = nullptr;
+            ByteArray data;
+        };
 
-            Excerpt* ex = new Excerpt(masterScore);
-            ex->setExcerptScore(partScore);
+        std::vector<ExcerptFile> excerptFiles(excerptNames.size());
+        for (ExcerptFile& file : excerptFiles) {
+            file.score = masterScore->createScore();
+            compat::ReadStyleHook::setupDefaultStyle(file.score);
+        }
+
+        //! NOTE Decompressing the files and reading the styles doesn't touch anything shared,
+        //! so it is done concurrently, if the reader allows it
+        {
+            TRACEFUNC_C("decompress excerpts and read styles");
+
+            size_t threads = mscReader.isConcurrentReadingSupported() ? concurrency::idealThreadCount() : 1;
+            concurrency::parallelFor(excerptFiles.size(), threads, [&](size_t i) {
+                ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptNames[i]);
+                Buffer excerptStyleBuf(&excerptStyleData);
+                excerptStyleBuf.open(IODevice::ReadOnly);
+                excerptFiles[i].score->style().read(&excerptStyleBuf);
+
+                excerptFiles[i].data = mscReader.readExcerptFile(excerptNames[i]);
+            }, "excerpts");
+        }
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptName);
-            Buffer excerptStyleBuf(&excerptStyleData);
-            excerptStyleBuf.open(IODevice::ReadOnly);
-            partScore->style().read(&excerptStyleBuf);
+        //! NOTE The elements of the parts are linked with the elements of the master score while reading,
+        //! so the excerpts themselves are read one by one
+        {
+            TRACEFUNC_C("read excerpts");
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptName);
+            for (size_t i = 0; i < excerptFiles.size(); ++i) {
+                const QString& excerptName = excerptNames[i];
+                Score* partScore = excerptFiles[i].score;
 
-            ReadContext ctx(partScore);
-            ctx.initLinks(masterScoreCtx);
+                Excerpt* ex = new Excerpt(masterScore);
+                ex->setExcerptScore(partScore);
 
-            XmlReader xml(excerptData);
-            xml.setDocName(excerptName);
-            xml.setContext(&ctx);
+                ReadContext ctx(partScore);
+                ctx.initLinks(masterScoreCtx);
 
-            Read400::read400(partScore, xml, ctx);
+                XmlReader xml(excerptFiles[i].data);
+                xml.setDocName(excerptName);
+                xml.setContext(&ctx);
 
-            partScore->linkMeasures(masterScore);
-            ex->setTracksMapping(xml.context()->tracks());
+                Read400::read400(partScore, xml, ctx);
 
-            ex->setName(excerptName);
+                partScore->linkMeasures(masterScore);
+                ex->setTracksMapping(xml.context()->tracks());
 
-            masterScore->addExcerpt(ex);
+                ex->setName(excerptName);
+
+                masterScore->addExcerpt(ex);
+
+                //! NOTE The part is laid out when its view or an export needs its pages for the first time
+                partScore->deferLayout();
+
+                excerptFiles[i].data = ByteArray();
+            }
         }
     }
 
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "libmscore/bsp.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/page.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu;
+using namespace mu::engraving;
+
+class BspTests : public ::testing::Test
+{
+protected:
+    static std::vector<RectF> queryRects(const Page* page)
+    {
+        //! NOTE Rects of different sizes in a grid over the page, like viewports and lasso selections
+        std::vector<RectF> rects;
+        const RectF pageRect = page->bbox();
+        for (int size : { 4, 16, 64 }) {
+            qreal w = pageRect.width() / 8;
+            qreal h = pageRect.height() / size;
+            for (qreal y = pageRect.top() - h; y < pageRect.bottom(); y += h * 0.75) {
+                for (qreal x = pageRect.left() - w; x < pageRect.right(); x += w * 0.75) {
+                    rects.push_back(RectF(x, y, w, h));
+                }
+            }
+        }
+        return rects;
+    }
+
+    static std::vector<PointF> queryPoints(const Page* page)
+    {
+        std::vector<PointF> points;
+        const RectF pageRect = page->bbox();
+        const qreal step = pageRect.width() / 97;
+        for (qreal y = pageRect.top(); y < pageRect.bottom(); y += step) {
+            for (qreal x = pageRect.left(); x < pageRect.right(); x += step) {
+                points.push_back(PointF(x, y));
+            }
+        }
+        return points;
+    }
+
+    static std::vector<EngravingItem*> sorted(std::vector<EngravingItem*> items)
+    {
+        std::sort(items.begin(), items.end());
+        return items;
+    }
+
+    static void checkSameAsScan(Score* score)
+    {
+        for (Page* page : score->pages()) {
+            const std::vector<EngravingItem*> elements = page->elements();
+
+            for (const RectF& rect : queryRects(page)) {
+                std::vector<EngravingItem*> expected;
+                for (EngravingItem* e : elements) {
+                    if (e->pageBoundingRect().intersects(rect)) {
+                        expected.push_back(e);
+                    }
+                }
+                ASSERT_EQ(sorted(page->items(rect)), sorted(expected));
+            }
+
+            for (const PointF& point : queryPoints(page)) {
+                std::vector<EngravingItem*> expected;
+                for (EngravingItem* e : elements) {
+                    if (e->contains(point)) {
+                        expected.push_back(e);
+                    }
+                }
+                ASSERT_EQ(sorted(page->items(point)), sorted(expected));
+            }
+        }
+    }
+};
+
+TEST_F(BspTests, Items)
+{
+    //! GIVEN A laid out score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "layout_elements.mscx");
+    ASSERT_TRUE(score);
+
+    //! CHECK The tree finds the same elements as a scan of all elements of the page
+    checkSameAsScan(score);
+
+    delete score;
+}
+
+TEST_F(BspTests, ItemsAfterRelayout)
+{
+    //! GIVEN A laid out score with an up to date tree
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+    checkSameAsScan(score);
+
+    //! DO Move most of the elements and lay out the score again, so elements are moved, deleted and created
+    score->setStyleValue(Sid::measureSpacing, score->styleD(Sid::measureSpacing) * 1.3);
+    score->doLayout();
+
+    //! CHECK The rebuilt tree finds the same elements as a scan
+    checkSameAsScan(score);
+
+    //! DO Restore the layout
+    score->setStyleValue(Sid::measureSpacing, score->styleD(Sid::measureSpacing) / 1.3);
+    score->doLayout();
+
+    //! CHECK
+    checkSameAsScan(score);
+
+    delete score;
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(BspTests, DISABLED_Benchmark_PageItems)
+{
+    using clock = std::chrono::steady_clock;
+
+    for (const QString& file : { "layout_elements.mscx", "moonlight.mscx" }) {
+        //! GIVEN Dense pages
+        MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+        ASSERT_TRUE(score);
+
+        int64_t rebuildUs = 0;
+        int64_t pageRebuildUs = 0;
+        int64_t rectUs = 0;
+        int64_t pointUs = 0;
+        size_t elementCount = 0;
+        size_t rectCount = 0;
+        size_t pointCount = 0;
+        size_t found = 0;
+
+        constexpr int REPEATS = 20;
+
+        for (Page* page : score->pages()) {
+            std::vector<EngravingItem*> elements = page->elements();
+            elementCount += elements.size();
+
+            //! DO Measure a rebuild of the tree, alone and through the page
+            clock::time_point start = clock::now();
+            for (int i = 0; i < REPEATS; ++i) {
+                BspTree tree;
+                tree.initialize(page->abbox(), static_cast<int>(elements.size()));
+                for (EngravingItem* e : elements) {
+                    tree.insert(e);
+                }
+            }
+            rebuildUs += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+            start = clock::now();
+            for (int i = 0; i < REPEATS; ++i) {
+                page->invalidateBspTree();
+                page->ensureBspTree();
+            }
+            pageRebuildUs += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+            //! DO Measure the queries
+            std::vector<RectF> rects = queryRects(page);
+            rectCount += rects.size() * REPEATS;
+            start = clock::now();
+            for (int i = 0; i < REPEATS; ++i) {
+                for (const RectF& rect : rects) {
+                    found += page->items(rect).size();
+                }
+            }
+            rectUs += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+            std::vector<PointF> points = queryPoints(page);
+            pointCount += points.size() * REPEATS;
+            start = clock::now();
+            for (int i = 0; i < REPEATS; ++i) {
+                for (const PointF& point : points) {
+                    found += page->items(point).size();
+                }
+            }
+            pointUs += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+        }
+
+        LOGI() << file << ": " << score->npages() << " pages, " << elementCount << " elements; "
+               << "rebuild " << rebuildUs / REPEATS << " us, page rebuild " << pageRebuildUs / REPEATS << " us; "
+               << rectCount << " items(rect) " << rectUs << " us; "
+               << pointCount << " items(point) " << pointUs << " us; found " << found;
+
+        //! CHECK The queries found something
+        EXPECT_GT(found, size_t(0));
+
+        delete score;
+    }
+}
@@ -0,0 +1,214 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+static const QString MEASURE_DATA_DIR("measure_data/");
+static constexpr int LARGE_SCORE_MEASURES = 2000;
+
+using namespace mu::engraving;
+
+class MeasureIndexTests : public ::testing::Test
+{
+protected:
+    //! NOTE The linear search, that tick2measure used before the index
+    static Measure* linearTick2measure(const Score* score, const Fraction& tick)
+    {
+        Measure* lm = nullptr;
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            if (tick < m->tick()) {
+                return lm;
+            }
+            lm = m;
+        }
+        if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
+            return lm;
+        }
+        return nullptr;
+    }
+
+    static void checkAllTicks(const Score* score)
+    {
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            for (const Fraction& tick : { m->tick(), m->tick() + m->ticks() / 2, m->endTick() }) {
+                ASSERT_EQ(score->tick2measure(tick), linearTick2measure(score, tick));
+                ASSERT_EQ(score->tick2measureBase(tick), tick < score->lastMeasure()->endTick() ? score->tick2measure(tick) : nullptr);
+            }
+        }
+    }
+
+    static MasterScore* readLargeScore()
+    {
+        MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+        if (!score) {
+            return nullptr;
+        }
+
+        score->startCmd();
+        score->appendMeasures(LARGE_SCORE_MEASURES - static_cast<int>(score->nmeasures()));
+        score->endCmd();
+
+        return score;
+    }
+};
+
+TEST_F(MeasureIndexTests, Tick2measure_FollowsInsertAndUndo)
+{
+    //! GIVEN A large score
+    MasterScore* score = readLargeScore();
+    ASSERT_TRUE(score);
+    checkAllTicks(score);
+
+    //! DO Insert a measure in the middle
+    Measure* m = score->tick2measure(score->lastMeasure()->tick() / 2);
+    score->startCmd();
+    score->insertMeasure(ElementType::MEASURE, m);
+    score->endCmd();
+
+    //! CHECK The lookups see the new measure and the shifted ticks
+    checkAllTicks(score);
+
+    //! DO Undo the insertion
+    score->undoRedo(true, 0);
+
+    //! CHECK The lookups match the linear search again
+    checkAllTicks(score);
+
+    delete score;
+}
+
+TEST_F(MeasureIndexTests, Tick2measure_TicksNotAscending_MatchesLinear)
+{
+    //! GIVEN A large score
+    MasterScore* score = readLargeScore();
+    ASSERT_TRUE(score);
+
+    //! DO Move a measure in the middle before its predecessor, as while the ticks are being fixed
+    Measure* m = score->tick2measure(score->lastMeasure()->tick() / 2);
+    Fraction tick = m->tick();
+    m->setTick(m->prevMeasure()->tick() - m->ticks());
+
+    //! CHECK The lookups still match the linear search
+    for (Measure* mm = score->firstMeasure(); mm; mm = mm->nextMeasure()) {
+        for (const Fraction& t : { mm->tick(), mm->tick() + mm->ticks() / 2, mm->endTick() }) {
+            ASSERT_EQ(score->tick2measure(t), linearTick2measure(score, t));
+        }
+    }
+
+    //! DO Restore the tick
+    m->setTick(tick);
+
+    //! CHECK The lookups see the restored tick
+    checkAllTicks(score);
+
+    delete score;
+}
+
+TEST_F(MeasureIndexTests, Tick2measure_ConcurrentLookups)
+{
+    //! GIVEN A large score, whose index has to be rebuilt
+    MasterScore* score = readLargeScore();
+    ASSERT_TRUE(score);
+
+    std::vector<Fraction> ticks;
+    std::vector<Measure*> expected;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        ticks.push_back(m->tick() + m->ticks() / 2);
+        expected.push_back(m);
+    }
+
+    score->invalidateMeasureIndex();
+
+    //! DO Look up all measures from several threads at once, invalidating the index in between
+    std::vector<size_t> mismatches(4, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < mismatches.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < ticks.size(); ++i) {
+                if (t == 0 && i % 100 == 0) {
+                    score->invalidateMeasureIndex();
+                }
+                if (score->tick2measure(ticks[i]) != expected[i]) {
+                    mismatches[t]++;
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! CHECK Every thread found the right measures
+    for (size_t count : mismatches) {
+        EXPECT_EQ(count, 0u);
+    }
+
+    delete score;
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(MeasureIndexTests, DISABLED_Benchmark_Tick2measure)
+{
+    //! GIVEN A large score and a lookup for the start of every measure
+    MasterScore* score = readLargeScore();
+    ASSERT_TRUE(score);
+
+    std::vector<Fraction> ticks;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        ticks.push_back(m->tick());
+    }
+
+    using clock = std::chrono::steady_clock;
+    size_t found = 0;
+
+    //! DO Measure the linear search and the index
+    clock::time_point start = clock::now();
+    for (const Fraction& tick : ticks) {
+        found += linearTick2measure(score, tick) ? 1 : 0;
+    }
+    int64_t linearUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    start = clock::now();
+    for (const Fraction& tick : ticks) {
+        found += score->tick2measure(tick) ? 1 : 0;
+    }
+    int64_t indexUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    LOGI() << ticks.size() << " lookups in " << score->nmeasures() << " measures: linear " << linearUs
+           << " us, index " << indexUs << " us";
+
+    //! CHECK Every lookup succeeded
+    EXPECT_EQ(found, ticks.size() * 2);
+
+    delete score;
+}
@@ -36,6 +36,8 @@ public:
     MOCK_METHOD(QString, partStyleFilePath, (), (const, override));
     MOCK_METHOD(void, setPartStyleFilePath, (const QString&), (override));
 
+    MOCK_METHOD(QString, scoreFontsCachePath, (), (const, override));
+
     MOCK_METHOD(std::string, iconsFontFamily, (), (const, override));
 
     MOCK_METHOD(draw::Color, defaultColor, (), (const, override));
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "infrastructure/draw/bufferedpaintprovider.h"
+#include "infrastructure/draw/painter.h"
+#include "infrastructure/draw/utils/drawcomp.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+#include "paint/pagedisplaylists.h"
+
+#include "utils/scorerw.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu;
+using namespace mu::engraving;
+
+class PageDisplayListsTests : public ::testing::Test
+{
+protected:
+    static draw::DrawDataPtr paintPage(PageDisplayLists& lists, const Page* page)
+    {
+        auto provider = std::make_shared<draw::BufferedPaintProvider>();
+        {
+            draw::Painter painter(provider, "page");
+            EXPECT_TRUE(lists.paintPage(painter, page));
+            painter.endDraw();
+        }
+
+        return std::make_shared<draw::DrawData>(provider->drawData());
+    }
+};
+
+TEST_F(PageDisplayListsTests, EditThenRepaint)
+{
+    //! GIVEN A laid out score, whose first page has been painted twice
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+
+    PageDisplayLists lists;
+    const Page* page = score->pages().front();
+
+    draw::DrawDataPtr before = paintPage(lists, page);
+    draw::DrawDataPtr replayed = paintPage(lists, page);
+
+    EXPECT_EQ(lists.statistics().recorded, size_t(1));
+    EXPECT_EQ(lists.statistics().replayed, size_t(1));
+    EXPECT_TRUE(draw::DrawComp::compare(replayed, before).empty());
+
+    //! DO Move the notes of the first measure up and paint the page again
+    score->startCmd();
+    score->select(score->firstMeasure(), SelectType::SINGLE, 0);
+    score->upDown(true, UpDownMode::CHROMATIC);
+    score->endCmd();
+
+    //! NOTE The page is laid out again in place, so the display list is found by the same key
+    ASSERT_EQ(score->pages().front(), page);
+    draw::DrawDataPtr after = paintPage(lists, page);
+
+    //! CHECK The page has been recorded again instead of replaying the old drawing
+    EXPECT_EQ(lists.statistics().recorded, size_t(2));
+    EXPECT_EQ(lists.statistics().replayed, size_t(1));
+    EXPECT_FALSE(draw::DrawComp::compare(after, before).empty());
+
+    delete score;
+}
+
+TEST_F(PageDisplayListsTests, EditOneMeasure_OtherPagesKeepRevision)
+{
+    //! GIVEN A laid out score with several pages
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_GT(score->npages(), size_t(3));
+
+    std::vector<uint64_t> revisions;
+    for (const Page* page : score->pages()) {
+        revisions.push_back(page->contentRevision());
+    }
+
+    //! DO Move the notes of a measure on a page in the middle an octave up.
+    //! The layout starts one measure earlier, so the measure starts the second system of the page
+    size_t editedPageIdx = score->npages() / 2;
+    Page* editedPage = score->pages().at(editedPageIdx);
+    ASSERT_GT(editedPage->systems().size(), size_t(1));
+    MeasureBase* measure = editedPage->systems().at(1)->firstMeasure();
+    ASSERT_TRUE(measure);
+
+    score->startCmd();
+    score->select(measure, SelectType::SINGLE, 0);
+    score->upDown(true, UpDownMode::OCTAVE);
+    score->endCmd();
+
+    //! CHECK Only the edited page got a new revision, the pages before it and the last page didn't
+    ASSERT_EQ(score->npages(), revisions.size());
+    for (size_t i = 0; i < editedPageIdx; ++i) {
+        EXPECT_EQ(score->pages().at(i)->contentRevision(), revisions.at(i)) << "page " << i;
+    }
+    EXPECT_NE(score->pages().at(editedPageIdx)->contentRevision(), revisions.at(editedPageIdx));
+    EXPECT_EQ(score->pages().back()->contentRevision(), revisions.back());
+
+    delete score;
+}
@@ -0,0 +1,247 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+
+#include "libmscore/beam.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/mscore.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+#include "libmscore/tie.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+static const QString BEAM_DATA_DIR("beam_data/");
+
+using namespace mu::engraving;
+
+class ParallelLayoutTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        MScore::layoutThreads = 1;
+    }
+
+    struct ElementLayout {
+        ElementType type = ElementType::INVALID;
+        mu::PointF pos;
+        mu::RectF bbox;
+
+        bool operator==(const ElementLayout& other) const
+        {
+            return type == other.type && pos == other.pos && bbox == other.bbox;
+        }
+    };
+
+    static void collectLayout(void* data, EngravingItem* e)
+    {
+        static_cast<std::vector<ElementLayout>*>(data)->push_back({ e->type(), e->pagePos(), e->bbox() });
+    }
+
+    static std::vector<ElementLayout> layoutWithThreads(MasterScore* score, int threads)
+    {
+        MScore::layoutThreads = threads;
+        score->doLayout();
+
+        std::vector<ElementLayout> result;
+        score->scanElements(&result, collectLayout, /* all */ true);
+        return result;
+    }
+
+    static std::vector<bool> tieDirections(MasterScore* score)
+    {
+        std::vector<bool> result;
+        for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            for (EngravingItem* e : s->elist()) {
+                if (!e || !e->isChord()) {
+                    continue;
+                }
+                for (const Note* note : toChord(e)->notes()) {
+                    if (note->tieFor()) {
+                        result.push_back(note->tieFor()->up());
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    static std::vector<std::string> layoutCommandsWithThreads(MasterScore* score, int threads)
+    {
+        MScore::layoutThreads = threads;
+
+        score->startCmd();
+        score->setLayoutAll();
+        score->doLayout();
+
+        std::vector<std::string> result;
+        for (const UndoCommand* cmd : score->undoStack()->current()->commands()) {
+            result.push_back(cmd->name());
+        }
+
+        score->endCmd(/* rollback */ true);
+        return result;
+    }
+
+    static std::set<const Beam*> beams(MasterScore* score)
+    {
+        std::set<const Beam*> result;
+        for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            for (EngravingItem* e : s->elist()) {
+                if (e && e->isChordRest() && toChordRest(e)->beam()) {
+                    result.insert(toChordRest(e)->beam());
+                }
+            }
+        }
+        return result;
+    }
+
+    static size_t crossStaffBeamsCount(MasterScore* score)
+    {
+        std::set<const Beam*> all = beams(score);
+        return static_cast<size_t>(std::count_if(all.cbegin(), all.cend(), [](const Beam* beam) {
+            return beam->cross();
+        }));
+    }
+
+    static size_t crossMeasureBeamsCount(MasterScore* score)
+    {
+        std::set<const Beam*> all = beams(score);
+        return static_cast<size_t>(std::count_if(all.cbegin(), all.cend(), [](const Beam* beam) {
+            return !beam->elements().empty() && beam->elements().front()->measure() != beam->elements().back()->measure();
+        }));
+    }
+
+    static void checkSameAsSerialLayout(const QString& file)
+    {
+        //! GIVEN A score
+        MasterScore* score = ScoreRW::readScore(file);
+        ASSERT_TRUE(score);
+        checkSameAsSerialLayout(score);
+        delete score;
+    }
+
+    static void checkSameAsSerialLayout(MasterScore* score)
+    {
+        //! DO Lay it out on one thread and on several threads
+        std::vector<ElementLayout> serial = layoutWithThreads(score, 1);
+        EXPECT_EQ(score->layoutStatistics().parallelMeasures, size_t(0));
+
+        std::vector<ElementLayout> parallel = layoutWithThreads(score, 4);
+
+        //! CHECK The parallel phase was used and every element ended up in the same place
+        EXPECT_GT(score->layoutStatistics().parallelMeasures, size_t(0));
+        ASSERT_EQ(serial.size(), parallel.size());
+        for (size_t i = 0; i < serial.size(); ++i) {
+            EXPECT_TRUE(serial[i] == parallel[i]) << "element " << i << " of type " << int(serial[i].type);
+        }
+    }
+};
+
+TEST_F(ParallelLayoutTests, LayoutElements_SameAsSerial)
+{
+    checkSameAsSerialLayout(ALL_ELEMENTS_DATA_DIR + "layout_elements.mscx");
+}
+
+TEST_F(ParallelLayoutTests, Tablature_SameAsSerial)
+{
+    checkSameAsSerialLayout(ALL_ELEMENTS_DATA_DIR + "layout_elements_tab.mscx");
+}
+
+TEST_F(ParallelLayoutTests, Moonlight_SameAsSerial)
+{
+    checkSameAsSerialLayout(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+}
+
+TEST_F(ParallelLayoutTests, CrossStaffBeams_SameAsSerial)
+{
+    //! GIVEN A score with beams across the staves of the piano
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+    EXPECT_GT(crossStaffBeamsCount(score), size_t(0));
+
+    //! CHECK The parallel layout places the beams and their chords as the serial one
+    checkSameAsSerialLayout(score);
+
+    delete score;
+}
+
+TEST_F(ParallelLayoutTests, CrossMeasureBeams_SameAsSerial)
+{
+    for (const char* file : { "Beam-CrossM1.mscx", "Beam-CrossM2.mscx", "Beam-CrossM3.mscx", "Beam-CrossM4.mscx" }) {
+        //! GIVEN A score with beams across barlines
+        MasterScore* score = ScoreRW::readScore(BEAM_DATA_DIR + file);
+        ASSERT_TRUE(score);
+        EXPECT_GT(crossMeasureBeamsCount(score), size_t(0)) << file;
+
+        //! CHECK The parallel layout places the beams and their chords as the serial one
+        checkSameAsSerialLayout(score);
+
+        delete score;
+    }
+}
+
+TEST_F(ParallelLayoutTests, CrossMeasureTies_SameAsSerial)
+{
+    //! GIVEN A score with ties across barlines
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    //! DO Lay it out on one thread and on several threads
+    MScore::layoutThreads = 1;
+    score->doLayout();
+    std::vector<bool> serial = tieDirections(score);
+
+    MScore::layoutThreads = 4;
+    score->doLayout();
+    std::vector<bool> parallel = tieDirections(score);
+
+    //! CHECK The ties got the same directions
+    EXPECT_FALSE(serial.empty());
+    EXPECT_EQ(serial, parallel);
+
+    delete score;
+}
+
+TEST_F(ParallelLayoutTests, UndoCommands_SameOrderAsSerial)
+{
+    //! GIVEN A score, whose chord layout pushes undo commands
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "layout_elements_tab.mscx");
+    ASSERT_TRUE(score);
+
+    //! DO Lay it out inside a command on one thread and on several threads
+    std::vector<std::string> serial = layoutCommandsWithThreads(score, 1);
+    std::vector<std::string> parallel = layoutCommandsWithThreads(score, 4);
+
+    //! CHECK The commands were recorded in the same order
+    EXPECT_EQ(serial, parallel);
+
+    delete score;
+}
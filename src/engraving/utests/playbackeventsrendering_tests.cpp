@@ -21,15 +21,20 @@
  */
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <memory>
 
+#include "mpe/packedevents.h"
 #include "mpe/tests/utils/articulationutils.h"
 
 #include "libmscore/chord.h"
+#include "libmscore/segment.h"
 
 #include "utils/scorerw.h"
 #include "playback/playbackeventsrenderer.h"
 
+#include "log.h"
+
 using namespace mu::engraving;
 using namespace mu::mpe;
 
@@ -1708,3 +1713,179 @@ TEST_F(PlaybackEventsRendererTests, Two_Chords_Tremolo)
         }
     }
 }
+
+static std::vector<QString> allTestScores()
+{
+    static const std::vector<QString> scores = {
+        "chord_arpeggio/chord_arpeggio.mscx",
+        "chord_arpeggio_bracket/chord_arpeggio_bracket.mscx",
+        "chord_arpeggio_down/chord_arpeggio_down.mscx",
+        "chord_arpeggio_straight_down/chord_arpeggio_straight_down.mscx",
+        "chord_arpeggio_straight_up/chord_arpeggio_straight_up.mscx",
+        "chord_arpeggio_up/chord_arpeggio_up.mscx",
+        "single_chord_tremolo/single_chord_tremolo.mscx",
+        "single_note_acciaccatura/single_note_acciaccatura.mscx",
+        "single_note_appoggiatura_post/single_note_appoggiatura_post.mscx",
+        "single_note_inverted_turn/single_note_inverted_turn.mscx",
+        "single_note_inverted_turn_slash_variation/single_note_inverted_turn_slash_variation.mscx",
+        "single_note_lower_mordent/single_note_lower_mordent.mscx",
+        "single_note_multi_acciaccatura/single_note_multi_acciaccatura.mscx",
+        "single_note_multi_appoggiatura_post/single_note_multi_appoggiatura_post.mscx",
+        "single_note_no_articulations/no_articulations.mscx",
+        "single_note_regular_turn/single_note_regular_turn.mscx",
+        "single_note_tenuto_accent/tenuto_accent.mscx",
+        "single_note_tremolo/single_note_tremolo.mscx",
+        "single_note_trill_baroque/single_note_trill_baroque.mscx",
+        "single_note_trill_default_tempo/single_note_trill_default_tempo.mscx",
+        "single_note_unexpandable_trill/single_note_unexpandable_trill.mscx",
+        "single_note_upper_mordent/single_note_upper_mordent.mscx",
+        "two_chords_tremolo/two_chords_tremolo.mscx",
+        "two_notes_continuous_glissando/two_notes_continuous_glissando.mscx",
+        "two_notes_continuous_glissando_no_play/two_notes_continuous_glissando_no_play.mscx",
+        "two_notes_discrete_glissando/two_notes_discrete_glissando.mscx",
+        "whole_measure_rest/whole_measure_rest.mscx",
+    };
+
+    return scores;
+}
+
+static std::vector<const ChordRest*> allChordRests(const Score* score)
+{
+    std::vector<const ChordRest*> result;
+
+    for (const Segment* segment = score->firstSegment(SegmentType::ChordRest); segment;
+         segment = segment->next1(SegmentType::ChordRest)) {
+        for (const EngravingItem* item : segment->elist()) {
+            if (item && item->isChordRest()) {
+                result.push_back(toChordRest(item));
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief PlaybackEventsRendererTests_PackedEvents_MatchEventsMap
+ * @details Every test score is rendered into the events map, which is then packed,
+ *          the packed events must give exactly the same events back
+ */
+TEST_F(PlaybackEventsRendererTests, PackedEvents_MatchEventsMap)
+{
+    // [GIVEN] Articulations profile with dummy patterns for every articulation
+    for (int type = 0; type < static_cast<int>(ArticulationType::Last); ++type) {
+        m_defaultProfile->setPattern(static_cast<ArticulationType>(type), m_dummyPattern);
+    }
+
+    for (const QString& path : allTestScores()) {
+        Score* score = ScoreRW::readScore(PLAYBACK_EVENTS_RENDERING_DIR + path);
+        ASSERT_TRUE(score);
+
+        // [WHEN] Every chord and rest is rendered and the events are packed
+        PlaybackEventsMap events;
+        for (const ChordRest* chordRest : allChordRests(score)) {
+            m_renderer.render(chordRest, dynamicLevelFromType(mu::mpe::DynamicType::Natural),
+                              ArticulationType::Standard, m_defaultProfile, events);
+        }
+
+        PackedPlaybackEvents packed;
+        packed.load(events);
+
+        // [THEN] The packed events match the events map
+        EXPECT_EQ(packed.toEventsMap(), events) << path.toStdString();
+
+        // [WHEN] A part of the events is replaced with a delta
+        if (!events.empty()) {
+            PlaybackEventsDelta delta = PlaybackEventsDelta::fromRanges(events, { { events.begin()->first, events.begin()->first } });
+            packed.apply(delta);
+
+            // [THEN] Nothing is lost or duplicated
+            EXPECT_EQ(packed.toEventsMap(), events) << path.toStdString();
+        }
+
+        delete score;
+    }
+}
+
+/**
+ * @brief PlaybackEventsRendererTests_Benchmark_PackedEvents
+ * @details Renders the test scores many times (as if they were one long score),
+ *          packs the events and compares the events map with the packed events.
+ *          Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+ */
+TEST_F(PlaybackEventsRendererTests, DISABLED_Benchmark_PackedEvents)
+{
+    // [GIVEN] Articulations profile with dummy patterns for every articulation
+    for (int type = 0; type < static_cast<int>(ArticulationType::Last); ++type) {
+        m_defaultProfile->setPattern(static_cast<ArticulationType>(type), m_dummyPattern);
+    }
+
+    std::vector<Score*> scores;
+    for (const QString& path : allTestScores()) {
+        Score* score = ScoreRW::readScore(PLAYBACK_EVENTS_RENDERING_DIR + path);
+        ASSERT_TRUE(score);
+        scores.push_back(score);
+    }
+
+    constexpr int REPEATS = 200;
+
+    using clock = std::chrono::steady_clock;
+
+    // [WHEN] The scores are rendered into the events map
+    clock::time_point start = clock::now();
+    PlaybackEventsMap events;
+    for (int repeat = 0; repeat < REPEATS; ++repeat) {
+        for (const Score* score : scores) {
+            int offset = repeat * score->endTick().ticks();
+            for (const ChordRest* chordRest : allChordRests(score)) {
+                m_renderer.render(chordRest, offset, dynamicLevelFromType(mu::mpe::DynamicType::Natural),
+                                  ArticulationType::Standard, m_defaultProfile, events);
+            }
+        }
+    }
+    int64_t mapUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    // [WHEN] The events map is packed
+    start = clock::now();
+    PackedPlaybackEvents packed;
+    packed.load(events);
+    int64_t packedUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    // [WHEN] All the note events are read back, as a synthesizer does
+    size_t mapNodes = events.size();
+    size_t eventsCount = 0;
+    start = clock::now();
+    for (const auto& pair : events) {
+        for (const PlaybackEvent& event : pair.second) {
+            ++eventsCount;
+            if (std::holds_alternative<NoteEvent>(event)) {
+                const NoteEvent& noteEvent = std::get<NoteEvent>(event);
+                mapNodes += noteEvent.expressionCtx().articulations.size()
+                            + noteEvent.pitchCtx().pitchCurve.size()
+                            + noteEvent.expressionCtx().expressionCurve.size();
+            }
+        }
+    }
+    int64_t mapReadUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    start = clock::now();
+    size_t packedNotes = 0;
+    for (const PackedPlaybackEvents::Event& event : packed.events()) {
+        packedNotes += event.isRest ? 0 : 1;
+    }
+    int64_t packedReadUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    LOGI() << eventsCount << " events: render to map " << mapUs << " us, pack " << packedUs << " us; "
+           << "read map " << mapReadUs << " us, packed " << packedReadUs << " us";
+    LOGI() << "map: ~" << mapNodes << " heap nodes (keys, articulations and curve points of every note); "
+           << "packed: " << packed.size() * sizeof(PackedPlaybackEvents::Event) << " bytes flat, "
+           << packed.articulationsCount() << " articulations, " << packed.curvesCount() << " curves";
+
+    // [THEN] Both have the same events
+    EXPECT_EQ(packed.size(), eventsCount);
+    EXPECT_LE(packedNotes, eventsCount);
+
+    for (Score* score : scores) {
+        delete score;
+    }
+}
@@ -22,6 +22,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <chrono>
 #include <memory>
 
 #include "async/channel.h"
@@ -33,9 +34,12 @@
 #include "libmscore/part.h"
 #include "libmscore/measure.h"
 #include "libmscore/chord.h"
+#include "libmscore/score.h"
 
 #include "playback/playbackmodel.h"
 
+#include "log.h"
+
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::_;
@@ -397,8 +401,8 @@ TEST_F(PlaybackModelTests, SimpleRepeat_Changes_Notification)
     // [GIVEN] The articulation profiles repository will be returning profiles for StringsArticulation family
     ON_CALL(*m_repositoryMock, defaultProfile(ArticulationFamily::Strings)).WillByDefault(Return(m_defaultProfile));
 
-    // [GIVEN] Expected amount of changed events
-    int expectedChangedEventsCount = 24;
+    // [GIVEN] Expected amount of events after the change
+    int expectedEventsCount = 24;
 
     // [GIVEN] The playback model requested to be loaded
     PlaybackModel model;
@@ -407,9 +411,20 @@ TEST_F(PlaybackModelTests, SimpleRepeat_Changes_Notification)
 
     PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString());
 
-    // [THEN] Updated events map will match our expectations
-    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsMap& updatedEvents) {
-        EXPECT_EQ(updatedEvents.size(), expectedChangedEventsCount);
+    // [THEN] Only the changed ranges are sent, and applying them gives the updated events map
+    bool received = false;
+    result.mainStream.onReceive(this, [&](const PlaybackEventsDelta& delta) {
+        size_t changedEventsCount = 0;
+        for (const PlaybackEventsRange& range : delta.ranges) {
+            changedEventsCount += range.events.size();
+        }
+        EXPECT_FALSE(delta.empty());
+        EXPECT_LT(changedEventsCount, expectedEventsCount);
+
+        delta.apply(result.originEvents);
+        EXPECT_EQ(result.originEvents.size(), expectedEventsCount);
+        EXPECT_EQ(result.originEvents, model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString()).originEvents);
+        received = true;
     });
 
     // [WHEN] Notation has been changed on the 2-nd measure
@@ -421,6 +436,159 @@ TEST_F(PlaybackModelTests, SimpleRepeat_Changes_Notification)
     range.changedTypes = { ElementType::NOTE };
 
     score->changesChannel().send(range);
+
+    EXPECT_TRUE(received);
+}
+
+/**
+ * @brief PlaybackModelTests_Benchmark_EditLatency
+ * @details Measures the time from a change notification on a single measure of a large score
+ *          until the audio side has the updated events, comparing the delta with sending the whole track
+ *          Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+ */
+TEST_F(PlaybackModelTests, DISABLED_Benchmark_EditLatency)
+{
+    // [GIVEN] A large piano score
+    Score* score = ScoreRW::readScore("all_elements_data/moonlight.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->parts().empty());
+
+    const Part* part = score->parts().at(0);
+
+    ON_CALL(*m_repositoryMock, defaultProfile(_)).WillByDefault(Return(m_defaultProfile));
+
+    // [GIVEN] The playback model requested to be loaded, the audio side has a copy of the events
+    PlaybackModel model;
+    model.setprofilesRepository(m_repositoryMock);
+    model.load(score);
+
+    PlaybackData audioSide = model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString());
+    ASSERT_FALSE(audioSide.originEvents.empty());
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point end;
+
+    audioSide.mainStream.onReceive(this, [&audioSide, &end](const PlaybackEventsDelta& delta) {
+        delta.apply(audioSide.originEvents);
+        end = clock::now();
+    });
+
+    // [WHEN] A measure in the middle of the score has been changed
+    const Measure* measure = score->tick2measure(score->lastMeasure()->tick() / 2);
+    ASSERT_TRUE(measure);
+
+    ScoreChangesRange range;
+    range.tickFrom = measure->tick().ticks();
+    range.tickTo = measure->endTick().ticks();
+    range.staffIdxFrom = part->startTrack() / VOICES;
+    range.staffIdxTo = part->endTrack() / VOICES - 1;
+    range.changedTypes = { ElementType::NOTE };
+
+    clock::time_point start = clock::now();
+    score->changesChannel().send(range);
+    int64_t deltaUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    const PlaybackEventsMap& modelEvents = model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString()).originEvents;
+
+    // [WHEN] The whole track is sent instead, as it was before
+    start = clock::now();
+    PlaybackEventsMap fullCopy = modelEvents;
+    PlaybackEventsDelta::full(fullCopy).apply(audioSide.originEvents);
+    int64_t fullUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    LOGI() << "edit of 1 measure, " << modelEvents.size() << " event timestamps: delta " << deltaUs << " us, whole track " << fullUs << " us";
+
+    // [THEN] The audio side has the same events as the model
+    EXPECT_EQ(audioSide.originEvents, modelEvents);
+
+    delete score;
+}
+
+/**
+ * @brief PlaybackModelTests_Parallel_Rendering_SameAsSerial
+ * @details The tracks of a score with 12 instruments are rendered on several threads,
+ *          the events of every track must be the same as the ones rendered on a single thread
+ */
+TEST_F(PlaybackModelTests, Parallel_Rendering_SameAsSerial)
+{
+    // [GIVEN] Score with 12 instruments
+    Score* score = ScoreRW::readScore(
+        PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 12);
+
+    ON_CALL(*m_repositoryMock, defaultProfile(_)).WillByDefault(Return(m_defaultProfile));
+
+    // [WHEN] The playback model is loaded on a single thread
+    MScore::playbackThreads = 1;
+
+    PlaybackModel serialModel;
+    serialModel.setprofilesRepository(m_repositoryMock);
+    serialModel.load(score);
+
+    // [WHEN] The playback model is loaded on several threads
+    MScore::playbackThreads = 4;
+
+    PlaybackModel parallelModel;
+    parallelModel.setprofilesRepository(m_repositoryMock);
+    parallelModel.load(score);
+
+    MScore::playbackThreads = 0;
+
+    // [THEN] The events of every track are the same
+    for (const Part* part : score->parts()) {
+        for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
+            const PlaybackEventsMap& expected = serialModel.resolveTrackPlaybackData(trackId).originEvents;
+
+            EXPECT_FALSE(expected.empty());
+            EXPECT_EQ(parallelModel.resolveTrackPlaybackData(trackId).originEvents, expected);
+        }
+    }
+
+    EXPECT_EQ(parallelModel.resolveTrackPlaybackData(parallelModel.metronomeTrackId()).originEvents,
+              serialModel.resolveTrackPlaybackData(serialModel.metronomeTrackId()).originEvents);
+
+    delete score;
+}
+
+/**
+ * @brief PlaybackModelTests_Benchmark_Load
+ * @details Measures the time the playback model takes to render all the tracks of a score
+ *          on a single thread and on as many threads as cores
+ *          Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+ */
+TEST_F(PlaybackModelTests, DISABLED_Benchmark_Load)
+{
+    // [GIVEN] Score with 12 instruments
+    Score* score = ScoreRW::readScore(
+        PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+
+    ON_CALL(*m_repositoryMock, defaultProfile(_)).WillByDefault(Return(m_defaultProfile));
+
+    using clock = std::chrono::steady_clock;
+
+    auto loadTime = [this, score](int threads) {
+        MScore::playbackThreads = threads;
+
+        PlaybackModel model;
+        model.setprofilesRepository(m_repositoryMock);
+
+        clock::time_point start = clock::now();
+        model.load(score);
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+    };
+
+    // [WHEN] The playback model is loaded on a single thread and on as many threads as cores
+    int64_t serialUs = loadTime(1);
+    int64_t parallelUs = loadTime(0);
+
+    LOGI() << "load of " << score->parts().size() << " parts: serial " << serialUs << " us, parallel " << parallelUs << " us";
+
+    delete score;
 }
 
 /**
@@ -0,0 +1,127 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+#include "libmscore/factory.h"
+#include "libmscore/layoutbreak.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+static const QString MEASURE_DATA_DIR("measure_data/");
+static constexpr int LARGE_SCORE_MEASURES = 400;
+
+using namespace mu::engraving;
+
+class RangeLayoutTests : public ::testing::Test
+{
+protected:
+    //! NOTE First tick, last tick and page of every system
+    using SystemsLayout = std::vector<std::tuple<int, int, size_t> >;
+
+    static SystemsLayout systemsLayout(const Score* score)
+    {
+        SystemsLayout result;
+        for (const System* system : score->systems()) {
+            result.emplace_back(system->measures().front()->tick().ticks(),
+                                system->measures().back()->tick().ticks(),
+                                score->pageIdx(system->page()));
+        }
+        return result;
+    }
+
+    static MasterScore* readLargeScore()
+    {
+        MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+        if (!score) {
+            return nullptr;
+        }
+
+        score->startCmd();
+        score->appendMeasures(LARGE_SCORE_MEASURES - static_cast<int>(score->nmeasures()));
+        score->endCmd();
+
+        return score;
+    }
+
+    static void addLineBreak(Score* score, Measure* measure)
+    {
+        LayoutBreak* lb = Factory::createLayoutBreak(measure);
+        lb->setLayoutBreakType(LayoutBreakType::LINE);
+        lb->setTrack(mu::nidx);
+        lb->setParent(measure);
+
+        score->startCmd();
+        score->undoAddElement(lb);
+        score->endCmd();
+    }
+};
+
+TEST_F(RangeLayoutTests, LineBreak_RelayoutStopsWhenSystemsConverge)
+{
+    //! GIVEN A large score with a forced line break at the end of a system in the middle
+    MasterScore* score = readLargeScore();
+    ASSERT_TRUE(score);
+
+    size_t systemIdx = score->systems().size() / 2;
+    const System* system = score->systems().at(systemIdx);
+    ASSERT_GE(system->measures().size(), 3);
+    ASSERT_TRUE(system->measures().front()->isMeasure());
+
+    Measure* nextSystemEnd = toMeasure(score->systems().at(systemIdx + 1)->measures().back());
+    addLineBreak(score, nextSystemEnd);
+
+    //! DO Split the system in the middle with another line break, which adds a system
+    size_t systemsCount = score->systems().size();
+    addLineBreak(score, toMeasure(system->measures().front())->nextMeasure());
+
+    //! CHECK The layout stopped at the forced break and took over the following systems
+    const LayoutStatistics& stats = score->layoutStatistics();
+    EXPECT_FALSE(stats.layoutAll);
+    EXPECT_LT(stats.layoutedMeasures, size_t(LARGE_SCORE_MEASURES / 4));
+    EXPECT_GT(stats.reusedSystems, 0);
+    EXPECT_EQ(score->systems().size(), systemsCount + 1);
+
+    //! CHECK The systems are the same as after a full layout
+    SystemsLayout ranged = systemsLayout(score);
+    score->doLayout();
+    EXPECT_EQ(ranged, systemsLayout(score));
+
+    //! DO Undo the split
+    score->undoRedo(true, 0);
+
+    //! CHECK The layout converges again, with one system less
+    EXPECT_LT(score->layoutStatistics().layoutedMeasures, size_t(LARGE_SCORE_MEASURES / 4));
+    EXPECT_EQ(score->systems().size(), systemsCount);
+
+    ranged = systemsLayout(score);
+    score->doLayout();
+    EXPECT_EQ(ranged, systemsLayout(score));
+
+    delete score;
+}
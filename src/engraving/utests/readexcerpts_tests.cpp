@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "io/buffer.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/compat/writescorehook.h"
+#include "engraving/infrastructure/io/localfileinfoprovider.h"
+#include "engraving/infrastructure/io/mscreader.h"
+#include "engraving/infrastructure/io/mscwriter.h"
+#include "engraving/libmscore/excerpt.h"
+#include "engraving/libmscore/masterscore.h"
+#include "engraving/rw/scorereader.h"
+
+#include "utils/scorerw.h"
+
+static const QString IMPLODE_EXPLODE_DATA_DIR("implode_explode_data/");
+
+using namespace mu;
+using namespace mu::io;
+using namespace mu::engraving;
+
+class ReadExcerptsTests : public ::testing::Test
+{
+protected:
+    static QString fileName(MscIoMode mode)
+    {
+        return mode == MscIoMode::Zip ? "parts.mscz" : "parts.mscx";
+    }
+
+    static ByteArray write(MasterScore* score, MscIoMode mode)
+    {
+        ByteArray data;
+        Buffer buf(&data);
+
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = fileName(mode);
+        params.mode = mode;
+
+        MscWriter writer(params);
+        EXPECT_TRUE(writer.open());
+        EXPECT_TRUE(score->writeMscz(writer, false, false));
+        writer.close();
+
+        return data;
+    }
+
+    static MasterScore* read(ByteArray& data, MscIoMode mode)
+    {
+        MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(fileName(mode)));
+
+        Buffer buf(&data);
+
+        MscReader::Params params;
+        params.device = &buf;
+        params.filePath = fileName(mode);
+        params.mode = mode;
+
+        MscReader reader(params);
+        EXPECT_TRUE(reader.open());
+
+        ScoreLoad sl;
+        ScoreReader scoreReader;
+        EXPECT_EQ(scoreReader.loadMscz(score, reader, false), Err::NoError);
+
+        return score;
+    }
+
+    static std::vector<ByteArray> partsData(MasterScore* score)
+    {
+        std::vector<ByteArray> result;
+        for (const Excerpt* excerpt : score->excerpts()) {
+            excerpt->excerptScore()->ensureLayout();
+
+            ByteArray data;
+            Buffer buf(&data);
+            buf.open(IODevice::WriteOnly);
+
+            compat::WriteScoreHook hook;
+            excerpt->excerptScore()->writeScore(&buf, false, false, hook);
+            result.push_back(data);
+        }
+        return result;
+    }
+};
+
+TEST_F(ReadExcerptsTests, MsczAndMscx_SameAsSerial)
+{
+    //! GIVEN A score with several parts, saved as .mscz and as .mscx
+    MasterScore* score = ScoreRW::readScore(IMPLODE_EXPLODE_DATA_DIR + "explode1.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_GT(score->excerpts().size(), size_t(1));
+
+    ByteArray msczData = write(score, MscIoMode::Zip);
+    ByteArray mscxData = write(score, MscIoMode::XmlFile);
+    delete score;
+
+    //! DO Read them back: the excerpts of the .mscz are read concurrently, the ones of the .mscx one by one
+    MasterScore* fromMscz = read(msczData, MscIoMode::Zip);
+    MasterScore* fromMscx = read(mscxData, MscIoMode::XmlFile);
+
+    //! CHECK The parts are the same
+    std::vector<ByteArray> msczParts = partsData(fromMscz);
+    std::vector<ByteArray> mscxParts = partsData(fromMscx);
+
+    ASSERT_GT(msczParts.size(), size_t(1));
+    ASSERT_EQ(msczParts.size(), mscxParts.size());
+    for (size_t i = 0; i < msczParts.size(); ++i) {
+        EXPECT_FALSE(msczParts[i].empty());
+        EXPECT_TRUE(msczParts[i] == mscxParts[i]) << "part " << i;
+    }
+
+    delete fromMscz;
+    delete fromMscx;
+}
+
+TEST_F(ReadExcerptsTests, Parts_NotLaidOutUntilNeeded)
+{
+    //! GIVEN A project with several parts
+    MasterScore* score = ScoreRW::readScore(IMPLODE_EXPLODE_DATA_DIR + "explode1.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_GT(score->excerpts().size(), size_t(1));
+
+    ByteArray data = write(score, MscIoMode::Zip);
+    delete score;
+
+    //! DO Load it, lay out the master score and open the parts, as loading the project does
+    MasterScore* loaded = read(data, MscIoMode::Zip);
+    loaded->doLayout();
+
+    for (Excerpt* excerpt : loaded->excerpts()) {
+        excerpt->excerptScore()->setIsOpen(true);
+    }
+
+    //! CHECK The parts have no pages yet
+    for (const Excerpt* excerpt : loaded->excerpts()) {
+        EXPECT_TRUE(excerpt->excerptScore()->isLayoutDeferred());
+        EXPECT_TRUE(excerpt->excerptScore()->pages().empty());
+    }
+
+    //! DO Edit the master score
+    loaded->startCmd();
+    loaded->setLayoutAll();
+    loaded->endCmd();
+
+    //! CHECK The parts are still not laid out
+    for (const Excerpt* excerpt : loaded->excerpts()) {
+        EXPECT_TRUE(excerpt->excerptScore()->pages().empty());
+    }
+
+    //! DO Access the pages of the first part
+    Score* first = loaded->excerpts().front()->excerptScore();
+    first->ensureLayout();
+
+    //! CHECK Only that part is laid out
+    EXPECT_FALSE(first->isLayoutDeferred());
+    EXPECT_FALSE(first->pages().empty());
+    for (size_t i = 1; i < loaded->excerpts().size(); ++i) {
+        EXPECT_TRUE(loaded->excerpts().at(i)->excerptScore()->pages().empty());
+    }
+
+    delete loaded;
+}
@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "concurrency/concurrency.h"
+
+#include "infrastructure/draw/bufferedpaintprovider.h"
+#include "infrastructure/draw/painter.h"
+#include "infrastructure/draw/utils/drawcomp.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/mscore.h"
+#include "libmscore/page.h"
+#include "paint/paint.h"
+
+#include "utils/scorerw.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu;
+using namespace mu::engraving;
+
+class RenderContextTests : public ::testing::Test
+{
+protected:
+    static draw::DrawDataPtr drawPage(Page* page)
+    {
+        RenderContext context;
+        context.pixelRatio = DPI / 300.0;
+        context.printing = true;
+        context.pdfPrinting = true;
+        RenderContext::Scope scope(context);
+
+        auto provider = std::make_shared<draw::BufferedPaintProvider>();
+        {
+            draw::Painter painter(provider, "page");
+            Paint::paintElements(painter, page->items(page->bbox()), true);
+            painter.endDraw();
+        }
+
+        return std::make_shared<draw::DrawData>(provider->drawData());
+    }
+};
+
+TEST_F(RenderContextTests, Scope)
+{
+    //! GIVEN The default context
+    const RenderContext defaultContext = RenderContext::current();
+    EXPECT_FALSE(defaultContext.printing);
+
+    {
+        //! DO Make a printing context current
+        RenderContext printContext;
+        printContext.pixelRatio = 2.0;
+        printContext.printing = true;
+        RenderContext::Scope printScope(printContext);
+
+        //! CHECK It is current for this thread only
+        EXPECT_TRUE(RenderContext::current().printing);
+        EXPECT_DOUBLE_EQ(RenderContext::current().pixelRatio, 2.0);
+
+        bool otherThreadPrinting = true;
+        std::thread([&otherThreadPrinting]() {
+            otherThreadPrinting = RenderContext::current().printing;
+        }).join();
+        EXPECT_FALSE(otherThreadPrinting);
+
+        {
+            //! DO Nest a context
+            RenderContext innerContext = RenderContext::current();
+            innerContext.pixelRatio = 3.0;
+            RenderContext::Scope innerScope(innerContext);
+
+            EXPECT_TRUE(RenderContext::current().printing);
+            EXPECT_DOUBLE_EQ(RenderContext::current().pixelRatio, 3.0);
+        }
+
+        //! CHECK The outer context is restored
+        EXPECT_DOUBLE_EQ(RenderContext::current().pixelRatio, 2.0);
+    }
+
+    //! CHECK The default context is restored
+    EXPECT_FALSE(RenderContext::current().printing);
+    EXPECT_DOUBLE_EQ(RenderContext::current().pixelRatio, defaultContext.pixelRatio);
+}
+
+TEST_F(RenderContextTests, DrawPagesConcurrently)
+{
+    //! GIVEN A laid out score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    const std::vector<Page*>& pages = score->pages();
+    ASSERT_FALSE(pages.empty());
+
+    for (Page* page : pages) {
+        page->ensureBspTree();
+    }
+
+    //! DO Draw the pages one by one and then all of them concurrently
+    std::vector<draw::DrawDataPtr> sequential;
+    for (Page* page : pages) {
+        sequential.push_back(drawPage(page));
+    }
+
+    std::vector<draw::DrawDataPtr> concurrent(pages.size());
+    concurrency::parallelFor(pages.size(), pages.size(), [&pages, &concurrent](size_t i) {
+        concurrent[i] = drawPage(pages[i]);
+    });
+
+    //! CHECK The drawings are the same
+    for (size_t i = 0; i < pages.size(); ++i) {
+        EXPECT_FALSE(sequential[i]->objects.empty());
+        EXPECT_TRUE(draw::DrawComp::compare(concurrent[i], sequential[i]).empty());
+    }
+
+    delete score;
+}
@@ -0,0 +1,151 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "compat/midi/event.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/mscore.h"
+#include "libmscore/synthesizerstate.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+static const QString CHORDSYMBOL_DATA_DIR("chordsymbol_data/");
+static const QString UNROLLREPEATS_DATA_DIR("unrollrepeats_data/");
+
+static constexpr int BENCHMARK_REPEAT_COUNT = 20;
+
+using namespace mu::engraving;
+
+class RenderMidiTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        MScore::midiRenderThreads = 1;
+    }
+
+    static EventMap renderWithThreads(Score* score, int threads)
+    {
+        MScore::midiRenderThreads = threads;
+
+        EventMap events;
+        score->renderMidi(&events, true, true, SynthesizerState());
+        return events;
+    }
+
+    static void checkSameEvents(const EventMap& serial, const EventMap& parallel)
+    {
+        ASSERT_EQ(serial.size(), parallel.size());
+
+        auto it = parallel.cbegin();
+        for (const auto& pair : serial) {
+            const NPlayEvent& expected = pair.second;
+            const NPlayEvent& actual = it->second;
+
+            EXPECT_EQ(it->first, pair.first);
+            EXPECT_TRUE(actual == expected);
+            EXPECT_EQ(actual.getOriginatingStaff(), expected.getOriginatingStaff());
+            EXPECT_EQ(actual.discard(), expected.discard());
+            EXPECT_EQ(actual.note(), expected.note());
+            EXPECT_EQ(actual.harmony(), expected.harmony());
+            EXPECT_EQ(actual.tuning(), expected.tuning());
+
+            ++it;
+        }
+    }
+
+    static void checkSameAsSerialRendering(const QString& path)
+    {
+        //! GIVEN A score
+        MasterScore* score = ScoreRW::readScore(path);
+        ASSERT_TRUE(score);
+
+        //! DO Render it on one thread and on several threads
+        EventMap serial = renderWithThreads(score, 1);
+        EventMap parallel = renderWithThreads(score, 4);
+
+        //! CHECK The events and their order are the same
+        EXPECT_FALSE(serial.empty());
+        checkSameEvents(serial, parallel);
+
+        delete score;
+    }
+};
+
+TEST_F(RenderMidiTests, ParallelSameAsSerial_Dynamics)
+{
+    checkSameAsSerialRendering(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+}
+
+TEST_F(RenderMidiTests, ParallelSameAsSerial_Repeats)
+{
+    checkSameAsSerialRendering(UNROLLREPEATS_DATA_DIR + "clef-key-ts-test.mscx");
+}
+
+TEST_F(RenderMidiTests, ParallelSameAsSerial_ChordSymbols)
+{
+    checkSameAsSerialRendering(CHORDSYMBOL_DATA_DIR + "realize.mscx");
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(RenderMidiTests, DISABLED_Benchmark_RenderRepeats)
+{
+    //! GIVEN A large score: the whole piece is repeated several times
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Measure* last = score->lastMeasure();
+    score->startCmd();
+    last->undoChangeProperty(Pid::REPEAT_END, true);
+    last->undoChangeProperty(Pid::REPEAT_COUNT, BENCHMARK_REPEAT_COUNT);
+    score->endCmd();
+    score->setPlaylistDirty();
+
+    using clock = std::chrono::steady_clock;
+
+    auto renderTime = [score](int threads, size_t& eventsCount) {
+        clock::time_point start = clock::now();
+        eventsCount = renderWithThreads(score, threads).size();
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+    };
+
+    //! DO Render it with the repeats expanded on one thread and on as many threads as cores
+    size_t serialEvents = 0;
+    size_t parallelEvents = 0;
+    int64_t serialUs = renderTime(1, serialEvents);
+    int64_t parallelUs = renderTime(0, parallelEvents);
+
+    LOGI() << "rendering of " << score->nmeasures() << " measures repeated " << BENCHMARK_REPEAT_COUNT << " times: serial "
+           << serialUs << " us, parallel " << parallelUs << " us";
+
+    //! CHECK The same events were rendered
+    EXPECT_EQ(parallelEvents, serialEvents);
+
+    delete score;
+}
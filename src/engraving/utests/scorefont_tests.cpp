@@ -0,0 +1,137 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "libmscore/scorefont.h"
+
+#include "mocks/engravingconfigurationmock.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class ScoreFontTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_cacheDir.isValid());
+
+        m_configuration = std::make_shared< ::testing::NiceMock<EngravingConfigurationMock> >();
+        ON_CALL(*m_configuration, scoreFontsCachePath()).WillByDefault(::testing::Return(m_cacheDir.path()));
+
+        m_previousConfiguration = ScoreFont::engravingConfiguration();
+        ScoreFont::setengravingConfiguration(m_configuration);
+    }
+
+    void TearDown() override
+    {
+        ScoreFont::setengravingConfiguration(m_previousConfiguration);
+    }
+
+    static void checkSameMetrics(ScoreFont& font, ScoreFont& expected)
+    {
+        for (size_t i = 0; i < static_cast<size_t>(SymId::lastSym); ++i) {
+            SymId id = static_cast<SymId>(i);
+            ASSERT_EQ(font.isValid(id), expected.isValid(id));
+            ASSERT_EQ(font.symCode(id), expected.symCode(id));
+            ASSERT_EQ(font.bbox(id, 1.0), expected.bbox(id, 1.0));
+            ASSERT_EQ(font.advance(id, 1.0), expected.advance(id, 1.0));
+
+            for (SmuflAnchorId anchor : { SmuflAnchorId::stemDownNW, SmuflAnchorId::stemUpSE, SmuflAnchorId::stemDownSW,
+                                          SmuflAnchorId::stemUpNW, SmuflAnchorId::cutOutNE, SmuflAnchorId::cutOutNW,
+                                          SmuflAnchorId::cutOutSE, SmuflAnchorId::cutOutSW, SmuflAnchorId::opticalCenter }) {
+                ASSERT_EQ(font.smuflAnchor(id, anchor, 1.0), expected.smuflAnchor(id, anchor, 1.0));
+            }
+        }
+
+        EXPECT_EQ(font.engravingDefaults(), expected.engravingDefaults());
+        EXPECT_EQ(font.textEnclosureThickness(), expected.textEnclosureThickness());
+    }
+
+    QTemporaryDir m_cacheDir;
+    std::shared_ptr<EngravingConfigurationMock> m_configuration;
+    std::shared_ptr<IEngravingConfiguration> m_previousConfiguration;
+};
+
+TEST_F(ScoreFontTests, CachedMetricsSameAsComputed)
+{
+    //! GIVEN A font loaded without the cache, which writes the cache
+    ScoreFont computed("Bravura", "Bravura", ":/fonts/bravura/", "Bravura.otf");
+    computed.ensureLoaded();
+    ASSERT_FALSE(QDir(m_cacheDir.path()).isEmpty());
+
+    //! DO Load the same font again
+    ScoreFont cached("Bravura", "Bravura", ":/fonts/bravura/", "Bravura.otf");
+    cached.ensureLoaded();
+
+    //! CHECK The metrics read from the cache are the same as the computed ones
+    checkSameMetrics(cached, computed);
+}
+
+TEST_F(ScoreFontTests, CorruptedCacheIgnored)
+{
+    //! GIVEN A cache, that is cut off
+    ScoreFont computed("Leland", "Leland", ":/fonts/leland/", "Leland.otf");
+    computed.ensureLoaded();
+
+    for (const QFileInfo& info : QDir(m_cacheDir.path()).entryInfoList(QDir::Files)) {
+        QFile file(info.absoluteFilePath());
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.resize(file.size() / 2));
+    }
+
+    //! DO Load the font again
+    ScoreFont loaded("Leland", "Leland", ":/fonts/leland/", "Leland.otf");
+    loaded.ensureLoaded();
+
+    //! CHECK The metrics are computed again
+    checkSameMetrics(loaded, computed);
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(ScoreFontTests, DISABLED_Benchmark_Load)
+{
+    //! DO Load the font without and with the cache
+    auto start = std::chrono::high_resolution_clock::now();
+    ScoreFont computed("Bravura", "Bravura", ":/fonts/bravura/", "Bravura.otf");
+    computed.ensureLoaded();
+    auto computedEnd = std::chrono::high_resolution_clock::now();
+
+    ScoreFont cached("Bravura", "Bravura", ":/fonts/bravura/", "Bravura.otf");
+    cached.ensureLoaded();
+    auto cachedEnd = std::chrono::high_resolution_clock::now();
+
+    LOGI() << "load Bravura without cache: " << std::chrono::duration_cast<std::chrono::milliseconds>(computedEnd - start).count()
+           << " ms, with cache: " << std::chrono::duration_cast<std::chrono::milliseconds>(cachedEnd - computedEnd).count() << " ms";
+
+    //! CHECK
+    EXPECT_TRUE(cached.isValid(SymId::noteheadBlack));
+}
@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu::engraving;
+
+class ShapeTests : public ::testing::Test
+{
+protected:
+    struct ShapePair {
+        Shape left;
+        Shape right;
+    };
+
+    //! NOTE The nested loop over all element pairs, that minHorizontalDistance used before the sweep
+    static qreal referenceMinHorizontalDistance(const Shape& s1, const Shape& s2, const Score* score)
+    {
+        qreal dist = -1000000.0;
+        double verticalClearance = 0.2 * score->spatium();
+        for (const ShapeElement& r2 : s2) {
+            const EngravingItem* item2 = r2.toItem;
+            for (const ShapeElement& r1 : s1) {
+                const EngravingItem* item1 = r1.toItem;
+                bool intersection = intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom(), verticalClearance);
+                double padding = 0;
+                KerningType kerningType = KerningType::NON_KERNING;
+                if (item1 && item2) {
+                    padding = item1->computePadding(item2);
+                    kerningType = item1->computeKerningType(item2);
+                }
+                if (intersection
+                    || (r1.width() == 0 || r2.width() == 0)
+                    || (!item1 && item2 && item2->isLyrics())
+                    || kerningType == KerningType::NON_KERNING) {
+                    dist = qMax(dist, r1.right() - r2.left() + padding);
+                }
+                if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) {
+                    dist = qMax(dist, r1.left() - r2.left());
+                }
+            }
+        }
+        return dist;
+    }
+
+    //! NOTE Pairs of segment shapes of every measure, per staff and for all staves together
+    static std::vector<ShapePair> collectShapePairs(const Score* score)
+    {
+        std::vector<ShapePair> pairs;
+        for (const Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            const System* system = m->system();
+            if (!system) {
+                continue;
+            }
+
+            std::vector<Shape> systemShapes;
+            for (const Segment* s = m->first(); s; s = s->next()) {
+                Shape systemShape;
+                for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                    systemShape.add(s->staffShape(staffIdx).translated(mu::PointF(0.0, system->staff(staffIdx)->y())));
+                    for (const Segment* ns = s->next(); ns; ns = ns->next()) {
+                        pairs.push_back({ s->staffShape(staffIdx), ns->staffShape(staffIdx) });
+                    }
+                }
+                systemShapes.push_back(systemShape);
+            }
+
+            for (size_t i = 0; i < systemShapes.size(); ++i) {
+                for (size_t j = i + 1; j < systemShapes.size(); ++j) {
+                    pairs.push_back({ systemShapes[i], systemShapes[j] });
+                }
+            }
+        }
+        return pairs;
+    }
+
+    static void checkSameAsReference(const QString& file)
+    {
+        //! GIVEN A laid out score
+        MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+        ASSERT_TRUE(score);
+
+        std::vector<ShapePair> pairs = collectShapePairs(score);
+        ASSERT_FALSE(pairs.empty());
+
+        //! DO Compute the distances of all segment shape pairs
+        //! CHECK They are exactly the ones of the nested loop
+        for (const ShapePair& pair : pairs) {
+            ASSERT_EQ(pair.left.minHorizontalDistance(pair.right, score),
+                      referenceMinHorizontalDistance(pair.left, pair.right, score));
+        }
+
+        delete score;
+    }
+};
+
+TEST_F(ShapeTests, MinHorizontalDistance_LayoutElements)
+{
+    checkSameAsReference("layout_elements.mscx");
+}
+
+TEST_F(ShapeTests, MinHorizontalDistance_LayoutElementsTab)
+{
+    checkSameAsReference("layout_elements_tab.mscx");
+}
+
+TEST_F(ShapeTests, MinHorizontalDistance_Moonlight)
+{
+    checkSameAsReference("moonlight.mscx");
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(ShapeTests, DISABLED_Benchmark_MinHorizontalDistance)
+{
+    //! GIVEN The segment shape pairs of the layout test scores
+    using clock = std::chrono::steady_clock;
+    int64_t referenceUs = 0;
+    int64_t sweepUs = 0;
+    size_t pairCount = 0;
+    size_t mismatches = 0;
+
+    for (const QString& file : { "layout_elements.mscx", "layout_elements_tab.mscx", "moonlight.mscx" }) {
+        MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+        ASSERT_TRUE(score);
+
+        std::vector<ShapePair> pairs = collectShapePairs(score);
+        pairCount += pairs.size();
+
+        std::vector<qreal> referenceDistances(pairs.size());
+        std::vector<qreal> sweepDistances(pairs.size());
+
+        //! DO Measure the nested loop and the sweep
+        clock::time_point start = clock::now();
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            referenceDistances[i] = referenceMinHorizontalDistance(pairs[i].left, pairs[i].right, score);
+        }
+        referenceUs += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+        start = clock::now();
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            sweepDistances[i] = pairs[i].left.minHorizontalDistance(pairs[i].right, score);
+        }
+        sweepUs += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            mismatches += referenceDistances[i] == sweepDistances[i] ? 0 : 1;
+        }
+
+        delete score;
+    }
+
+    LOGI() << pairCount << " shape pairs: nested loop " << referenceUs << " us, sweep " << sweepUs << " us";
+
+    //! CHECK Both give the same distances
+    EXPECT_EQ(mismatches, size_t(0));
+}
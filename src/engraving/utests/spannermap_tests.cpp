@@ -0,0 +1,279 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "libmscore/factory.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/slur.h"
+#include "libmscore/spannermap.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+static const QString MEASURE_DATA_DIR("measure_data/");
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu::engraving;
+
+class SpannerMapTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_score = ScoreRW::readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+        ASSERT_TRUE(m_score);
+    }
+
+    void TearDown() override
+    {
+        for (Spanner* s : m_spanners) {
+            m_score->spannerMap().removeSpanner(s);
+            delete s;
+        }
+        delete m_score;
+    }
+
+    Spanner* addSpanner(int tick, int ticks)
+    {
+        Slur* slur = Factory::createSlur(m_score->dummy());
+        slur->setTick(Fraction::fromTicks(tick));
+        slur->setTicks(Fraction::fromTicks(ticks));
+        m_score->spannerMap().addSpanner(slur);
+        m_spanners.push_back(slur);
+        return slur;
+    }
+
+    void removeSpanner(size_t idx)
+    {
+        Spanner* s = m_spanners.at(idx);
+        EXPECT_TRUE(m_score->spannerMap().removeSpanner(s));
+        m_spanners.erase(m_spanners.begin() + idx);
+        delete s;
+    }
+
+    static std::vector<Spanner*> spanners(const std::vector<interval_tree::Interval<Spanner*> >& intervals)
+    {
+        std::vector<Spanner*> result;
+        for (const auto& interval : intervals) {
+            result.push_back(interval.value);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    //! NOTE The same conditions as the interval tree uses, checked against every spanner
+    void checkSameAsScan(int start, int stop) const
+    {
+        std::vector<Spanner*> overlapping;
+        std::vector<Spanner*> contained;
+        for (Spanner* s : m_spanners) {
+            const int sStart = s->tick().ticks();
+            const int sStop = s->tick2().ticks();
+            if (sStop >= start && sStart <= stop) {
+                overlapping.push_back(s);
+            }
+            if (sStart >= start && sStop <= stop) {
+                contained.push_back(s);
+            }
+        }
+        std::sort(overlapping.begin(), overlapping.end());
+        std::sort(contained.begin(), contained.end());
+
+        ASSERT_EQ(spanners(m_score->spannerMap().findOverlapping(start, stop)), overlapping);
+        ASSERT_EQ(spanners(m_score->spannerMap().findContained(start, stop)), contained);
+    }
+
+    //! NOTE The spanner segments of every system in their order, with their positions and sizes
+    static std::vector<std::pair<const Spanner*, mu::RectF> > spannerSegmentsLayout(const Score* score)
+    {
+        std::vector<std::pair<const Spanner*, mu::RectF> > result;
+        for (const System* system : score->systems()) {
+            for (const SpannerSegment* ss : system->spannerSegments()) {
+                result.push_back({ ss->spanner(), ss->pageBoundingRect() });
+            }
+        }
+        return result;
+    }
+
+    MasterScore* m_score = nullptr;
+    std::vector<Spanner*> m_spanners;
+};
+
+TEST_F(SpannerMapTests, FindAfterEdits)
+{
+    //! GIVEN Spanners at random positions
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> tickDist(0, 100 * Constants::division);
+    std::uniform_int_distribution<int> ticksDist(0, 8 * Constants::division);
+
+    for (int i = 0; i < 200; ++i) {
+        addSpanner(tickDist(gen), ticksDist(gen));
+    }
+
+    for (int i = 0; i < 2000; ++i) {
+        //! DO Add, remove and move the spanners, one change at a time
+        if (m_spanners.empty()) {
+            addSpanner(tickDist(gen), ticksDist(gen));
+        }
+
+        switch (gen() % 4) {
+        case 0:
+            addSpanner(tickDist(gen), ticksDist(gen));
+            break;
+        case 1:
+            removeSpanner(gen() % m_spanners.size());
+            break;
+        case 2:
+            m_spanners.at(gen() % m_spanners.size())->setTick(Fraction::fromTicks(tickDist(gen)));
+            break;
+        default:
+            m_spanners.at(gen() % m_spanners.size())->setTicks(Fraction::fromTicks(ticksDist(gen)));
+            break;
+        }
+
+        //! CHECK The map finds the same spanners as a scan of all spanners
+        const int start = tickDist(gen);
+        checkSameAsScan(start, start + ticksDist(gen));
+    }
+
+    //! CHECK The same after a full rebuild
+    m_score->spannerMap().setDirty();
+    checkSameAsScan(0, 100 * Constants::division);
+}
+
+TEST_F(SpannerMapTests, FindOrder)
+{
+    //! GIVEN Spanners with equal start ticks
+    Spanner* s1 = addSpanner(480, 960);
+    Spanner* s2 = addSpanner(0, 480);
+    Spanner* s3 = addSpanner(480, 480);
+
+    //! DO Move the first spanner and back
+    s1->setTick(Fraction::fromTicks(1920));
+    s1->setTick(Fraction::fromTicks(480));
+
+    //! CHECK The spanners are found in the order of their start ticks, then in the order they were added
+    std::vector<interval_tree::Interval<Spanner*> > found = m_score->spannerMap().findOverlapping(0, 1920);
+    ASSERT_EQ(found.size(), 3u);
+    EXPECT_EQ(found.at(0).value, s2);
+    EXPECT_EQ(found.at(1).value, s1);
+    EXPECT_EQ(found.at(2).value, s3);
+}
+
+TEST_F(SpannerMapTests, LayoutDoesNotDependOnInsertionOrder)
+{
+    //! GIVEN A laid out score with many slurs and hairpins
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<std::pair<const Spanner*, mu::RectF> > layoutBefore = spannerSegmentsLayout(score);
+    ASSERT_FALSE(layoutBefore.empty());
+
+    //! DO Add the spanners to the map again, in the reverse order, and lay the score out again
+    std::vector<Spanner*> spanners;
+    for (const auto& pair : score->spannerMap().map()) {
+        spanners.push_back(pair.second);
+    }
+    for (Spanner* s : spanners) {
+        score->spannerMap().removeSpanner(s);
+    }
+    for (auto it = spanners.rbegin(); it != spanners.rend(); ++it) {
+        score->spannerMap().addSpanner(*it);
+    }
+
+    score->setLayoutAll();
+    score->doLayout();
+
+    //! CHECK The spanners are laid out the same way
+    std::vector<std::pair<const Spanner*, mu::RectF> > layoutAfter = spannerSegmentsLayout(score);
+    ASSERT_EQ(layoutAfter.size(), layoutBefore.size());
+    for (size_t i = 0; i < layoutBefore.size(); ++i) {
+        EXPECT_EQ(layoutAfter.at(i).first, layoutBefore.at(i).first) << "segment " << i;
+        EXPECT_EQ(layoutAfter.at(i).second, layoutBefore.at(i).second) << "segment " << i;
+    }
+
+    delete score;
+}
+
+TEST_F(SpannerMapTests, ConcurrentFind)
+{
+    //! GIVEN Spanners and a tree, that needs to be rebuilt
+    for (int i = 0; i < 1000; ++i) {
+        addSpanner(i * 120, 960);
+    }
+    m_score->spannerMap().setDirty();
+
+    //! DO Find the spanners from several threads at once
+    std::vector<size_t> counts(4, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < counts.size(); ++t) {
+        threads.emplace_back([this, &counts, t]() {
+            for (int tick = 0; tick < 1000 * 120; tick += 120) {
+                counts[t] += m_score->spannerMap().findOverlapping(tick, tick).size();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! CHECK All threads found the same spanners
+    for (size_t count : counts) {
+        EXPECT_EQ(count, counts.front());
+        EXPECT_GT(count, 0u);
+    }
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(SpannerMapTests, DISABLED_Benchmark_EditAndFind)
+{
+    //! GIVEN A lot of spanners
+    constexpr int SPANNERS = 20000;
+    for (int i = 0; i < SPANNERS; ++i) {
+        addSpanner(i * 120, 960);
+    }
+    m_score->spannerMap().findOverlapping(0, 0);
+
+    //! DO Move a spanner and find the spanners around it, like the edit of a slur does
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t found = 0;
+    for (int i = 0; i < 1000; ++i) {
+        Spanner* s = m_spanners.at((i * 7919) % SPANNERS);
+        s->setTick(s->tick() + Fraction::fromTicks(i % 2 ? -120 : 120));
+        found += m_score->spannerMap().findOverlapping(s->tick().ticks(), s->tick2().ticks()).size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    LOGI() << "1000 edits and finds among " << SPANNERS << " spanners: "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms";
+
+    //! CHECK
+    EXPECT_GT(found, 0u);
+}
@@ -33,6 +33,8 @@
 #include "libmscore/textedit.h"
 #include "libmscore/tie.h"
 
+#include "infrastructure/draw/fontmetrics.h"
+
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
 
@@ -42,6 +44,8 @@ static const QString TEXTBASE_DATA_DIR("textbase_data/");
 
 class TextBaseTests : public ::testing::Test
 {
+    INJECT(engraving, mu::draw::IFontProvider, fontProvider)
+
 public:
     Dynamic* addDynamic(MasterScore* score);
     StaffText* addStaffText(MasterScore* score);
@@ -192,3 +196,84 @@ TEST_F(TextBaseTests, musicalSymbolsNotItalic)
     EXPECT_TRUE(fragmentList.front().font(dynamic).italic());
     EXPECT_TRUE(!std::next(fragmentList.begin())->font(dynamic).italic());
 }
+
+TEST_F(TextBaseTests, relayoutFromMetricsCache)
+{
+    //! GIVEN A laid out text
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    StaffText* staffText = addStaffText(score);
+    staffText->setXmlText("<b>Allegro</b> <i>ma non troppo</i> <sym>metNoteQuarterUp</sym> = 120");
+    staffText->layout();
+    const mu::RectF bbox = staffText->bbox();
+
+    //! DO Lay out the unchanged text again
+    fontProvider()->resetCacheStats();
+    staffText->layout();
+
+    //! CHECK All metrics come from the cache, and are the same
+    mu::draw::IFontProvider::CacheStats stats = fontProvider()->cacheStats();
+    EXPECT_GT(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(staffText->bbox(), bbox);
+
+    delete score;
+}
+
+TEST_F(TextBaseTests, characterPositions)
+{
+    //! GIVEN A text in a regular font
+    mu::draw::Font font("Edwin");
+    font.setPointSizeF(10.0);
+    mu::draw::FontMetrics fm(font);
+    const QString text("Andante con moto");
+
+    //! DO Get the positions of the characters
+    std::vector<qreal> positions = fm.characterPositions(text);
+
+    //! CHECK There is a position after each character, the last one is at the end of the text
+    ASSERT_EQ(positions.size(), static_cast<size_t>(text.size()));
+    for (size_t i = 1; i < positions.size(); ++i) {
+        EXPECT_GE(positions[i], positions[i - 1]);
+    }
+    EXPECT_NEAR(positions.back(), fm.width(text), 0.01);
+}
+
+TEST_F(TextBaseTests, characterPositionsRightToLeft)
+{
+    //! GIVEN A text with right-to-left characters
+    mu::draw::Font font("Edwin");
+    font.setPointSizeF(10.0);
+    mu::draw::FontMetrics fm(font);
+    const QString text = QString::fromUtf8("Andante אנדנטה moto");
+
+    //! DO Get the positions of the characters
+    std::vector<qreal> positions = fm.characterPositions(text);
+
+    //! CHECK The positions follow the characters in the logical order, like the advances of the prefixes
+    ASSERT_EQ(positions.size(), static_cast<size_t>(text.size()));
+    for (size_t i = 1; i < positions.size(); ++i) {
+        EXPECT_GE(positions[i], positions[i - 1]);
+    }
+    EXPECT_NEAR(positions.front(), fm.width(text.left(1)), 0.01);
+    EXPECT_NEAR(positions.back(), fm.width(text), 0.01);
+}
+
+TEST_F(TextBaseTests, metricsCacheOfEqualFonts)
+{
+    //! GIVEN Two fonts, that are equal, but their point sizes differ a bit
+    mu::draw::Font font1("Edwin");
+    font1.setPointSizeF(10.0);
+    mu::draw::Font font2("Edwin");
+    font2.setPointSizeF(10.0 + 1e-12);
+    ASSERT_TRUE(font1 == font2);
+
+    //! DO Get the metrics of both
+    const qreal lineSpacing = mu::draw::FontMetrics(font1).lineSpacing();
+    fontProvider()->resetCacheStats();
+
+    //! CHECK The second font gets the metrics of the first one from the cache
+    EXPECT_EQ(mu::draw::FontMetrics(font2).lineSpacing(), lineSpacing);
+    mu::draw::IFontProvider::CacheStats stats = fontProvider()->cacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 0u);
+}
@@ -77,8 +77,8 @@ void AbstractSynthesizer::setupEvents(const mpe::PlaybackData& playbackData)
     loadDynamicLevelChanges(playbackData.dynamicLevelMap);
     m_dynamicLevelChanges = playbackData.dynamicLevelChanges;
 
-    m_mainStreamChanges.onReceive(this, [this](const PlaybackEventsMap& updatedEvents) {
-        loadMainStreamEvents(updatedEvents);
+    m_mainStreamChanges.onReceive(this, [this](const PlaybackEventsDelta& delta) {
+        applyMainStreamDelta(delta);
     });
 
     m_offStreamChanges.onReceive(this, [this](const PlaybackEventsMap& triggeredEvents) {
@@ -96,6 +96,11 @@ void AbstractSynthesizer::loadMainStreamEvents(const mpe::PlaybackEventsMap& upd
     m_mainStreamEvents.load(updatedEvents);
 }
 
+void AbstractSynthesizer::applyMainStreamDelta(const mpe::PlaybackEventsDelta& delta)
+{
+    m_mainStreamEvents.apply(delta);
+}
+
 void AbstractSynthesizer::loadOffStreamEvents(const mpe::PlaybackEventsMap& updatedEvents)
 {
     m_offStreamEvents.clear();
@@ -114,7 +119,7 @@ void AbstractSynthesizer::revokePlayingNotes()
 
 bool AbstractSynthesizer::isActive() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     return m_isActive;
 }
@@ -128,7 +133,7 @@ void AbstractSynthesizer::setIsActive(bool arg)
 
 audio::msecs_t AbstractSynthesizer::samplesToMsecs(const samples_t samplesPerChannel, const samples_t sampleRate) const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     return samplesPerChannel * 1000 / sampleRate;
 }
@@ -142,14 +147,14 @@ msecs_t AbstractSynthesizer::actualPlaybackPositionStart() const
 
 audio::msecs_t mu::audio::synth::AbstractSynthesizer::playbackPosition() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     return m_playbackPosition;
 }
 
 void AbstractSynthesizer::setPlaybackPosition(const msecs_t newPosition)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     m_playbackPosition = newPosition;
 }
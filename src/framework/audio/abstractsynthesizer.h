@@ -26,6 +26,7 @@
 #include "async/channel.h"
 #include "async/asyncable.h"
 #include "mpe/events.h"
+#include "mpe/packedevents.h"
 
 #include "synthtypes.h"
 #include "audiotypes.h"
@@ -58,69 +59,136 @@ public:
     static constexpr msecs_t MIN_NOTE_LENGTH = 250;
 
 protected:
-    using EventsMapIterator = mpe::PlaybackEventsMap::const_iterator;
-    using EventsMapIteratorList = std::vector<EventsMapIterator>;
-
     struct EventsBuffer {
         msecs_t from = 0;
         msecs_t to = 0;
 
-        const mpe::PlaybackEventsMap& events() const
+        using NotesOrder = std::vector<uint32_t>;
+
+        //! NOTE A view on the indices of the notes, ordered by the actual timestamps
+        struct NotesRange {
+            NotesOrder::const_iterator first;
+            NotesOrder::const_iterator last;
+
+            NotesOrder::const_iterator begin() const { return first; }
+            NotesOrder::const_iterator end() const { return last; }
+        };
+
+        const mpe::PackedPlaybackEvents& events() const
         {
             return m_events;
         }
 
         void load(const mpe::PlaybackEventsMap& events)
         {
-            for (const auto& pair : events) {
-                for (const mpe::PlaybackEvent& event : pair.second) {
-                    if (!std::holds_alternative<mpe::NoteEvent>(event)) {
-                        continue;
-                    }
-
-                    mpe::timestamp_t actualTimestamp = std::get<mpe::NoteEvent>(event).arrangementCtx().actualTimestamp;
-
-                    m_events[actualTimestamp].emplace_back(event);
-                }
-            }
+            m_events.load(events);
+            updateNotesOrder();
             updateBoundaries();
         }
 
-        EventsMapIteratorList findEventsRange(const msecs_t rangeFrom, const msecs_t rangeTo) const
+        //! NOTE Replaces only the changed ranges, the rest of the events stay untouched
+        void apply(const mpe::PlaybackEventsDelta& delta)
         {
-            if (m_events.empty()) {
-                static EventsMapIteratorList empty;
-                return empty;
-            }
-
-            auto firstNotLess = m_events.lower_bound(rangeFrom);
-
-            if (firstNotLess == m_events.begin()) {
-                return { firstNotLess };
+            for (const mpe::PlaybackEventsRange& range : delta.ranges) {
+                updateNotesOrder(m_events.replace(range));
             }
 
-            auto firstLess = std::prev(firstNotLess);
+            updateBoundaries();
+        }
 
-            if (firstNotLess->first > rangeTo || firstNotLess == m_events.cend()) {
-                return { firstLess };
-            }
+        //! NOTE The indices of the notes, that start in [rangeFrom, rangeTo).
+        //! Doesn't allocate, the notes are unpacked by event() only when they are played
+        NotesRange findEvents(const msecs_t rangeFrom, const msecs_t rangeTo) const
+        {
+            return { lowerBound(rangeFrom), lowerBound(rangeTo) };
+        }
 
-            return { firstLess, firstNotLess };
+        mpe::PlaybackEvent event(const uint32_t idx) const
+        {
+            return m_events.event(m_events.events()[idx]);
         }
 
         void clear()
         {
             m_events.clear();
+            m_notesOrder.clear();
             updateBoundaries();
         }
 
         bool empty() const
         {
-            return m_events.empty();
+            return m_notesOrder.empty();
         }
 
     private:
 
+        mpe::timestamp_t actualTimestamp(const uint32_t idx) const
+        {
+            return m_events.events()[idx].actualTimestamp;
+        }
+
+        NotesOrder::const_iterator lowerBound(const msecs_t timestamp) const
+        {
+            return std::lower_bound(m_notesOrder.cbegin(), m_notesOrder.cend(), timestamp, [this](uint32_t idx, msecs_t t) {
+                return actualTimestamp(idx) < t;
+            });
+        }
+
+        //! NOTE The events are sorted by the origin timestamps, the synthesizers need them by the actual ones
+        void updateNotesOrder()
+        {
+            m_notesOrder.clear();
+
+            const mpe::PackedPlaybackEvents::EventList& events = m_events.events();
+            for (size_t i = 0; i < events.size(); ++i) {
+                if (!events[i].isRest) {
+                    m_notesOrder.push_back(static_cast<uint32_t>(i));
+                }
+            }
+
+            //! NOTE The actual timestamps are close to the origin ones, so it is almost sorted already
+            std::stable_sort(m_notesOrder.begin(), m_notesOrder.end(), [&events](uint32_t f, uint32_t s) {
+                return events[f].actualTimestamp < events[s].actualTimestamp;
+            });
+        }
+
+        //! NOTE Removes the indices of the replaced events, shifts the ones after them
+        //! and inserts the new notes at their places, so the order is the same as after the full update
+        void updateNotesOrder(const mpe::PackedPlaybackEvents::ReplacedRange& range)
+        {
+            const uint32_t first = static_cast<uint32_t>(range.first);
+            const uint32_t removedLast = static_cast<uint32_t>(range.first + range.removedCount);
+            const int64_t shift = static_cast<int64_t>(range.insertedCount) - static_cast<int64_t>(range.removedCount);
+
+            auto removed = std::remove_if(m_notesOrder.begin(), m_notesOrder.end(), [first, removedLast](uint32_t idx) {
+                return idx >= first && idx < removedLast;
+            });
+            m_notesOrder.erase(removed, m_notesOrder.end());
+
+            if (shift != 0) {
+                for (uint32_t& idx : m_notesOrder) {
+                    if (idx >= removedLast) {
+                        idx = static_cast<uint32_t>(idx + shift);
+                    }
+                }
+            }
+
+            const mpe::PackedPlaybackEvents::EventList& events = m_events.events();
+            for (size_t i = range.first; i < range.first + range.insertedCount; ++i) {
+                if (events[i].isRest) {
+                    continue;
+                }
+
+                //! NOTE The notes with the same actual timestamp stay in the order of the events
+                uint32_t idx = static_cast<uint32_t>(i);
+                auto it = std::upper_bound(m_notesOrder.begin(), m_notesOrder.end(), idx, [&events](uint32_t n, uint32_t other) {
+                    return events[n].actualTimestamp < events[other].actualTimestamp
+                           || (events[n].actualTimestamp == events[other].actualTimestamp && n < other);
+                });
+                m_notesOrder.insert(it, idx);
+            }
+        }
+
         void updateBoundaries()
         {
             if (empty()) {
@@ -129,31 +197,26 @@ protected:
                 return;
             }
 
-            auto firstEvents = m_events.begin();
-            from = firstEvents->first;
-
-            auto lastEvents = m_events.rbegin();
-            to = lastEvents->first;
-
-            for (const mpe::PlaybackEvent& event : lastEvents->second) {
-                if (!std::holds_alternative<mpe::NoteEvent>(event)) {
-                    continue;
-                }
+            from = actualTimestamp(m_notesOrder.front());
+            to = actualTimestamp(m_notesOrder.back());
 
-                const mpe::NoteEvent& noteEvent = std::get<mpe::NoteEvent>(event);
+            for (auto it = lowerBound(to); it != m_notesOrder.cend(); ++it) {
+                const mpe::PackedPlaybackEvents::Event& event = m_events.events()[*it];
 
-                mpe::duration_t dampedDuration = noteEvent.arrangementCtx().actualDuration * DAMPER_FACTOR;
+                mpe::duration_t dampedDuration = event.actualDuration * DAMPER_FACTOR;
                 dampedDuration = std::max(dampedDuration, MIN_NOTE_LENGTH);
-                to = std::max(noteEvent.arrangementCtx().actualTimestamp + dampedDuration, to);
+                to = std::max(event.actualTimestamp + dampedDuration, to);
             }
         }
 
-        mpe::PlaybackEventsMap m_events;
+        mpe::PackedPlaybackEvents m_events;
+        NotesOrder m_notesOrder;
     };
 
     virtual void setupSound(const mpe::PlaybackSetupData& setupData) = 0;
     virtual void setupEvents(const mpe::PlaybackData& playbackData);
     virtual void loadMainStreamEvents(const mpe::PlaybackEventsMap& updatedEvents);
+    virtual void applyMainStreamDelta(const mpe::PlaybackEventsDelta& delta);
     virtual void loadOffStreamEvents(const mpe::PlaybackEventsMap& updatedEvents);
     virtual void loadDynamicLevelChanges(const mpe::DynamicLevelMap& updatedDynamicLevelMap);
 
@@ -167,7 +230,7 @@ protected:
     EventsBuffer m_mainStreamEvents;
     EventsBuffer m_offStreamEvents;
 
-    mpe::PlaybackEventsChanges m_mainStreamChanges;
+    mpe::PlaybackEventsDeltaChanges m_mainStreamChanges;
     mpe::PlaybackEventsChanges m_offStreamChanges;
     async::Channel<mpe::DynamicLevelMap> m_dynamicLevelChanges;
 
@@ -167,6 +167,9 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
     s_soundFontRepository->init();
 
     s_audioBuffer->init(s_audioConfiguration->audioChannelsCount());
+    s_audioBuffer->setRefillRequestHandler([]() {
+        s_audioWorker->requestBufferRefill();
+    });
 
     // Setup audio driver
     IAudioDriver::Spec requiredSpec;
@@ -199,6 +202,7 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
         // Setup audio engine
         AudioEngine::instance()->init(s_audioBuffer);
         AudioEngine::instance()->setAudioChannelsCount(s_audioConfiguration->audioChannelsCount());
+        AudioEngine::instance()->setMixerThreadsCount(s_audioConfiguration->mixerThreadsCount());
         AudioEngine::instance()->setSampleRate(activeSpec.sampleRate);
         AudioEngine::instance()->setReadBufferSize(activeSpec.samples);
 
@@ -213,6 +217,11 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
     auto workerLoopBody = []() {
         ONLY_AUDIO_WORKER_THREAD;
         s_audioBuffer->forward();
+
+        bool isIdle = AudioEngine::instance()->isIdle();
+        s_audioBuffer->setIsIdle(isIdle);
+
+        return !isIdle;
     };
 
     s_audioWorker->run(workerSetup, workerLoopBody);
@@ -239,5 +248,16 @@ void AudioModule::onDeinit()
             s_playbackFacade->deInit();
             AudioEngine::instance()->deinit();
         });
+
+        AudioThread::Stats workerStats = s_audioWorker->stats();
+        AudioBuffer::Stats bufferStats = s_audioBuffer->stats();
+        LOGI() << "audio worker wakeups: " << workerStats.wakeups
+               << " (events: " << workerStats.eventWakeups
+               << ", buffer: " << workerStats.bufferWakeups
+               << ", timeouts: " << workerStats.timeoutWakeups << ")"
+               << ", refills: " << bufferStats.refills
+               << ", refill latency avg: " << (bufferStats.refills ? bufferStats.totalRefillLatencyUs / bufferStats.refills : 0) << "us"
+               << ", max: " << bufferStats.maxRefillLatencyUs << "us"
+               << ", underruns: " << bufferStats.underruns;
     }
 }
@@ -46,6 +46,9 @@ public:
     virtual audioch_t audioChannelsCount() const = 0;
     virtual unsigned int driverBufferSize() const = 0; // samples
 
+    //! NOTE Additional threads used to render the mixer channels in parallel, 0 means serial rendering
+    virtual size_t mixerThreadsCount() const = 0;
+
     // synthesizers
     virtual AudioInputParams defaultAudioInputParams() const = 0;
     virtual io::paths_t soundFontDirectories() const = 0;
@@ -27,6 +27,7 @@
 
 #include "async/promise.h"
 #include "async/channel.h"
+#include "progress.h"
 
 #include "audiotypes.h"
 
@@ -51,6 +52,7 @@ public:
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+    virtual framework::ProgressChannel saveSoundTrackProgress(const TrackSequenceId sequenceId) = 0;
 };
 
 using IAudioOutputPtr = std::shared_ptr<IAudioOutput>;
@@ -21,105 +21,183 @@
  */
 #include "audiobuffer.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 
 #include "log.h"
 
 using namespace mu::audio;
 
-void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel)
+static int64_t nowUs()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
 
-    m_samplesPerChannel = samplesPerChannel;
+void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel)
+{
+    //! NOTE The size is a multiple of FILL_SAMPLES, so every filled block is contiguous in memory
+    m_samplesPerChannel = std::max(samplesPerChannel, 2 * FILL_SAMPLES);
+    m_samplesPerChannel += (FILL_SAMPLES - m_samplesPerChannel % FILL_SAMPLES) % FILL_SAMPLES;
     m_audioChannelsCount = audioChannelsCount;
 
-    m_data.resize(m_samplesPerChannel * m_audioChannelsCount, 0.f);
+    m_data.assign(m_samplesPerChannel * m_audioChannelsCount, 0.f);
+
+    m_writeIndex.store(0, std::memory_order_relaxed);
+    m_readIndex.store(0, std::memory_order_relaxed);
+    m_underrunsCount.store(0, std::memory_order_relaxed);
+}
+
+void AudioBuffer::setRefillRequestHandler(std::function<void()> handler)
+{
+    m_refillRequestHandler = std::move(handler);
+}
+
+void AudioBuffer::setIsIdle(bool idle)
+{
+    m_isIdle.store(idle, std::memory_order_relaxed);
 }
 
 void AudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_source = source;
 }
 
 void AudioBuffer::forward()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     fillup();
 }
 
 void AudioBuffer::pop(float* dest, size_t sampleCount)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    //! NOTE Not initialized yet, there is nothing to read
+    if (m_audioChannelsCount == 0) {
+        return;
+    }
+
+    const size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+    const size_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+    const samples_t lag = sampleLag(writeIndex, readIndex);
+    const size_t samplesToRead = std::min<size_t>(lag, sampleCount) * m_audioChannelsCount;
+    const size_t firstPart = std::min(samplesToRead, m_data.size() - readIndex);
+    const auto memStep = sizeof(float);
+
+    std::memcpy(dest, m_data.data() + readIndex, firstPart * memStep);
+    std::memcpy(dest + firstPart, m_data.data(), (samplesToRead - firstPart) * memStep);
+
+    const size_t requestedSamples = sampleCount * m_audioChannelsCount;
+    const bool isIdle = m_isIdle.load(std::memory_order_relaxed);
+
+    if (samplesToRead < requestedSamples) {
+        std::memset(dest + samplesToRead, 0, (requestedSamples - samplesToRead) * memStep);
+
+        if (!isIdle) {
+            m_underrunsCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    size_t newReadIndex = readIndex + samplesToRead;
+    if (newReadIndex >= m_data.size()) {
+        newReadIndex -= m_data.size();
+    }
+
+    m_readIndex.store(newReadIndex, std::memory_order_release);
 
-    size_t from = m_readIndex;
-    auto memStep = sizeof(float);
-    size_t to = m_readIndex + sampleCount * m_audioChannelsCount;
-    if (to > m_data.size()) {
-        to = m_data.size();
+    if (!isIdle && lag - samplesToRead / m_audioChannelsCount < m_minSampleLag.load(std::memory_order_relaxed)) {
+        requestRefill();
     }
-    auto count = to - from;
-    std::memcpy(dest, m_data.data() + from, count * memStep);
-    m_readIndex += count;
-
-    size_t left = sampleCount * m_audioChannelsCount - count;
-    if (left > 0) {
-        std::memcpy(dest + count, m_data.data(), left * memStep);
-        m_readIndex = left;
+}
+
+void AudioBuffer::requestRefill()
+{
+    int64_t expected = 0;
+    if (!m_refillRequestedAtUs.compare_exchange_strong(expected, nowUs(), std::memory_order_relaxed)) {
+        return; // already requested
     }
 
-    if (m_readIndex >= m_data.size()) {
-        m_readIndex -= m_data.size();
+    if (m_refillRequestHandler) {
+        m_refillRequestHandler();
     }
 }
 
 void AudioBuffer::setMinSampleLag(size_t lag)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t maxLag = m_samplesPerChannel - FILL_SAMPLES - FILL_OVER;
 
-    IF_ASSERT_FAILED(lag < m_data.size()) {
-        lag = m_data.size();
+    IF_ASSERT_FAILED(lag <= maxLag) {
+        lag = maxLag;
     }
-    m_minSampleLag = lag;
+
+    m_minSampleLag.store(lag, std::memory_order_relaxed);
+}
+
+uint64_t AudioBuffer::underrunsCount() const
+{
+    return m_underrunsCount.load(std::memory_order_relaxed);
+}
+
+AudioBuffer::Stats AudioBuffer::stats() const
+{
+    Stats stats;
+    stats.underruns = m_underrunsCount.load(std::memory_order_relaxed);
+    stats.refills = m_refillsCount.load(std::memory_order_relaxed);
+    stats.maxRefillLatencyUs = m_maxRefillLatencyUs.load(std::memory_order_relaxed);
+    stats.totalRefillLatencyUs = m_totalRefillLatencyUs.load(std::memory_order_relaxed);
+
+    return stats;
 }
 
 void AudioBuffer::fillup()
 {
-    if (!m_source) {
+    if (!m_source || m_audioChannelsCount == 0) {
         return;
     }
 
-    while (sampleLag() < m_minSampleLag + FILL_OVER) {
-        m_source->process(m_data.data() + m_writeIndex, FILL_SAMPLES);
-        updateWriteIndex(FILL_SAMPLES);
-    }
-}
+    const size_t minSampleLag = m_minSampleLag.load(std::memory_order_relaxed);
+    const size_t blockSize = FILL_SAMPLES * m_audioChannelsCount;
+    size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
 
-void AudioBuffer::updateWriteIndex(const unsigned int samplesPerChannel)
-{
-    size_t from = m_writeIndex;
+    while (true) {
+        samples_t lag = sampleLag(writeIndex, m_readIndex.load(std::memory_order_acquire));
 
-    auto to = m_writeIndex + samplesPerChannel * m_audioChannelsCount;
-    if (to > m_data.size()) {
-        to = m_data.size() - 1;
+        //! NOTE At least one frame stays free, otherwise a full buffer would look empty
+        if (lag >= minSampleLag + FILL_OVER || lag + FILL_SAMPLES >= m_samplesPerChannel) {
+            break;
+        }
+
+        m_source->process(m_data.data() + writeIndex, FILL_SAMPLES);
+
+        writeIndex += blockSize;
+        if (writeIndex >= m_data.size()) {
+            writeIndex -= m_data.size();
+        }
+
+        m_writeIndex.store(writeIndex, std::memory_order_release);
     }
-    auto count = to - from;
-    m_writeIndex += count;
 
-    if (m_writeIndex >= m_data.size()) {
-        m_writeIndex -= m_data.size();
+    int64_t requestedAtUs = m_refillRequestedAtUs.exchange(0, std::memory_order_relaxed);
+    if (requestedAtUs != 0) {
+        uint64_t latencyUs = static_cast<uint64_t>(nowUs() - requestedAtUs);
+
+        m_refillsCount.fetch_add(1, std::memory_order_relaxed);
+        m_totalRefillLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+
+        if (latencyUs > m_maxRefillLatencyUs.load(std::memory_order_relaxed)) {
+            m_maxRefillLatencyUs.store(latencyUs, std::memory_order_relaxed);
+        }
     }
 }
 
-unsigned int AudioBuffer::sampleLag() const
+mu::audio::samples_t AudioBuffer::sampleLag(const size_t writeIndex, const size_t readIndex) const
 {
     size_t lag = 0;
-    if (m_readIndex <= m_writeIndex) {
-        lag = m_writeIndex - m_readIndex;
+    if (readIndex <= writeIndex) {
+        lag = writeIndex - readIndex;
     } else {
-        lag = m_writeIndex + m_data.size() - m_readIndex;
+        lag = writeIndex + m_data.size() - readIndex;
     }
 
-    return static_cast<unsigned int>(lag / m_audioChannelsCount);
+    return lag / m_audioChannelsCount;
 }
@@ -25,39 +25,75 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <functional>
 
 #include "modularity/ioc.h"
 
 #include "iaudiobuffer.h"
 
 namespace mu::audio {
+//! NOTE Wait-free single producer / single consumer ring buffer.
+//! The worker thread is the only producer (setSource, forward, setMinSampleLag),
+//! the driver thread is the only consumer (pop). Neither side ever blocks the other.
 class AudioBuffer : public IAudioBuffer
 {
     static const samples_t DEFAULT_SIZE = 16384;
     static const samples_t FILL_SAMPLES = 1024;
     static const samples_t FILL_OVER    = 1024;
 
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
 public:
     AudioBuffer() = default;
 
+    struct Stats {
+        uint64_t underruns = 0;
+        uint64_t refills = 0;
+        uint64_t maxRefillLatencyUs = 0;
+        uint64_t totalRefillLatencyUs = 0;
+    };
+
     void init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel = DEFAULT_SIZE);
 
+    //! NOTE Called from the driver thread, when the buffer falls below the min sample lag
+    void setRefillRequestHandler(std::function<void()> handler);
+
+    //! NOTE While idle, the source produces nothing but silence, so the buffer isn't refilled
+    //! and running out of data isn't an underrun
+    void setIsIdle(bool idle);
+
     void setSource(std::shared_ptr<IAudioSource> source) override;
     void forward() override;
 
     void pop(float* dest, size_t sampleCount) override;
     void setMinSampleLag(size_t lag) override;
 
+    //! NOTE Count of pop() calls, which couldn't be fully served and were padded with silence
+    uint64_t underrunsCount() const;
+
+    Stats stats() const;
+
 private:
 
-    unsigned int sampleLag() const;
+    samples_t sampleLag(const size_t writeIndex, const size_t readIndex) const;
     void fillup();
-    void updateWriteIndex(const unsigned int samplesPerChannel);
+    void requestRefill();
+
+    // the indices are in floats, each one is modified by a single thread only
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_writeIndex { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_readIndex { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_minSampleLag { FILL_SAMPLES };
+    std::atomic<uint64_t> m_underrunsCount { 0 };
+
+    // the time of the pending refill request in microseconds, 0 - no pending request
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_refillRequestedAtUs { 0 };
+    std::atomic<bool> m_isIdle { false };
+    std::function<void()> m_refillRequestHandler = nullptr;
+
+    std::atomic<uint64_t> m_refillsCount { 0 };
+    std::atomic<uint64_t> m_maxRefillLatencyUs { 0 };
+    std::atomic<uint64_t> m_totalRefillLatencyUs { 0 };
 
-    std::mutex m_mutex;
-    size_t m_minSampleLag = FILL_SAMPLES;
-    size_t m_writeIndex = 0;
-    size_t m_readIndex = 0;
     samples_t m_samplesPerChannel = 0;
     audioch_t m_audioChannelsCount = 0;
 
@@ -22,6 +22,7 @@
 #include "audioconfiguration.h"
 #include "settings.h"
 #include "stringutils.h"
+#include "concurrency/concurrency.h"
 
 #include "global/xmlreader.h"
 #include "global/xmlwriter.h"
@@ -41,6 +42,7 @@ static const audioch_t AUDIO_CHANNELS = 2;
 //TODO: add other setting: audio device etc
 static const Settings::Key AUDIO_API_KEY("audio", "io/audioApi");
 static const Settings::Key AUDIO_BUFFER_SIZE("audio", "driver_buffer");
+static const Settings::Key AUDIO_MIXER_THREADS("audio", "mixer_threads");
 
 static const Settings::Key USER_SOUNDFONTS_PATHS("midi", "application/paths/mySoundfonts");
 
@@ -58,6 +60,14 @@ void AudioConfiguration::init()
 #endif
     settings()->setDefaultValue(AUDIO_BUFFER_SIZE, Val(defaultBufferSize));
 
+    //! NOTE The worker renders too, so the pool gets one thread less than the cores available for audio
+    int defaultMixerThreads = 0;
+#ifndef Q_OS_WASM
+    defaultMixerThreads = static_cast<int>(std::min<size_t>(concurrency::idealThreadCount() / 2, 4)) - 1;
+    defaultMixerThreads = std::max(defaultMixerThreads, 0);
+#endif
+    settings()->setDefaultValue(AUDIO_MIXER_THREADS, Val(defaultMixerThreads));
+
     settings()->setDefaultValue(AUDIO_API_KEY, Val("Core Audio"));
 
     settings()->setDefaultValue(USER_SOUNDFONTS_PATHS, Val(globalConfiguration()->userDataPath() + "/SoundFonts"));
@@ -102,6 +112,11 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+size_t AudioConfiguration::mixerThreadsCount() const
+{
+    return static_cast<size_t>(std::max(settings()->value(AUDIO_MIXER_THREADS).toInt(), 0));
+}
+
 SoundFontPaths AudioConfiguration::soundFontDirectories() const
 {
     SoundFontPaths paths = userSoundFontDirectories();
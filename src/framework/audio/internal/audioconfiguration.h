@@ -45,6 +45,8 @@ public:
     audioch_t audioChannelsCount() const override;
     unsigned int driverBufferSize() const override;
 
+    size_t mixerThreadsCount() const override;
+
     io::paths_t soundFontDirectories() const override;
     io::paths_t userSoundFontDirectories() const override;
     void setUserSoundFontDirectories(const io::paths_t& paths) override;
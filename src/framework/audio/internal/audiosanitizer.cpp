@@ -27,6 +27,7 @@ using namespace mu::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
+static thread_local bool s_as_isMixerThread = false;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -57,3 +58,13 @@ bool AudioSanitizer::isWorkerThread()
 {
     return std::this_thread::get_id() == s_as_workerThreadID;
 }
+
+void AudioSanitizer::setupMixerThread()
+{
+    s_as_isMixerThread = true;
+}
+
+bool AudioSanitizer::isMixerThread()
+{
+    return s_as_isMixerThread;
+}
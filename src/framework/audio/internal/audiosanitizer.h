@@ -39,11 +39,16 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! NOTE Threads, that render mixer channels in parallel with the worker
+    static void setupMixerThread();
+    static bool isMixerThread();
 };
 }
 
 #define ONLY_AUDIO_WORKER_THREAD assert(mu::audio::AudioSanitizer::isWorkerThread())
 #define ONLY_AUDIO_MAIN_THREAD assert(mu::audio::AudioSanitizer::isMainThread())
+#define ONLY_AUDIO_PROCESS_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isMixerThread()))
 #define ONLY_AUDIO_MAIN_OR_WORKER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isMainThread()))
 
 #endif // MU_AUDIO_AUDIOSANITIZER_H
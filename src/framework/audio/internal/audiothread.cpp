@@ -40,7 +40,11 @@ AudioThread::~AudioThread()
     }
 }
 
-void AudioThread::run(const Runnable& onStart, const Runnable& loopBody)
+//! NOTE While something is playing, the worker is woken up by the driver, when the buffer
+//! falls below its minimum lag. The timeout only guards against a missed request.
+static constexpr std::chrono::milliseconds ACTIVE_WAKEUP_TIMEOUT(20);
+
+void AudioThread::run(const Runnable& onStart, const LoopBody& loopBody)
 {
     m_onStart = onStart;
     m_mainLoopBody = loopBody;
@@ -63,6 +67,7 @@ void AudioThread::stop(const Runnable& onFinished)
     m_onFinished = onFinished;
     m_running = false;
     if (m_thread) {
+        m_wakeupSemaphore.post();
         m_thread->join();
     }
 }
@@ -78,21 +83,89 @@ void AudioThread::main()
 
     AudioThread::ID = std::this_thread::get_id();
 
+    mu::async::onQueued(AudioThread::ID, [this]() {
+        wakeup(WakeupReason::Event);
+    });
+
     if (m_onStart) {
         m_onStart();
     }
 
     while (m_running) {
-        mu::async::processEvents();
+        loopBody();
+        waitForWakeup();
+    }
+
+    mu::async::onQueued(AudioThread::ID, nullptr);
+
+    if (m_onFinished) {
+        m_onFinished();
+    }
+}
+
+void AudioThread::loopBody()
+{
+    mu::async::processEvents();
+
+    bool hasWork = m_mainLoopBody ? m_mainLoopBody() : false;
+    m_isIdle = !hasWork;
+}
+
+void AudioThread::requestBufferRefill()
+{
+    wakeup(WakeupReason::Buffer);
+}
+
+void AudioThread::wakeup(WakeupReason reason)
+{
+    int prevReasons = m_wakeupReasons.fetch_or(static_cast<int>(reason));
+    if (prevReasons == 0) {
+        m_wakeupSemaphore.post();
+    }
+}
+
+void AudioThread::waitForWakeup()
+{
+    int reasons = 0;
+
+    //! NOTE A post may outlive the reasons it was made for (they are taken by the previous iteration),
+    //! so an empty wakeup just means waiting again
+    while (m_running) {
+        bool signaled = true;
+        if (m_isIdle) {
+            m_wakeupSemaphore.wait();
+        } else {
+            signaled = m_wakeupSemaphore.waitFor(ACTIVE_WAKEUP_TIMEOUT);
+        }
+
+        reasons = m_wakeupReasons.exchange(0);
 
-        if (m_mainLoopBody) {
-            m_mainLoopBody();
+        if (!signaled && reasons == 0) {
+            m_timeoutWakeupsCount++;
+            break;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        if (reasons != 0) {
+            break;
+        }
     }
 
-    if (m_onFinished) {
-        m_onFinished();
+    if (reasons & static_cast<int>(WakeupReason::Event)) {
+        m_eventWakeupsCount++;
+    }
+
+    if (reasons & static_cast<int>(WakeupReason::Buffer)) {
+        m_bufferWakeupsCount++;
     }
 }
+
+AudioThread::Stats AudioThread::stats() const
+{
+    Stats stats;
+    stats.eventWakeups = m_eventWakeupsCount;
+    stats.bufferWakeups = m_bufferWakeupsCount;
+    stats.timeoutWakeups = m_timeoutWakeupsCount;
+    stats.wakeups = stats.eventWakeups + stats.bufferWakeups + stats.timeoutWakeups;
+
+    return stats;
+}
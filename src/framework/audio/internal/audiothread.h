@@ -28,6 +28,8 @@
 #include <atomic>
 #include <functional>
 
+#include "concurrency/semaphore.h"
+
 namespace mu::audio {
 class AudioThread
 {
@@ -39,19 +41,53 @@ public:
 
     using Runnable = std::function<void ()>;
 
-    void run(const Runnable& onStart, const Runnable& loopBody);
+    //! NOTE Returns false, if there is nothing to process until the next wakeup
+    using LoopBody = std::function<bool ()>;
+
+    struct Stats {
+        uint64_t wakeups = 0;
+        uint64_t eventWakeups = 0;
+        uint64_t bufferWakeups = 0;
+        uint64_t timeoutWakeups = 0;
+    };
+
+    void run(const Runnable& onStart, const LoopBody& loopBody);
     void stop(const Runnable& onFinished = nullptr);
     bool isRunning() const;
 
+    //! NOTE Wakes the worker up to refill the audio buffer. Called from the driver thread
+    void requestBufferRefill();
+
+    Stats stats() const;
+
 private:
+    enum class WakeupReason {
+        Event = 0x1,
+        Buffer = 0x2
+    };
+
     void main();
+    void loopBody();
+
+    void wakeup(WakeupReason reason);
+    void waitForWakeup();
 
     Runnable m_onStart = nullptr;
-    Runnable m_mainLoopBody = nullptr;
+    LoopBody m_mainLoopBody = nullptr;
     Runnable m_onFinished = nullptr;
 
     std::unique_ptr<std::thread> m_thread = nullptr;
     std::atomic<bool> m_running = false;
+
+    //! NOTE The reasons are collected without a lock and the semaphore is only posted by the first
+    //! request after the worker has taken them, so the driver thread never blocks and never locks
+    std::atomic<int> m_wakeupReasons = 0;
+    concurrency::Semaphore m_wakeupSemaphore;
+    bool m_isIdle = false;
+
+    std::atomic<uint64_t> m_eventWakeupsCount = 0;
+    std::atomic<uint64_t> m_bufferWakeupsCount = 0;
+    std::atomic<uint64_t> m_timeoutWakeupsCount = 0;
 };
 }
 
@@ -38,7 +38,7 @@ std::thread::id AudioThreadSecurer::mainThreadId() const
 
 bool AudioThreadSecurer::isAudioWorkerThread() const
 {
-    return AudioSanitizer::isWorkerThread();
+    return AudioSanitizer::isWorkerThread() || AudioSanitizer::isMixerThread();
 }
 
 std::thread::id AudioThreadSecurer::workerThreadId() const
@@ -0,0 +1,431 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiokernels.h"
+
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MU_AUDIO_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MU_AUDIO_AVX2_TARGET
+#else
+#define MU_AUDIO_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MU_AUDIO_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+namespace {
+struct KernelTable {
+    void (* mixAdd)(float* dst, const float* src, size_t samplesCount);
+    void (* applyGain)(float* buffer, size_t samplesCount, gain_t gain);
+    void (* applyChannelGainsAndMeasure)(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                         const gain_t* channelGains, float* squaredSums);
+};
+
+// ===== Scalar =====
+
+void mixAddScalar(float* dst, const float* src, size_t samplesCount)
+{
+    for (size_t i = 0; i < samplesCount; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+void applyGainScalar(float* buffer, size_t samplesCount, gain_t gain)
+{
+    for (size_t i = 0; i < samplesCount; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+void applyChannelGainsAndMeasureFrom(float* buffer, audioch_t audioChannelsCount, samples_t fromSample, samples_t toSample,
+                                     const gain_t* channelGains, float* squaredSums)
+{
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        const gain_t gain = channelGains[audioChNum];
+        float squaredSum = 0.f;
+
+        for (samples_t s = fromSample; s < toSample; ++s) {
+            float& sample = buffer[s * audioChannelsCount + audioChNum];
+
+            float resultSample = sample * gain;
+            sample = resultSample;
+            squaredSum += resultSample * resultSample;
+        }
+
+        squaredSums[audioChNum] += squaredSum;
+    }
+}
+
+void applyChannelGainsAndMeasureScalar(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                       const gain_t* channelGains, float* squaredSums)
+{
+    applyChannelGainsAndMeasureFrom(buffer, audioChannelsCount, 0, samplesPerChannel, channelGains, squaredSums);
+}
+
+constexpr KernelTable SCALAR_KERNELS = {
+    mixAddScalar,
+    applyGainScalar,
+    applyChannelGainsAndMeasureScalar
+};
+
+//! NOTE The vector paths handle the channel layouts, where every vector starts with the first channel
+bool isVectorizableLayout(audioch_t audioChannelsCount, size_t lanes)
+{
+    return audioChannelsCount > 0 && audioChannelsCount <= lanes && lanes % audioChannelsCount == 0;
+}
+
+#ifdef MU_AUDIO_KERNELS_X86
+
+// ===== SSE2 =====
+
+void mixAddSse2(float* dst, const float* src, size_t samplesCount)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= samplesCount; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+
+    mixAddScalar(dst + i, src + i, samplesCount - i);
+}
+
+void applyGainSse2(float* buffer, size_t samplesCount, gain_t gain)
+{
+    const __m128 gainVec = _mm_set1_ps(gain);
+    size_t i = 0;
+
+    for (; i + 4 <= samplesCount; i += 4) {
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), gainVec));
+    }
+
+    applyGainScalar(buffer + i, samplesCount - i, gain);
+}
+
+void applyChannelGainsAndMeasureSse2(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                     const gain_t* channelGains, float* squaredSums)
+{
+    constexpr size_t LANES = 4;
+
+    if (!isVectorizableLayout(audioChannelsCount, LANES)) {
+        applyChannelGainsAndMeasureScalar(buffer, audioChannelsCount, samplesPerChannel, channelGains, squaredSums);
+        return;
+    }
+
+    alignas(16) float gains[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+        gains[l] = channelGains[l % audioChannelsCount];
+    }
+
+    const __m128 gainVec = _mm_load_ps(gains);
+    __m128 sumVec = _mm_setzero_ps();
+
+    const size_t samplesCount = samplesPerChannel * audioChannelsCount;
+    size_t i = 0;
+
+    for (; i + LANES <= samplesCount; i += LANES) {
+        __m128 result = _mm_mul_ps(_mm_loadu_ps(buffer + i), gainVec);
+        _mm_storeu_ps(buffer + i, result);
+        sumVec = _mm_add_ps(sumVec, _mm_mul_ps(result, result));
+    }
+
+    alignas(16) float sums[LANES];
+    _mm_store_ps(sums, sumVec);
+    for (size_t l = 0; l < LANES; ++l) {
+        squaredSums[l % audioChannelsCount] += sums[l];
+    }
+
+    applyChannelGainsAndMeasureFrom(buffer, audioChannelsCount, i / audioChannelsCount, samplesPerChannel,
+                                    channelGains, squaredSums);
+}
+
+constexpr KernelTable SSE2_KERNELS = {
+    mixAddSse2,
+    applyGainSse2,
+    applyChannelGainsAndMeasureSse2
+};
+
+// ===== AVX2 =====
+
+MU_AUDIO_AVX2_TARGET void mixAddAvx2(float* dst, const float* src, size_t samplesCount)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= samplesCount; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    }
+
+    mixAddScalar(dst + i, src + i, samplesCount - i);
+}
+
+MU_AUDIO_AVX2_TARGET void applyGainAvx2(float* buffer, size_t samplesCount, gain_t gain)
+{
+    const __m256 gainVec = _mm256_set1_ps(gain);
+    size_t i = 0;
+
+    for (; i + 8 <= samplesCount; i += 8) {
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), gainVec));
+    }
+
+    applyGainScalar(buffer + i, samplesCount - i, gain);
+}
+
+MU_AUDIO_AVX2_TARGET void applyChannelGainsAndMeasureAvx2(float* buffer, audioch_t audioChannelsCount,
+                                                          samples_t samplesPerChannel, const gain_t* channelGains,
+                                                          float* squaredSums)
+{
+    constexpr size_t LANES = 8;
+
+    if (!isVectorizableLayout(audioChannelsCount, LANES)) {
+        applyChannelGainsAndMeasureScalar(buffer, audioChannelsCount, samplesPerChannel, channelGains, squaredSums);
+        return;
+    }
+
+    alignas(32) float gains[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+        gains[l] = channelGains[l % audioChannelsCount];
+    }
+
+    const __m256 gainVec = _mm256_load_ps(gains);
+    __m256 sumVec = _mm256_setzero_ps();
+
+    const size_t samplesCount = samplesPerChannel * audioChannelsCount;
+    size_t i = 0;
+
+    for (; i + LANES <= samplesCount; i += LANES) {
+        __m256 result = _mm256_mul_ps(_mm256_loadu_ps(buffer + i), gainVec);
+        _mm256_storeu_ps(buffer + i, result);
+        sumVec = _mm256_add_ps(sumVec, _mm256_mul_ps(result, result));
+    }
+
+    alignas(32) float sums[LANES];
+    _mm256_store_ps(sums, sumVec);
+    for (size_t l = 0; l < LANES; ++l) {
+        squaredSums[l % audioChannelsCount] += sums[l];
+    }
+
+    applyChannelGainsAndMeasureFrom(buffer, audioChannelsCount, i / audioChannelsCount, samplesPerChannel,
+                                    channelGains, squaredSums);
+}
+
+constexpr KernelTable AVX2_KERNELS = {
+    mixAddAvx2,
+    applyGainAvx2,
+    applyChannelGainsAndMeasureAvx2
+};
+
+bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = { 0 };
+    __cpuid(info, 1);
+
+    bool osUsesXsave = (info[2] & (1 << 27)) != 0;
+    bool cpuHasAvx = (info[2] & (1 << 28)) != 0;
+    if (!osUsesXsave || !cpuHasAvx) {
+        return false;
+    }
+
+    //! NOTE The OS must save the YMM registers on context switches
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // MU_AUDIO_KERNELS_X86
+
+#ifdef MU_AUDIO_KERNELS_NEON
+
+// ===== NEON =====
+
+void mixAddNeon(float* dst, const float* src, size_t samplesCount)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= samplesCount; i += 4) {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+    }
+
+    mixAddScalar(dst + i, src + i, samplesCount - i);
+}
+
+void applyGainNeon(float* buffer, size_t samplesCount, gain_t gain)
+{
+    const float32x4_t gainVec = vdupq_n_f32(gain);
+    size_t i = 0;
+
+    for (; i + 4 <= samplesCount; i += 4) {
+        vst1q_f32(buffer + i, vmulq_f32(vld1q_f32(buffer + i), gainVec));
+    }
+
+    applyGainScalar(buffer + i, samplesCount - i, gain);
+}
+
+void applyChannelGainsAndMeasureNeon(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                     const gain_t* channelGains, float* squaredSums)
+{
+    constexpr size_t LANES = 4;
+
+    if (!isVectorizableLayout(audioChannelsCount, LANES)) {
+        applyChannelGainsAndMeasureScalar(buffer, audioChannelsCount, samplesPerChannel, channelGains, squaredSums);
+        return;
+    }
+
+    float gains[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+        gains[l] = channelGains[l % audioChannelsCount];
+    }
+
+    const float32x4_t gainVec = vld1q_f32(gains);
+    float32x4_t sumVec = vdupq_n_f32(0.f);
+
+    const size_t samplesCount = samplesPerChannel * audioChannelsCount;
+    size_t i = 0;
+
+    for (; i + LANES <= samplesCount; i += LANES) {
+        float32x4_t result = vmulq_f32(vld1q_f32(buffer + i), gainVec);
+        vst1q_f32(buffer + i, result);
+        sumVec = vaddq_f32(sumVec, vmulq_f32(result, result));
+    }
+
+    float sums[LANES];
+    vst1q_f32(sums, sumVec);
+    for (size_t l = 0; l < LANES; ++l) {
+        squaredSums[l % audioChannelsCount] += sums[l];
+    }
+
+    applyChannelGainsAndMeasureFrom(buffer, audioChannelsCount, i / audioChannelsCount, samplesPerChannel,
+                                    channelGains, squaredSums);
+}
+
+constexpr KernelTable NEON_KERNELS = {
+    mixAddNeon,
+    applyGainNeon,
+    applyChannelGainsAndMeasureNeon
+};
+
+#endif // MU_AUDIO_KERNELS_NEON
+
+SimdLevel supportedSimdLevel()
+{
+#if defined(MU_AUDIO_KERNELS_X86)
+    return cpuSupportsAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#elif defined(MU_AUDIO_KERNELS_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const KernelTable* kernelTable(SimdLevel level)
+{
+    switch (level) {
+#ifdef MU_AUDIO_KERNELS_X86
+    case SimdLevel::AVX2: return &AVX2_KERNELS;
+    case SimdLevel::SSE2: return &SSE2_KERNELS;
+#endif
+#ifdef MU_AUDIO_KERNELS_NEON
+    case SimdLevel::NEON: return &NEON_KERNELS;
+#endif
+    default: break;
+    }
+
+    return &SCALAR_KERNELS;
+}
+
+struct KernelsState {
+    const SimdLevel supportedLevel = supportedSimdLevel();
+    std::atomic<SimdLevel> level { supportedLevel };
+    std::atomic<const KernelTable*> table { kernelTable(supportedLevel) };
+};
+
+KernelsState& kernelsState()
+{
+    static KernelsState state;
+    return state;
+}
+
+const KernelTable& kernels()
+{
+    return *kernelsState().table.load(std::memory_order_relaxed);
+}
+}
+
+SimdLevel mu::audio::dsp::simdLevel()
+{
+    return kernelsState().level.load(std::memory_order_relaxed);
+}
+
+const char* mu::audio::dsp::simdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::Scalar: return "Scalar";
+    case SimdLevel::SSE2: return "SSE2";
+    case SimdLevel::AVX2: return "AVX2";
+    case SimdLevel::NEON: return "NEON";
+    }
+
+    return "Unknown";
+}
+
+void mu::audio::dsp::setSimdLevel(SimdLevel level)
+{
+    KernelsState& state = kernelsState();
+
+    //! NOTE AVX2 implies SSE2, NEON is the only level on ARM
+    if (level > state.supportedLevel || (level == SimdLevel::NEON) != (state.supportedLevel == SimdLevel::NEON)) {
+        level = level == SimdLevel::Scalar ? SimdLevel::Scalar : state.supportedLevel;
+    }
+
+    state.level.store(level, std::memory_order_relaxed);
+    state.table.store(kernelTable(level), std::memory_order_relaxed);
+}
+
+void mu::audio::dsp::mixAdd(float* dst, const float* src, size_t samplesCount)
+{
+    kernels().mixAdd(dst, src, samplesCount);
+}
+
+void mu::audio::dsp::applyGain(float* buffer, size_t samplesCount, gain_t gain)
+{
+    kernels().applyGain(buffer, samplesCount, gain);
+}
+
+void mu::audio::dsp::applyChannelGainsAndMeasure(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                                 const gain_t* channelGains, float* squaredSums)
+{
+    kernels().applyChannelGainsAndMeasure(buffer, audioChannelsCount, samplesPerChannel, channelGains, squaredSums);
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_DSP_AUDIOKERNELS_H
+#define MU_AUDIO_DSP_AUDIOKERNELS_H
+
+#include <cstddef>
+
+#include "audiotypes.h"
+
+//! NOTE Vectorized loops over interleaved sample buffers, used by the mixer and the dynamics processors.
+//! The implementation (SSE2, AVX2, NEON or scalar) is selected once at runtime, depending on the CPU.
+//! Element-wise kernels give the same results as the scalar code, the sums may differ
+//! in the last bits, because the vector paths accumulate in several lanes
+namespace mu::audio::dsp {
+enum class SimdLevel {
+    Scalar = 0,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+SimdLevel simdLevel();
+const char* simdLevelName(SimdLevel level);
+
+//! NOTE For tests and benchmarks. The level is clamped to what the CPU supports
+void setSimdLevel(SimdLevel level);
+
+//! dst[i] += src[i]
+void mixAdd(float* dst, const float* src, size_t samplesCount);
+
+//! buffer[i] *= gain
+void applyGain(float* buffer, size_t samplesCount, gain_t gain);
+
+//! Multiplies every audio channel of the interleaved buffer by its own gain (volume and balance)
+//! and accumulates the sum of squares of the result for every channel into squaredSums
+void applyChannelGainsAndMeasure(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                 const gain_t* channelGains, float* squaredSums);
+}
+
+#endif // MU_AUDIO_DSP_AUDIOKERNELS_H
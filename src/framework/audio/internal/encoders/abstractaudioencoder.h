@@ -43,8 +43,10 @@ public:
         closeDestination();
     }
 
-    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel)
     {
+        UNUSED(totalSamplesPerChannel);
+
         if (!format.isValid()) {
             return false;
         }
@@ -55,8 +57,6 @@ public:
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
-
         return true;
     }
 
@@ -65,11 +65,13 @@ public:
         return m_format;
     }
 
+    //! NOTE Encodes the next chunk of the interleaved input stream and writes it to the destination.
+    //! May be called any number of times before flush(). Returns the number of consumed samples per channel, 0 on failure
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
     virtual bool openDestination(const io::path_t& path)
     {
@@ -82,9 +84,12 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    virtual void prepareOutputBuffer(const samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        size_t requiredSize = requiredOutputBufferSize(samplesPerChannel);
+        if (m_outputBuffer.size() < requiredSize) {
+            m_outputBuffer.resize(requiredSize);
+        }
     }
 
     virtual void closeDestination()
@@ -49,7 +49,7 @@ struct FlacHandler : public FLAC::Encoder::File
     }
 };
 
-bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel)
 {
     if (!format.isValid()) {
         return false;
@@ -64,7 +64,7 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
         || !m_flac->set_channels(m_format.audioChannelsNumber)
         || !m_flac->set_sample_rate(m_format.sampleRate)
         || !m_flac->set_bits_per_sample(16)
-        || !m_flac->set_total_samples_estimate(totalSamplesNumber)) {
+        || !m_flac->set_total_samples_estimate(totalSamplesPerChannel)) {
         return false;
     }
 
@@ -84,8 +84,6 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
         return false;
     }
 
-    prepareOutputBuffer(totalSamplesNumber);
-
     return true;
 }
 
@@ -95,30 +93,20 @@ size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    size_t result = 0;
-    size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
-
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
-
-    for (size_t i = 0; i < buff.size(); ++i) {
-        buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    if (m_flacBuffer.size() < samplesNumber) {
+        m_flacBuffer.resize(samplesNumber);
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
-
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
+    for (size_t i = 0; i < samplesNumber; ++i) {
+        m_flacBuffer[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    }
 
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+    if (!m_flac->process_interleaved(m_flacBuffer.data(), static_cast<uint32_t>(samplesPerChannel))) {
+        return 0;
     }
 
-    return result;
+    return samplesPerChannel;
 }
 
 size_t FlacEncoder::flush()
@@ -127,9 +115,10 @@ size_t FlacEncoder::flush()
     return 0;
 }
 
-size_t FlacEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t FlacEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    //! NOTE The FLAC encoder writes to the destination by itself
+    return 0;
 }
 
 bool FlacEncoder::openDestination(const io::path_t& path)
@@ -91,26 +91,40 @@ private:
     SoundTrackFormat m_format;
 };
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t samplesPerChannel) const
 {
-    //!Note See thirdparty/lame/API
+    //!Note See thirdparty/lame/API, worst case estimate is 1.25 * samples + 7200 bytes
 
-    return totalSamplesNumber;
+    return 5 * samplesPerChannel / 4 + 7200;
 }
 
 size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
 {
     LameHandler::instance()->updateSpec(m_format);
 
+    prepareOutputBuffer(samplesPerChannel);
+
     int encodedBytes = lame_encode_buffer_interleaved_ieee_float(LameHandler::instance()->flags, input, samplesPerChannel,
                                                                  m_outputBuffer.data(),
                                                                  static_cast<int>(m_outputBuffer.size()));
 
-    return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+    if (encodedBytes < 0) {
+        LOGE() << "failed encode, err: " << encodedBytes;
+        return 0;
+    }
+
+    //! NOTE lame may keep small chunks in its internal buffer, so encodedBytes == 0 is a valid result
+    if (std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream) != static_cast<size_t>(encodedBytes)) {
+        return 0;
+    }
+
+    return samplesPerChannel;
 }
 
 size_t Mp3Encoder::flush()
 {
+    prepareOutputBuffer(0);
+
     int encodedBytes = lame_encode_flush(LameHandler::instance()->flags,
                                          m_outputBuffer.data(),
                                          static_cast<int>(m_outputBuffer.size()));
@@ -31,12 +31,17 @@ using namespace mu::audio::encode;
 
 size_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    return ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel + m_format.sampleRate * 2);
+    if (ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel) != OPE_OK) {
+        return 0;
+    }
+
+    return samplesPerChannel;
 }
 
 size_t OggEncoder::flush()
 {
-    return ope_encoder_flush_header(m_opusEncoder);
+    //! NOTE Pads and encodes the samples still held by the encoder, then finalizes the stream
+    return ope_encoder_drain(m_opusEncoder);
 }
 
 size_t OggEncoder::requiredOutputBufferSize(samples_t /*totalSamplesNumber*/) const
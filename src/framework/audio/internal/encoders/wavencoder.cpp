@@ -87,43 +87,64 @@ size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    WavHeader header;
-    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
-    header.bitsPerSample = 32;
-    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
-
-    header.write(m_fileStream);
+    size_t bytesCount = samplesPerChannel * m_format.audioChannelsNumber * sizeof(float);
+    m_fileStream.write(reinterpret_cast<const char*>(input), bytesCount);
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+    if (!m_fileStream.good()) {
+        return 0;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    m_writtenSamplesPerChannel += samplesPerChannel;
+
+    return samplesPerChannel;
 }
 
 size_t WavEncoder::flush()
 {
-    NOT_SUPPORTED;
+    if (!m_fileStream.is_open()) {
+        return 0;
+    }
 
-    return 0;
+    //! NOTE The data size isn't known until the whole stream is written, so rewrite the header with the final values
+    std::streampos endPos = m_fileStream.tellp();
+    m_fileStream.seekp(0);
+    writeHeader();
+    m_fileStream.seekp(endPos);
+    m_fileStream.flush();
+
+    return m_writtenSamplesPerChannel;
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t WavEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
 {
     m_fileStream.open(path.toStdString(), std::ios_base::binary);
 
-    return m_fileStream.is_open();
+    if (!m_fileStream.is_open()) {
+        return false;
+    }
+
+    m_writtenSamplesPerChannel = 0;
+    writeHeader();
+
+    return m_fileStream.good();
+}
+
+void WavEncoder::writeHeader()
+{
+    WavHeader header;
+    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
+    header.bitsPerSample = 32;
+    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
+    header.audioChannelsNumber = m_format.audioChannelsNumber;
+    header.sampleRate = m_format.sampleRate;
+    header.samplesPerChannel = m_writtenSamplesPerChannel;
+
+    header.write(m_fileStream);
 }
 
 void WavEncoder::closeDestination()
@@ -44,8 +44,7 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
+    m_totalSamplesPerChannel = (totalDuration / 1000.f) * format.sampleRate;
     m_intermBuffer.resize(INTERNAL_BUFFER_SIZE);
 
     m_encoderPtr = createEncoder(format.type);
@@ -54,7 +53,10 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
+    if (!m_encoderPtr->init(destination, format, m_totalSamplesPerChannel)) {
+        LOGE() << "failed init encoder, path: " << destination;
+        m_encoderPtr = nullptr;
+    }
 }
 
 bool SoundTrackWriter::write()
@@ -70,22 +72,22 @@ bool SoundTrackWriter::write()
     m_source->setSampleRate(m_encoderPtr->format().sampleRate);
     m_source->setIsActive(true);
 
-    if (!prepareInputBuffer()) {
-        return false;
-    }
-
-    if (m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data()) == 0) {
-        return false;
+    bool ok = writeStream();
+    if (ok) {
+        m_encoderPtr->flush();
     }
 
-    m_encoderPtr->flush();
-
     m_source->setSampleRate(AudioEngine::instance()->sampleRate());
     m_source->setIsActive(false);
 
     AudioEngine::instance()->setMode(AudioEngine::Mode::RealTimeMode);
 
-    return true;
+    return ok;
+}
+
+framework::ProgressChannel SoundTrackWriter::progress() const
+{
+    return m_progress;
 }
 
 encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrackType& type) const
@@ -99,26 +101,30 @@ encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrack
     }
 }
 
-bool SoundTrackWriter::prepareInputBuffer()
+bool SoundTrackWriter::writeStream()
 {
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    //! NOTE Render a block, encode it and write it right away,
+    //! so the memory usage doesn't depend on the score duration
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
+        return false;
+    }
 
-    while (inputBufferOffset < inputBufferMaxOffset) {
-        m_source->process(m_intermBuffer.data(), SAMPLES_PER_CHANNEL);
+    samples_t writtenSamplesPerChannel = 0;
 
-        size_t samplesToCopy = std::min(INTERNAL_BUFFER_SIZE, inputBufferMaxOffset - inputBufferOffset);
+    while (writtenSamplesPerChannel < m_totalSamplesPerChannel) {
+        samples_t samplesToWrite = std::min(SAMPLES_PER_CHANNEL, m_totalSamplesPerChannel - writtenSamplesPerChannel);
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        m_source->process(m_intermBuffer.data(), samplesToWrite);
 
-        inputBufferOffset += samplesToCopy;
-    }
+        if (m_encoderPtr->encode(samplesToWrite, m_intermBuffer.data()) == 0) {
+            LOGE() << "failed encode, written samples: " << writtenSamplesPerChannel;
+            return false;
+        }
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return false;
+        writtenSamplesPerChannel += samplesToWrite;
+
+        m_progress.send(framework::Progress(writtenSamplesPerChannel, m_totalSamplesPerChannel));
     }
 
     return true;
@@ -26,6 +26,8 @@
 #include <vector>
 #include <cstdio>
 
+#include "progress.h"
+
 #include "audiotypes.h"
 #include "iaudiosource.h"
 #include "internal/encoders/abstractaudioencoder.h"
@@ -38,16 +40,20 @@ public:
 
     bool write();
 
+    framework::ProgressChannel progress() const;
+
 private:
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
-    bool prepareInputBuffer();
+    bool writeStream();
 
     IAudioSourcePtr m_source = nullptr;
 
-    std::vector<float> m_inputBuffer;
+    samples_t m_totalSamplesPerChannel = 0;
     std::vector<float> m_intermBuffer;
 
     encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+
+    framework::ProgressChannel m_progress;
 };
 }
 
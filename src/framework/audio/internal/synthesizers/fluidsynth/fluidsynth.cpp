@@ -394,10 +394,19 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
         return 0;
     }
 
-    if (isActive()) {
-        handleMainStreamEvents(nextMsecs);
-    } else {
-        handleOffStreamEvents(nextMsecs);
+    {
+        //! NOTE Fluid changes the shared sound-fonts only in its API calls: it releases the samples of the finished voices
+        //!      when entering any of them and takes the samples for the new voices. The rendering only reads the samples,
+        //!      so it runs unlocked, once the finished voices are released here
+        std::lock_guard<std::mutex> lock(SoundFontCache::instance()->mutex);
+
+        fluid_synth_get_active_voice_count(m_fluid->synth);
+
+        if (isActive()) {
+            handleMainStreamEvents(nextMsecs);
+        } else {
+            handleOffStreamEvents(nextMsecs);
+        }
     }
 
     int result = fluid_synth_write_float(m_fluid->synth, samplesPerChannel,
@@ -426,13 +435,10 @@ void FluidSynth::handleMainStreamEvents(const msecs_t nextMsecs)
 
     msecs_t to = from + nextMsecs;
 
-    EventsMapIteratorList range = m_mainStreamEvents.findEventsRange(from, to);
-
-    for (const auto& it : range) {
-        for (const PlaybackEvent& event : it->second) {
-            if (handleNoteOnEvents(event, from, from + nextMsecs)) {
-                m_playingEvents.emplace_back(event);
-            }
+    for (uint32_t idx : m_mainStreamEvents.findEvents(from, to)) {
+        PlaybackEvent event = m_mainStreamEvents.event(idx);
+        if (handleNoteOnEvents(event, from, from + nextMsecs)) {
+            m_playingEvents.emplace_back(std::move(event));
         }
     }
 
@@ -446,13 +452,10 @@ void FluidSynth::handleOffStreamEvents(const msecs_t nextMsecs)
     msecs_t from = m_offStreamEvents.from;
     msecs_t to = m_offStreamEvents.to;
 
-    EventsMapIteratorList range = m_offStreamEvents.findEventsRange(from, to);
-
-    for (const auto& it : range) {
-        for (const PlaybackEvent& event : it->second) {
-            if (handleNoteOnEvents(event, from, from + nextMsecs)) {
-                m_playingEvents.emplace_back(event);
-            }
+    for (uint32_t idx : m_offStreamEvents.findEvents(from, from + nextMsecs)) {
+        PlaybackEvent event = m_offStreamEvents.event(idx);
+        if (handleNoteOnEvents(event, from, from + nextMsecs)) {
+            m_playingEvents.emplace_back(std::move(event));
         }
     }
 
@@ -23,6 +23,12 @@
 #ifndef MU_AUDIO_SFCACHEDLOADER_H
 #define MU_AUDIO_SFCACHEDLOADER_H
 
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include <QFile>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,28 +40,66 @@ extern "C" {
 
 #include <sfloader/fluid_sfont.h>
 #include <sfloader/fluid_defsfont.h>
+#include <sfloader/fluid_samplecache.h>
 
 #include "log.h"
 
 namespace mu::audio::synth {
+//! NOTE The sound-font file is mapped into memory read-only, so the sample data is used right from the mapped pages.
+//!      These pages belong to the page cache of the OS, so they are shared by all Fluid instances and all processes
+//!      that play the same sound-font, instead of being copied into the private heap of each of them
+struct SoundFontFile
+{
+    QFile file;
+    const uchar* data = nullptr; //! NOTE nullptr if the file couldn't be mapped, then it is read
+    qint64 size = 0;
+    std::mutex readMutex;
+};
+
+//! NOTE Every file opened by Fluid gets its own position in the shared file
+struct SoundFontStream
+{
+    SoundFontFile* file = nullptr;
+    qint64 pos = 0;
+};
+
 struct SoundFontData
 {
     fluid_sfont_t* soundFontPtr = nullptr;
-    std::FILE* fileStream = nullptr;
+    std::unique_ptr<SoundFontFile> file;
 };
 
 struct SoundFontCache : public std::map<std::string, SoundFontData> {
+    //! NOTE How much of the decoded SF3 samples that are not used by any selected preset anymore is kept,
+    //!      so that they don't have to be decoded again when the preset is selected again
+    static constexpr size_t UNUSED_SAMPLES_CACHE_SIZE = 128 * 1024 * 1024;
+
     static SoundFontCache* instance()
     {
         static SoundFontCache s;
         return &s;
     }
 
+    //! NOTE The cached sound-fonts are shared by all Fluid instances, but Fluid doesn't guard their state:
+    //!      the reference counts of the samples and the loading and unloading of the samples of selected presets.
+    //!      Any Fluid call, that may run while other instances render on the mixer threads, has to hold this mutex
+    std::mutex mutex;
+
 private:
-    SoundFontCache() = default;
+    SoundFontCache()
+    {
+        fluid_samplecache_set_unused_limit(UNUSED_SAMPLES_CACHE_SIZE);
+    }
+
     ~SoundFontCache()
     {
+        fluid_samplecache_set_unused_limit(0);
+
         for (const auto& pair : *this) {
+            if (!pair.second.soundFontPtr) {
+                continue;
+            }
+
             fluid_defsfont_t* defsFont = static_cast<fluid_defsfont_t*>(fluid_sfont_get_data(pair.second.soundFontPtr));
 
             if (delete_fluid_defsfont(defsFont) != FLUID_OK) {
@@ -63,55 +107,113 @@ private:
             }
 
             delete_fluid_sfont(pair.second.soundFontPtr);
-
-            if (pair.second.fileStream) {
-                std::fclose(pair.second.fileStream);
-            }
         }
     }
 };
 
 void* openSoundFont(const char* filename)
 {
-    auto search = SoundFontCache::instance()->find(filename);
+    SoundFontCache* cache = SoundFontCache::instance();
+    auto search = cache->find(filename);
 
-    if (search != SoundFontCache::instance()->cend()
-        && search->second.fileStream) {
-        return search->second.fileStream;
-    }
+    if (search == cache->end() || !search->second.file) {
+        auto file = std::make_unique<SoundFontFile>();
+        file->file.setFileName(QString::fromUtf8(filename));
+
+        if (!file->file.open(QIODevice::ReadOnly)) {
+            LOGE() << "failed open sound-font file: " << filename;
+            return nullptr;
+        }
+
+        file->size = file->file.size();
+        file->data = file->file.map(0, file->size);
 
-    std::FILE* stream = std::fopen(filename, "r");
+        if (!file->data) {
+            LOGW() << "failed map sound-font file, it will be read instead: " << filename;
+        }
 
-    SoundFontData sfData;
-    sfData.fileStream = stream;
+        search = cache->insert_or_assign(filename, SoundFontData()).first;
+        search->second.file = std::move(file);
+    }
 
-    SoundFontCache::instance()->emplace(filename, std::move(sfData));
+    SoundFontStream* stream = new SoundFontStream();
+    stream->file = search->second.file.get();
 
     return stream;
 }
 
 int readSoundFont(void* buf, int count, void* handle)
 {
-    return static_cast<int>(std::fread(buf, count, 1, static_cast<std::FILE*>(handle)));
+    SoundFontStream* stream = static_cast<SoundFontStream*>(handle);
+    SoundFontFile* file = stream->file;
+
+    if (count < 0 || stream->pos + count > file->size) {
+        return FLUID_FAILED;
+    }
+
+    if (file->data) {
+        std::memcpy(buf, file->data + stream->pos, static_cast<size_t>(count));
+    } else {
+        std::lock_guard<std::mutex> lock(file->readMutex);
+
+        if (!file->file.seek(stream->pos) || file->file.read(static_cast<char*>(buf), count) != count) {
+            return FLUID_FAILED;
+        }
+    }
+
+    stream->pos += count;
+
+    return FLUID_OK;
 }
 
 int seekSoundFont(void* handle, long offset, int origin)
 {
-    return std::fseek(static_cast<std::FILE*>(handle), offset, origin);
+    SoundFontStream* stream = static_cast<SoundFontStream*>(handle);
+    qint64 pos = offset;
+
+    switch (origin) {
+    case SEEK_SET: break;
+    case SEEK_CUR: pos += stream->pos;
+        break;
+    case SEEK_END: pos += stream->file->size;
+        break;
+    default:
+        return FLUID_FAILED;
+    }
+
+    if (pos < 0 || pos > stream->file->size) {
+        return FLUID_FAILED;
+    }
+
+    stream->pos = pos;
+
+    return FLUID_OK;
 }
 
-int closeSoundFont(void* /*handle*/)
+int closeSoundFont(void* handle)
 {
-    //!Note Prevent closing of sound-font files by Fluid instances,
-    //!     instead the actual closing of cached sound-font files will happen in SoundFontCache.
-    //!     However, we still need to provide "some" callback for Fluid's API
+    //!Note Only the position of Fluid in the file is released,
+    //!     the actual closing of cached sound-font files will happen in SoundFontCache.
+
+    delete static_cast<SoundFontStream*>(handle);
 
     return FLUID_OK;
 }
 
 long tellSoundFont(void* handle)
 {
-    return std::ftell(static_cast<std::FILE*>(handle));
+    return static_cast<long>(static_cast<SoundFontStream*>(handle)->pos);
+}
+
+const void* mapSoundFont(void* handle, long offset, long count)
+{
+    const SoundFontFile* file = static_cast<SoundFontStream*>(handle)->file;
+
+    if (!file->data || offset < 0 || count < 0 || offset + count > file->size) {
+        return nullptr;
+    }
+
+    return file->data + offset;
 }
 
 int deleteSoundFont(fluid_sfont_t* /*sfont*/)
@@ -128,13 +230,14 @@ static fluid_file_callbacks_t FILE_CALLBACKS {
     readSoundFont,
     seekSoundFont,
     closeSoundFont,
-    tellSoundFont
+    tellSoundFont,
+    mapSoundFont
 };
 
 fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename)
 {
     auto search = SoundFontCache::instance()->find(filename);
-    if (search != SoundFontCache::instance()->cend()) {
+    if (search != SoundFontCache::instance()->cend() && search->second.soundFontPtr) {
         return search->second.soundFontPtr;
     }
 
@@ -126,6 +126,17 @@ void AudioEngine::setAudioChannelsCount(const audioch_t count)
     m_mixer->setAudioChannelsCount(count);
 }
 
+void AudioEngine::setMixerThreadsCount(const size_t count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_mixer) {
+        return;
+    }
+
+    m_mixer->setProcessingThreadsCount(count);
+}
+
 void AudioEngine::setMode(const Mode newMode)
 {
     if (newMode == m_currentMode) {
@@ -141,6 +152,17 @@ void AudioEngine::setMode(const Mode newMode)
     }
 }
 
+bool AudioEngine::isIdle() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (!m_inited || m_currentMode != Mode::RealTimeMode) {
+        return true;
+    }
+
+    return m_mixer->isIdle();
+}
+
 MixerPtr AudioEngine::mixer() const
 {
     ONLY_AUDIO_WORKER_THREAD;
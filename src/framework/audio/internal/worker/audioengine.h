@@ -54,8 +54,12 @@ public:
     void setSampleRate(unsigned int sampleRate);
     void setReadBufferSize(uint16_t readBufferSize);
     void setAudioChannelsCount(const audioch_t count);
+    void setMixerThreadsCount(const size_t count);
     void setMode(const Mode newMode);
 
+    //! NOTE There is nothing to render until a new event arrives
+    bool isIdle() const;
+
     MixerPtr mixer() const;
 
 private:
@@ -171,7 +171,11 @@ Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
 Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                  const SoundTrackFormat& format)
 {
-    return Promise<bool>([this, sequenceId, destination, format](auto resolve, auto reject) {
+    ONLY_AUDIO_MAIN_THREAD;
+
+    framework::ProgressChannel progress = m_saveSoundTracksProgressMap[sequenceId];
+
+    Promise<bool> promise = Promise<bool>([this, sequenceId, destination, format, progress](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
@@ -187,12 +191,33 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
         s->player()->seek(0);
         msecs_t totalDuration = s->player()->duration();
         SoundTrackWriter writer(destination, format, totalDuration, mixer());
+        writer.progress().onReceive(this, [progress](const framework::Progress& p) mutable {
+            progress.send(p);
+        });
 
         return resolve(writer.write());
 #else
         return reject(static_cast<int>(Err::DisabledAudioExport), "audio export is disabled");
 #endif
     }, AudioThread::ID);
+
+    //! NOTE The export is over, the subscribers already hold the channel
+    promise.onResolve(this, [this, sequenceId](const bool) {
+        m_saveSoundTracksProgressMap.erase(sequenceId);
+    });
+
+    promise.onReject(this, [this, sequenceId](int, const std::string&) {
+        m_saveSoundTracksProgressMap.erase(sequenceId);
+    });
+
+    return promise;
+}
+
+framework::ProgressChannel AudioOutputHandler::saveSoundTrackProgress(const TrackSequenceId sequenceId)
+{
+    ONLY_AUDIO_MAIN_THREAD;
+
+    return m_saveSoundTracksProgressMap[sequenceId];
 }
 
 std::shared_ptr<Mixer> AudioOutputHandler::mixer() const
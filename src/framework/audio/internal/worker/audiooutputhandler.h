@@ -23,6 +23,8 @@
 #ifndef MU_AUDIO_AUDIOIOHANDLER_H
 #define MU_AUDIO_AUDIOIOHANDLER_H
 
+#include <unordered_map>
+
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 
@@ -54,6 +56,7 @@ public:
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    framework::ProgressChannel saveSoundTrackProgress(const TrackSequenceId sequenceId) override;
 
 private:
     std::shared_ptr<Mixer> mixer() const;
@@ -65,6 +68,8 @@ private:
 
     mutable async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     mutable async::Channel<TrackSequenceId, TrackId, AudioOutputParams> m_outputParamsChanged;
+
+    std::unordered_map<TrackSequenceId, framework::ProgressChannel> m_saveSoundTracksProgressMap;
 };
 }
 
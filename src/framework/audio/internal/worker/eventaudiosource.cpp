@@ -36,8 +36,8 @@ EventAudioSource::EventAudioSource(const TrackId trackId, const mpe::PlaybackDat
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    m_playbackData.mainStream.onReceive(this, [this](const PlaybackEventsMap& events) {
-        m_playbackData.originEvents = events;
+    m_playbackData.mainStream.onReceive(this, [this](const PlaybackEventsDelta& delta) {
+        delta.apply(m_playbackData.originEvents);
     });
 }
 
@@ -48,7 +48,7 @@ EventAudioSource::~EventAudioSource()
 
 bool EventAudioSource::isActive() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     if (!m_synth) {
         return false;
@@ -84,7 +84,7 @@ void EventAudioSource::setSampleRate(unsigned int sampleRate)
 
 unsigned int EventAudioSource::audioChannelsCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     if (!m_synth) {
         return 0;
@@ -106,7 +106,7 @@ async::Channel<unsigned int> EventAudioSource::audioChannelsCountChanged() const
 
 samples_t EventAudioSource::process(float* buffer, samples_t samplesPerChannel)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     if (!m_synth) {
         return 0;
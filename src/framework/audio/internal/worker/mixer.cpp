@@ -29,6 +29,7 @@
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/audiokernels.h"
 #include "audioerrors.h"
 
 using namespace mu;
@@ -64,6 +65,7 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, IAudioSourcePtr
     }
 
     m_mixerChannels.emplace(trackId, std::make_shared<MixerChannel>(trackId, std::move(source), m_sampleRate));
+    updateChannelsList();
 
     result.val = m_mixerChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -79,6 +81,7 @@ Ret Mixer::removeChannel(const TrackId id)
 
     if (search != m_mixerChannels.end() && search->second) {
         m_mixerChannels.erase(id);
+        updateChannelsList();
         return make_ret(Ret::Code::Ok);
     }
 
@@ -92,6 +95,30 @@ void Mixer::setAudioChannelsCount(const audioch_t count)
     m_audioChannelsCount = count;
 }
 
+void Mixer::setProcessingThreadsCount(const size_t count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_threadPool && m_threadPool->threadsCount() == count) {
+        return;
+    }
+
+    m_threadPool = count > 0 ? std::make_shared<MixerThreadPool>(count) : nullptr;
+}
+
+void Mixer::updateChannelsList()
+{
+    m_channelsList.clear();
+    m_channelsList.reserve(m_mixerChannels.size());
+
+    for (const auto& pair : m_mixerChannels) {
+        m_channelsList.push_back(pair.second.get());
+    }
+
+    m_channelBuffers.resize(m_channelsList.size());
+    m_channelProcessedSamples.resize(m_channelsList.size(), 0);
+}
+
 void Mixer::setSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -122,20 +149,16 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 
     std::fill(outBuffer, outBuffer + samplesPerChannel * audioChannelsCount(), 0.f);
 
-    if (m_writeCacheBuff.size() != samplesPerChannel * audioChannelsCount()) {
-        m_writeCacheBuff.resize(samplesPerChannel * audioChannelsCount(), 0.f);
-    }
-
     samples_t masterChannelSampleCount = 0;
 
-    for (auto& channel : m_mixerChannels) {
-        samples_t processedSamplesCount = channel.second->process(m_writeCacheBuff.data(), samplesPerChannel);
-        mixOutputFromChannel(outBuffer, m_writeCacheBuff.data(), processedSamplesCount);
-        std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
-
-        masterChannelSampleCount = std::max(processedSamplesCount, masterChannelSampleCount);
+    if (m_threadPool && m_channelsList.size() > 1) {
+        masterChannelSampleCount = processChannelsInParallel(outBuffer, samplesPerChannel);
+    } else {
+        masterChannelSampleCount = processChannelsSerially(outBuffer, samplesPerChannel);
     }
 
+    m_isSilent = masterChannelSampleCount == 0;
+
     if (m_masterParams.muted || masterChannelSampleCount == 0) {
         for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
             notifyAboutAudioSignalChanges(audioChNum, 0);
@@ -154,6 +177,74 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     return masterChannelSampleCount;
 }
 
+samples_t Mixer::processChannelsSerially(float* outBuffer, samples_t samplesPerChannel)
+{
+    if (m_writeCacheBuff.size() != samplesPerChannel * audioChannelsCount()) {
+        m_writeCacheBuff.resize(samplesPerChannel * audioChannelsCount(), 0.f);
+    }
+
+    samples_t masterChannelSampleCount = 0;
+
+    for (MixerChannel* channel : m_channelsList) {
+        samples_t processedSamplesCount = channel->process(m_writeCacheBuff.data(), samplesPerChannel);
+        mixOutputFromChannel(outBuffer, m_writeCacheBuff.data(), processedSamplesCount);
+        std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
+
+        masterChannelSampleCount = std::max(processedSamplesCount, masterChannelSampleCount);
+    }
+
+    return masterChannelSampleCount;
+}
+
+samples_t Mixer::processChannelsInParallel(float* outBuffer, samples_t samplesPerChannel)
+{
+    size_t bufferSize = samplesPerChannel * audioChannelsCount();
+
+    for (std::vector<float>& buffer : m_channelBuffers) {
+        if (buffer.size() != bufferSize) {
+            buffer.resize(bufferSize, 0.f);
+        }
+    }
+
+    //! NOTE Every channel only touches its own source, fx chain and buffer,
+    //! the shared output is summed up and the signal changes are sent afterwards on the worker.
+    //! The soundfonts, that are shared by all Fluid synths, are guarded by FluidSynth itself
+    m_threadPool->run(m_channelsList.size(), [this, samplesPerChannel](size_t index) {
+        m_channelProcessedSamples[index] = m_channelsList[index]->render(m_channelBuffers[index].data(), samplesPerChannel);
+    });
+
+    samples_t masterChannelSampleCount = 0;
+
+    for (size_t i = 0; i < m_channelsList.size(); ++i) {
+        std::vector<float>& buffer = m_channelBuffers[i];
+
+        m_channelsList[i]->notifyAboutAudioSignalChanges();
+        mixOutputFromChannel(outBuffer, buffer.data(), m_channelProcessedSamples[i]);
+        std::fill(buffer.begin(), buffer.end(), 0.f);
+
+        masterChannelSampleCount = std::max(m_channelProcessedSamples[i], masterChannelSampleCount);
+    }
+
+    return masterChannelSampleCount;
+}
+
+bool Mixer::isIdle() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (!m_isSilent) {
+        return false;
+    }
+
+    for (const IClockPtr& clock : m_clocks) {
+        if (clock->isRunning()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void Mixer::setIsActive(bool arg)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -225,13 +316,7 @@ void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
-
-            outBuffer[idx] += inBuffer[idx];
-        }
-    }
+    dsp::mixAdd(outBuffer, inBuffer, samplesCount * audioChannelsCount());
 }
 
 void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
@@ -240,25 +325,25 @@ void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
         return;
     }
 
-    float totalSquaredSum = 0.f;
+    audioch_t channelsCount = audioChannelsCount();
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
+    m_channelGains.resize(channelsCount);
+    m_channelSquaredSums.assign(channelsCount, 0.f);
 
-        gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * dsp::linearFromDecibels(m_masterParams.volume);
+    gain_t volumeGain = dsp::linearFromDecibels(m_masterParams.volume);
 
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        m_channelGains[audioChNum] = dsp::balanceGain(m_masterParams.balance, audioChNum) * volumeGain;
+    }
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    dsp::applyChannelGainsAndMeasure(buffer, channelsCount, samplesPerChannel, m_channelGains.data(), m_channelSquaredSums.data());
 
-            float squaredSample = resultSample * resultSample;
-            totalSquaredSum += squaredSample;
-            singleChannelSquaredSum += squaredSample;
-        }
+    float totalSquaredSum = 0.f;
+
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        totalSquaredSum += m_channelSquaredSums[audioChNum];
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
+        float rms = dsp::samplesRootMeanSquare(m_channelSquaredSums[audioChNum], samplesPerChannel);
         notifyAboutAudioSignalChanges(audioChNum, rms);
     }
 
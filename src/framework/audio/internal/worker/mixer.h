@@ -30,6 +30,7 @@
 
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "mixerthreadpool.h"
 #include "internal/dsp/limiter.h"
 #include "ifxresolver.h"
 #include "iclock.h"
@@ -49,6 +50,9 @@ public:
 
     void setAudioChannelsCount(const audioch_t count);
 
+    //! NOTE Additional threads, that render the channels in parallel with the worker, 0 means serial rendering
+    void setProcessingThreadsCount(const size_t count);
+
     void addClock(IClockPtr clock);
     void removeClock(IClockPtr clock);
 
@@ -58,6 +62,9 @@ public:
 
     async::Channel<audioch_t, AudioSignalVal> masterAudioSignalChanges() const;
 
+    //! NOTE No clock is running and the last processed block was silent
+    bool isIdle() const;
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -65,21 +72,35 @@ public:
     void setIsActive(bool arg) override;
 
 private:
+    samples_t processChannelsSerially(float* outBuffer, samples_t samplesPerChannel);
+    samples_t processChannelsInParallel(float* outBuffer, samples_t samplesPerChannel);
+    void updateChannelsList();
+
     void mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount);
     void completeOutput(float* buffer, const samples_t& samplesPerChannel);
     void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
     std::vector<float> m_writeCacheBuff;
+    std::vector<gain_t> m_channelGains;
+    std::vector<float> m_channelSquaredSums;
 
     AudioOutputParams m_masterParams;
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
 
     std::map<TrackId, MixerChannelPtr> m_mixerChannels = {};
+
+    //! NOTE The channels in the order of m_mixerChannels with a separate buffer for each one,
+    //! so that they can be rendered concurrently and then summed up in a stable order
+    std::vector<MixerChannel*> m_channelsList;
+    std::vector<std::vector<float> > m_channelBuffers;
+    std::vector<samples_t> m_channelProcessedSamples;
+    MixerThreadPoolPtr m_threadPool = nullptr;
     dsp::LimiterPtr m_limiter = nullptr;
 
     std::set<IClockPtr> m_clocks;
     audioch_t m_audioChannelsCount = 0;
+    bool m_isSilent = false;
 
     mutable AudioSignalsNotifier m_audioSignalNotifier;
 };
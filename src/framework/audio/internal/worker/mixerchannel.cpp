@@ -26,6 +26,7 @@
 #include "log.h"
 
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/audiokernels.h"
 #include "internal/audiosanitizer.h"
 
 using namespace mu;
@@ -104,7 +105,7 @@ async::Channel<audioch_t, AudioSignalVal> MixerChannel::audioSignalChanges() con
 
 bool MixerChannel::isActive() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     IF_ASSERT_FAILED(m_audioSource) {
         return false;
@@ -141,7 +142,7 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
 
 unsigned int MixerChannel::audioChannelsCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     IF_ASSERT_FAILED(m_audioSource) {
         return 0;
@@ -165,7 +166,18 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    samples_t processedSamplesCount = render(buffer, samplesPerChannel);
+    notifyAboutAudioSignalChanges();
+
+    return processedSamplesCount;
+}
+
+samples_t MixerChannel::render(float* buffer, samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_PROCESS_THREAD;
+
     IF_ASSERT_FAILED(m_audioSource) {
+        m_signalRms.clear();
         return 0;
     }
 
@@ -173,10 +185,7 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 
     if (processedSamplesCount == 0 || m_params.muted) {
         std::fill(buffer, buffer + samplesPerChannel * audioChannelsCount(), 0.f);
-
-        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-            notifyAboutAudioSignalChanges(audioChNum, 0.f);
-        }
+        m_signalRms.assign(audioChannelsCount(), 0.f);
 
         return processedSamplesCount;
     }
@@ -193,40 +202,44 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
     return processedSamplesCount;
 }
 
-void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) const
+void MixerChannel::notifyAboutAudioSignalChanges()
 {
-    float totalSquaredSum = 0.f;
+    ONLY_AUDIO_WORKER_THREAD;
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
+    for (audioch_t audioChNum = 0; audioChNum < m_signalRms.size(); ++audioChNum) {
+        float rms = m_signalRms[audioChNum];
+        m_audioSignalNotifier.updateSignalValues(audioChNum, rms, dsp::dbFromSample(rms));
+    }
+}
 
-        gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * dsp::linearFromDecibels(m_params.volume);
+void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
+{
+    audioch_t channelsCount = audioChannelsCount();
 
-        for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    m_channelGains.resize(channelsCount);
+    m_channelSquaredSums.assign(channelsCount, 0.f);
+    m_signalRms.resize(channelsCount);
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    gain_t volumeGain = dsp::linearFromDecibels(m_params.volume);
 
-            float squaredSample = resultSample * resultSample;
-            singleChannelSquaredSum += squaredSample;
-            totalSquaredSum += squaredSample;
-        }
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        m_channelGains[audioChNum] = dsp::balanceGain(m_params.balance, audioChNum) * volumeGain;
+    }
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
+    dsp::applyChannelGainsAndMeasure(buffer, channelsCount, samplesCount, m_channelGains.data(), m_channelSquaredSums.data());
 
-        notifyAboutAudioSignalChanges(audioChNum, rms);
+    float totalSquaredSum = 0.f;
+
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        totalSquaredSum += m_channelSquaredSums[audioChNum];
+
+        m_signalRms[audioChNum] = dsp::samplesRootMeanSquare(m_channelSquaredSums[audioChNum], samplesCount);
     }
 
     if (!m_compressor->isActive()) {
         return;
     }
 
-    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesCount * audioChannelsCount());
-    m_compressor->process(totalRms, buffer, audioChannelsCount(), samplesCount);
-}
-
-void MixerChannel::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
-{
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
+    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesCount * channelsCount);
+    m_compressor->process(totalRms, buffer, channelsCount, samplesCount);
 }
@@ -53,9 +53,13 @@ public:
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
 
+    //! NOTE Same as process(), but only keeps the signal values of the block, so that it can run on a mixer thread.
+    //! They are sent afterwards on the worker by notifyAboutAudioSignalChanges()
+    samples_t render(float* buffer, samples_t samplesPerChannel);
+    void notifyAboutAudioSignalChanges();
+
 private:
-    void completeOutput(float* buffer, unsigned int samplesCount) const;
-    void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
+    void completeOutput(float* buffer, unsigned int samplesCount);
 
     TrackId m_trackId = -1;
 
@@ -67,6 +71,10 @@ private:
 
     dsp::CompressorPtr m_compressor = nullptr;
 
+    std::vector<gain_t> m_channelGains;
+    std::vector<float> m_channelSquaredSums;
+    std::vector<float> m_signalRms;
+
     mutable async::Channel<AudioOutputParams> m_paramsChanges;
     mutable AudioSignalsNotifier m_audioSignalNotifier;
 };
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mixerthreadpool.h"
+
+#include "runtime.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+
+MixerThreadPool::MixerThreadPool(size_t threadsCount)
+{
+    m_threads.reserve(threadsCount);
+
+    for (size_t i = 0; i < threadsCount; ++i) {
+        m_threads.emplace_back([this, i]() {
+            threadMain(i);
+        });
+    }
+}
+
+MixerThreadPool::~MixerThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+
+    m_startCondition.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t MixerThreadPool::threadsCount() const
+{
+    return m_threads.size();
+}
+
+void MixerThreadPool::run(size_t tasksCount, const Task& task)
+{
+    if (m_threads.empty() || tasksCount < 2) {
+        for (size_t i = 0; i < tasksCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_tasksCount = tasksCount;
+        m_nextTaskIndex.store(0, std::memory_order_relaxed);
+        m_busyThreads = m_threads.size();
+        ++m_generation;
+    }
+
+    m_startCondition.notify_all();
+
+    processTasks();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this]() {
+        return m_busyThreads == 0;
+    });
+
+    m_task = nullptr;
+    m_tasksCount = 0;
+}
+
+void MixerThreadPool::threadMain(size_t threadNumber)
+{
+    runtime::setThreadName("audio_mixer_" + std::to_string(threadNumber));
+    AudioSanitizer::setupMixerThread();
+
+    uint64_t lastGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [this, lastGeneration]() {
+                return m_stopped || m_generation != lastGeneration;
+            });
+
+            if (m_stopped) {
+                return;
+            }
+
+            lastGeneration = m_generation;
+        }
+
+        processTasks();
+
+        bool isLast = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            isLast = --m_busyThreads == 0;
+        }
+
+        if (isLast) {
+            m_doneCondition.notify_one();
+        }
+    }
+}
+
+void MixerThreadPool::processTasks()
+{
+    for (size_t index = m_nextTaskIndex.fetch_add(1, std::memory_order_relaxed); index < m_tasksCount;
+         index = m_nextTaskIndex.fetch_add(1, std::memory_order_relaxed)) {
+        (*m_task)(index);
+    }
+}
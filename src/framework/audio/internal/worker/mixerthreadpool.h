@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_MIXERTHREADPOOL_H
+#define MU_AUDIO_MIXERTHREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE A fork-join pool of persistent threads, used by the mixer to render its channels in parallel.
+//! The threads are created once and sleep between the blocks, so that no allocation
+//! or thread creation happens on the audio worker while it is rendering
+class MixerThreadPool
+{
+public:
+    using Task = std::function<void (size_t index)>;
+
+    explicit MixerThreadPool(size_t threadsCount);
+    ~MixerThreadPool();
+
+    size_t threadsCount() const;
+
+    //! NOTE Calls task(i) for every i in [0, tasksCount) and returns once all of them are done.
+    //! The calling thread takes tasks as well
+    void run(size_t tasksCount, const Task& task);
+
+private:
+    void threadMain(size_t threadNumber);
+    void processTasks();
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+
+    const Task* m_task = nullptr;
+    size_t m_tasksCount = 0;
+    std::atomic<size_t> m_nextTaskIndex = 0;
+
+    uint64_t m_generation = 0;
+    size_t m_busyThreads = 0;
+    bool m_stopped = false;
+};
+
+using MixerThreadPoolPtr = std::shared_ptr<MixerThreadPool>;
+}
+
+#endif // MU_AUDIO_MIXERTHREADPOOL_H
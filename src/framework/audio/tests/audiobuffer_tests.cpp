@@ -0,0 +1,222 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/audiobuffer.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+static constexpr audioch_t CHANNELS_COUNT = 2;
+static constexpr unsigned int SAMPLE_RATE = 48000;
+
+//! NOTE Writes an increasing counter, so the consumer can check that no sample is lost or repeated
+class CounterSource : public IAudioSource
+{
+public:
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t i = 0; i < samplesPerChannel * CHANNELS_COUNT; ++i) {
+            buffer[i] = static_cast<float>(m_counter++);
+        }
+
+        return samplesPerChannel;
+    }
+
+private:
+    uint64_t m_counter = 1;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+};
+
+class Audio_AudioBufferTests : public ::testing::Test
+{
+public:
+    struct DriverStats {
+        uint64_t callbacks = 0;
+        uint64_t underruns = 0;
+        uint64_t lostSamples = 0;
+        double maxCallbackUs = 0;
+        double avgCallbackUs = 0;
+        double maxJitterUs = 0;
+    };
+
+    //! NOTE Simulates the driver thread: calls pop() with the period of the given buffer size,
+    //! while the worker thread keeps the buffer filled the same way as the audio worker loop does
+    DriverStats runDriver(samples_t driverBufferSize, std::chrono::milliseconds duration)
+    {
+        AudioBuffer buffer;
+        buffer.init(CHANNELS_COUNT);
+        buffer.setSource(std::make_shared<CounterSource>());
+        buffer.setMinSampleLag(driverBufferSize);
+        buffer.forward();
+
+        std::atomic<bool> running(true);
+        std::thread worker([&buffer, &running]() {
+            while (running) {
+                buffer.forward();
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        });
+
+        using clock = std::chrono::steady_clock;
+        const std::chrono::nanoseconds period(driverBufferSize * 1000000000 / SAMPLE_RATE);
+
+        DriverStats stats;
+        std::vector<float> dest(driverBufferSize * CHANNELS_COUNT);
+        float expected = 1;
+        double totalCallbackUs = 0;
+
+        clock::time_point started = clock::now();
+        clock::time_point deadline = started + period;
+
+        while (clock::now() - started < duration) {
+            std::this_thread::sleep_until(deadline);
+
+            clock::time_point callbackStarted = clock::now();
+            buffer.pop(dest.data(), driverBufferSize);
+            clock::time_point callbackFinished = clock::now();
+
+            double callbackUs = std::chrono::duration<double, std::micro>(callbackFinished - callbackStarted).count();
+            double jitterUs = std::chrono::duration<double, std::micro>(callbackStarted - deadline).count();
+
+            stats.maxCallbackUs = std::max(stats.maxCallbackUs, callbackUs);
+            stats.maxJitterUs = std::max(stats.maxJitterUs, jitterUs);
+            totalCallbackUs += callbackUs;
+            stats.callbacks++;
+
+            for (float sample : dest) {
+                if (sample == 0.f) {
+                    continue; // silence on underrun
+                }
+
+                if (sample != expected) {
+                    stats.lostSamples++;
+                }
+                expected = sample + 1;
+            }
+
+            deadline += period;
+        }
+
+        running = false;
+        worker.join();
+
+        stats.underruns = buffer.underrunsCount();
+        stats.avgCallbackUs = stats.callbacks ? totalCallbackUs / stats.callbacks : 0;
+
+        return stats;
+    }
+};
+
+TEST_F(Audio_AudioBufferTests, PopWithoutSource_Silence)
+{
+    //! GIVEN Buffer without a source
+    AudioBuffer buffer;
+    buffer.init(CHANNELS_COUNT);
+
+    //! DO Pop some samples
+    std::vector<float> dest(256 * CHANNELS_COUNT, 1.f);
+    buffer.pop(dest.data(), 256);
+
+    //! CHECK Silence is returned and the underrun is counted
+    for (float sample : dest) {
+        EXPECT_EQ(sample, 0.f);
+    }
+    EXPECT_EQ(buffer.underrunsCount(), 1u);
+}
+
+TEST_F(Audio_AudioBufferTests, PopNotInitialized_DestUntouched)
+{
+    //! GIVEN Buffer without init()
+    AudioBuffer buffer;
+    buffer.setSource(std::make_shared<CounterSource>());
+
+    //! DO Fill and pop some samples
+    buffer.forward();
+    std::vector<float> dest(256 * CHANNELS_COUNT, 1.f);
+    buffer.pop(dest.data(), 256);
+
+    //! CHECK Nothing is read or written
+    for (float sample : dest) {
+        EXPECT_EQ(sample, 1.f);
+    }
+    EXPECT_EQ(buffer.underrunsCount(), 0u);
+}
+
+TEST_F(Audio_AudioBufferTests, PopAfterForward_SamplesInOrder)
+{
+    //! GIVEN Filled buffer
+    AudioBuffer buffer;
+    buffer.init(CHANNELS_COUNT);
+    buffer.setSource(std::make_shared<CounterSource>());
+    buffer.setMinSampleLag(512);
+    buffer.forward();
+
+    //! DO Pop more than one ring buffer length, refilling in between
+    std::vector<float> dest(512 * CHANNELS_COUNT);
+    float expected = 1;
+    for (int i = 0; i < 100; ++i) {
+        buffer.pop(dest.data(), 512);
+        buffer.forward();
+
+        //! CHECK The samples are continuous
+        for (float sample : dest) {
+            ASSERT_EQ(sample, expected);
+            expected++;
+        }
+    }
+
+    EXPECT_EQ(buffer.underrunsCount(), 0u);
+}
+
+//! NOTE Runs for a few seconds and mostly logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(Audio_AudioBufferTests, DISABLED_Stress_DriverBufferSizes)
+{
+    for (samples_t driverBufferSize : { 64, 128, 256 }) {
+        DriverStats stats = runDriver(driverBufferSize, std::chrono::milliseconds(1000));
+
+        LOGI() << "driver buffer: " << driverBufferSize
+               << ", callbacks: " << stats.callbacks
+               << ", underruns: " << stats.underruns
+               << ", callback avg: " << stats.avgCallbackUs << "us"
+               << ", callback max: " << stats.maxCallbackUs << "us"
+               << ", wakeup jitter max: " << stats.maxJitterUs << "us";
+
+        //! CHECK Nothing is lost or repeated, even if the worker didn't keep up
+        EXPECT_EQ(stats.lostSamples, 0u);
+        EXPECT_GT(stats.callbacks, 0u);
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "audio/internal/dsp/audiokernels.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+static const std::vector<SimdLevel> ALL_LEVELS = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON };
+
+class Audio_AudioKernelsTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        setSimdLevel(m_initialLevel);
+    }
+
+protected:
+    static std::vector<float> randomSamples(size_t count)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+        std::vector<float> samples(count);
+        for (float& sample : samples) {
+            sample = distribution(generator);
+        }
+
+        return samples;
+    }
+
+    //! NOTE The strided per-channel loops, that the mixer used before the kernels
+    static void referenceMixAdd(float* outBuffer, const float* inBuffer, audioch_t channels, samples_t samplesCount)
+    {
+        for (audioch_t audioChNum = 0; audioChNum < channels; ++audioChNum) {
+            for (samples_t s = 0; s < samplesCount; ++s) {
+                size_t idx = s * channels + audioChNum;
+                outBuffer[idx] += inBuffer[idx];
+            }
+        }
+    }
+
+    static void referenceChannelGains(float* buffer, audioch_t channels, samples_t samplesPerChannel, const gain_t* gains,
+                                      float* squaredSums)
+    {
+        for (audioch_t audioChNum = 0; audioChNum < channels; ++audioChNum) {
+            for (samples_t s = 0; s < samplesPerChannel; ++s) {
+                size_t idx = s * channels + audioChNum;
+
+                float resultSample = buffer[idx] * gains[audioChNum];
+                buffer[idx] = resultSample;
+                squaredSums[audioChNum] += resultSample * resultSample;
+            }
+        }
+    }
+
+    SimdLevel m_initialLevel = simdLevel();
+};
+
+TEST_F(Audio_AudioKernelsTests, AllLevels_MatchReference)
+{
+    //! GIVEN Buffers, whose sizes are not multiples of the vector width
+    for (audioch_t channels : { 1, 2, 3, 4, 6 }) {
+        samples_t samplesPerChannel = 1021;
+        size_t samplesCount = samplesPerChannel * channels;
+
+        std::vector<float> input = randomSamples(samplesCount);
+        std::vector<float> output = randomSamples(samplesCount + 1);
+        output.resize(samplesCount);
+
+        std::vector<gain_t> gains;
+        for (audioch_t ch = 0; ch < channels; ++ch) {
+            gains.push_back(0.25f + 0.5f * ch / channels);
+        }
+
+        std::vector<float> expectedMix = output;
+        referenceMixAdd(expectedMix.data(), input.data(), channels, samplesPerChannel);
+
+        std::vector<float> expectedGains = input;
+        std::vector<float> expectedSums(channels, 0.f);
+        referenceChannelGains(expectedGains.data(), channels, samplesPerChannel, gains.data(), expectedSums.data());
+
+        for (SimdLevel level : ALL_LEVELS) {
+            //! DO Run every kernel on every available level
+            setSimdLevel(level);
+
+            std::vector<float> mix = output;
+            mixAdd(mix.data(), input.data(), samplesCount);
+
+            std::vector<float> gained = input;
+            std::vector<float> sums(channels, 0.f);
+            applyChannelGainsAndMeasure(gained.data(), channels, samplesPerChannel, gains.data(), sums.data());
+
+            std::vector<float> scaled = input;
+            applyGain(scaled.data(), samplesCount, 0.5f);
+
+            //! CHECK Element-wise results are exact, the sums only differ by the summation order
+            EXPECT_EQ(mix, expectedMix) << simdLevelName(simdLevel());
+            EXPECT_EQ(gained, expectedGains) << simdLevelName(simdLevel());
+            for (audioch_t ch = 0; ch < channels; ++ch) {
+                EXPECT_NEAR(sums[ch], expectedSums[ch], expectedSums[ch] * 1e-5f) << simdLevelName(simdLevel());
+            }
+            for (size_t i = 0; i < samplesCount; ++i) {
+                ASSERT_EQ(scaled[i], input[i] * 0.5f) << simdLevelName(simdLevel());
+            }
+        }
+    }
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(Audio_AudioKernelsTests, DISABLED_Benchmark_MixerLoops)
+{
+    //! GIVEN A typical block of a stereo mixer
+    constexpr audioch_t CHANNELS = 2;
+    constexpr samples_t SAMPLES_PER_CHANNEL = 1024;
+    constexpr size_t SAMPLES_COUNT = SAMPLES_PER_CHANNEL * CHANNELS;
+    constexpr int ITERATIONS = 2000;
+
+    std::vector<float> input = randomSamples(SAMPLES_COUNT);
+    std::vector<float> output(SAMPLES_COUNT, 0.f);
+    const gain_t gains[CHANNELS] = { 0.999f, 1.001f };
+    float sums[CHANNELS] = { 0.f, 0.f };
+
+    using clock = std::chrono::steady_clock;
+    auto measureNs = [](const auto& func) {
+        clock::time_point start = clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            func();
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count() / ITERATIONS;
+    };
+
+    //! DO Measure the previous loops and the kernels on every available level
+    int64_t referenceMixNs = measureNs([&]() {
+        referenceMixAdd(output.data(), input.data(), CHANNELS, SAMPLES_PER_CHANNEL);
+    });
+    int64_t referenceGainNs = measureNs([&]() {
+        referenceChannelGains(output.data(), CHANNELS, SAMPLES_PER_CHANNEL, gains, sums);
+    });
+
+    LOGI() << "reference loops: mix " << referenceMixNs << " ns, gain/rms " << referenceGainNs << " ns per block";
+
+    for (SimdLevel level : ALL_LEVELS) {
+        setSimdLevel(level);
+        if (simdLevel() != level) {
+            continue;
+        }
+
+        int64_t mixNs = measureNs([&]() {
+            mixAdd(output.data(), input.data(), SAMPLES_COUNT);
+        });
+        int64_t gainNs = measureNs([&]() {
+            applyChannelGainsAndMeasure(output.data(), CHANNELS, SAMPLES_PER_CHANNEL, gains, sums);
+        });
+
+        LOGI() << simdLevelName(level) << " kernels: mix " << mixNs << " ns, gain/rms " << gainNs << " ns per block";
+    }
+
+    //! CHECK The results are used, so that the loops are not optimized out
+    EXPECT_TRUE(std::isfinite(sums[0] + sums[1] + output[0]));
+}
@@ -0,0 +1,70 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "audio/internal/worker/mixerthreadpool.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class Audio_MixerThreadPoolTests : public ::testing::Test
+{
+};
+
+TEST_F(Audio_MixerThreadPoolTests, Run_EveryTaskOnce)
+{
+    //! GIVEN A pool with a few threads and more tasks than threads
+    MixerThreadPool pool(3);
+    std::vector<int> counters(17, 0);
+
+    //! DO Run the same set of tasks many times
+    constexpr int ITERATIONS = 1000;
+    for (int i = 0; i < ITERATIONS; ++i) {
+        pool.run(counters.size(), [&counters](size_t index) {
+            ++counters[index];
+        });
+    }
+
+    //! CHECK Every task ran exactly once per run
+    for (int counter : counters) {
+        EXPECT_EQ(counter, ITERATIONS);
+    }
+}
+
+TEST_F(Audio_MixerThreadPoolTests, Run_WithoutThreads_Serial)
+{
+    //! GIVEN A pool without threads
+    MixerThreadPool pool(0);
+    std::vector<size_t> order;
+
+    //! DO Run tasks
+    pool.run(5, [&order](size_t index) {
+        order.push_back(index);
+    });
+
+    //! CHECK Tasks ran on the calling thread in order
+    EXPECT_EQ(order, std::vector<size_t>({ 0, 1, 2, 3, 4 }));
+}
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <QTemporaryDir>
+
+#include "audio/internal/encoders/wavencoder.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::encode;
+
+static constexpr size_t WAV_HEADER_SIZE = 46;
+static constexpr size_t WAV_DATA_SIZE_OFFSET = 42;
+
+class Audio_WavEncoderTests : public ::testing::Test
+{
+public:
+    static std::vector<char> readFile(const io::path_t& path)
+    {
+        std::ifstream stream(path.toStdString(), std::ios_base::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+};
+
+TEST_F(Audio_WavEncoderTests, EncodeInChunks_AllSamplesWritten)
+{
+    //! GIVEN Short stereo track, split in chunks of different sizes
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    io::path_t path = io::path_t(dir.path()) + "/track.wav";
+
+    SoundTrackFormat format;
+    format.type = SoundTrackType::WAV;
+    format.sampleRate = 48000;
+    format.audioChannelsNumber = 2;
+
+    const std::vector<samples_t> chunks = { 2048, 2048, 1000, 1 };
+    samples_t totalSamplesPerChannel = 0;
+    for (samples_t chunk : chunks) {
+        totalSamplesPerChannel += chunk;
+    }
+
+    std::vector<float> input(totalSamplesPerChannel * format.audioChannelsNumber);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<float>(i);
+    }
+
+    //! DO Encode the chunks one by one
+    {
+        WavEncoder encoder;
+        ASSERT_TRUE(encoder.init(path, format, totalSamplesPerChannel));
+
+        const float* chunkInput = input.data();
+        for (samples_t chunk : chunks) {
+            EXPECT_EQ(encoder.encode(chunk, chunkInput), chunk);
+            chunkInput += chunk * format.audioChannelsNumber;
+        }
+
+        EXPECT_EQ(encoder.flush(), totalSamplesPerChannel);
+    }
+
+    //! CHECK The file contains the header and every sample, in order
+    std::vector<char> data = readFile(path);
+    size_t dataSize = input.size() * sizeof(float);
+    ASSERT_EQ(data.size(), WAV_HEADER_SIZE + dataSize);
+
+    uint32_t headerDataSize = 0;
+    std::memcpy(&headerDataSize, data.data() + WAV_DATA_SIZE_OFFSET, sizeof(headerDataSize));
+    EXPECT_EQ(headerDataSize, dataSize);
+
+    EXPECT_EQ(std::memcmp(data.data() + WAV_HEADER_SIZE, input.data(), dataSize), 0);
+}
@@ -33,6 +33,11 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     deto::async::onMainThreadInvoke(f);
 }
+
+inline void onQueued(const std::thread::id& th, const std::function<void()>& f)
+{
+    deto::async::onQueued(th, f);
+}
 }
 
 #endif // MU_ASYNC_PROCESSEVENTS_H
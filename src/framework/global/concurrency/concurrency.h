@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_FRAMEWORK_CONCURRENCY_H
+#define MU_FRAMEWORK_CONCURRENCY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "runtime.h"
+
+namespace mu::concurrency {
+inline size_t idealThreadCount()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? static_cast<size_t>(count) : 1;
+}
+
+//! NOTE Runs func(index) for every index in [0, count) on up to `threads` worker threads.
+//! Indices are handed out dynamically, so uneven workloads are balanced between workers.
+//! With threads <= 1 (or a single item) everything runs on the calling thread.
+//! The function blocks until all items are processed.
+template<typename Func>
+void parallelFor(size_t count, size_t threads, const Func& func, const std::string& threadName = "worker")
+{
+    if (count == 0) {
+        return;
+    }
+
+    threads = std::min(threads, count);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&next, &func, count]() {
+        size_t i = 0;
+        while ((i = next.fetch_add(1)) < count) {
+            func(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t t = 0; t < threads - 1; ++t) {
+        pool.emplace_back([worker, threadName, t]() {
+            runtime::setThreadName(threadName + "_" + std::to_string(t));
+            worker();
+        });
+    }
+
+    //! NOTE The calling thread takes part in the work too
+    worker();
+
+    for (std::thread& th : pool) {
+        th.join();
+    }
+}
+}
+
+#endif // MU_FRAMEWORK_CONCURRENCY_H
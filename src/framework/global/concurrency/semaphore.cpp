@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "semaphore.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
+#endif
+
+using namespace mu::concurrency;
+
+#if defined(_WIN32)
+
+Semaphore::Semaphore()
+{
+    m_handle = CreateSemaphore(nullptr, 0, LONG_MAX, nullptr);
+}
+
+Semaphore::~Semaphore()
+{
+    CloseHandle(static_cast<HANDLE>(m_handle));
+}
+
+void Semaphore::post()
+{
+    ReleaseSemaphore(static_cast<HANDLE>(m_handle), 1, nullptr);
+}
+
+void Semaphore::wait()
+{
+    WaitForSingleObject(static_cast<HANDLE>(m_handle), INFINITE);
+}
+
+bool Semaphore::waitFor(std::chrono::milliseconds timeout)
+{
+    return WaitForSingleObject(static_cast<HANDLE>(m_handle), static_cast<DWORD>(timeout.count())) == WAIT_OBJECT_0;
+}
+
+#elif defined(__APPLE__)
+
+Semaphore::Semaphore()
+{
+    m_handle = dispatch_semaphore_create(0);
+}
+
+Semaphore::~Semaphore()
+{
+    dispatch_release(static_cast<dispatch_semaphore_t>(m_handle));
+}
+
+void Semaphore::post()
+{
+    dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(m_handle));
+}
+
+void Semaphore::wait()
+{
+    dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(m_handle), DISPATCH_TIME_FOREVER);
+}
+
+bool Semaphore::waitFor(std::chrono::milliseconds timeout)
+{
+    dispatch_time_t deadline = dispatch_time(DISPATCH_TIME_NOW, std::chrono::nanoseconds(timeout).count());
+    return dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(m_handle), deadline) == 0;
+}
+
+#else
+
+Semaphore::Semaphore()
+{
+    sem_t* sem = new sem_t;
+    sem_init(sem, 0, 0);
+    m_handle = sem;
+}
+
+Semaphore::~Semaphore()
+{
+    sem_t* sem = static_cast<sem_t*>(m_handle);
+    sem_destroy(sem);
+    delete sem;
+}
+
+void Semaphore::post()
+{
+    sem_post(static_cast<sem_t*>(m_handle));
+}
+
+void Semaphore::wait()
+{
+    while (sem_wait(static_cast<sem_t*>(m_handle)) != 0 && errno == EINTR) {
+    }
+}
+
+bool Semaphore::waitFor(std::chrono::milliseconds timeout)
+{
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    long long nsec = deadline.tv_nsec + static_cast<long long>(timeout.count()) * 1000000LL;
+    deadline.tv_sec += static_cast<time_t>(nsec / 1000000000LL);
+    deadline.tv_nsec = static_cast<long>(nsec % 1000000000LL);
+
+    int ret = 0;
+    while ((ret = sem_timedwait(static_cast<sem_t*>(m_handle), &deadline)) != 0 && errno == EINTR) {
+    }
+
+    return ret == 0;
+}
+
+#endif
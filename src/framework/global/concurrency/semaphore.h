@@ -0,0 +1,52 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_FRAMEWORK_SEMAPHORE_H
+#define MU_FRAMEWORK_SEMAPHORE_H
+
+#include <chrono>
+
+namespace mu::concurrency {
+//! NOTE A counting semaphore on top of the native one of the platform.
+//! Unlike std::condition_variable, post() does not take a lock,
+//! so it can be used to wake up a thread from the real-time audio callback.
+class Semaphore
+{
+public:
+    Semaphore();
+    ~Semaphore();
+
+    Semaphore(const Semaphore&) = delete;
+    Semaphore& operator=(const Semaphore&) = delete;
+
+    void post();
+
+    void wait();
+
+    //! NOTE Returns false on timeout
+    bool waitFor(std::chrono::milliseconds timeout);
+
+private:
+    void* m_handle = nullptr;
+};
+}
+
+#endif // MU_FRAMEWORK_SEMAPHORE_H
@@ -42,6 +42,7 @@
 #include <QDir>
 #include <QDebug>
 #include <QFileInfo>
+#include <QMutex>
 
 #include "qzipreader_p.h"
 #include "qzipwriter_p.h"
@@ -544,6 +545,9 @@ public:
     void scanFiles();
 
     MQZipReader::Status status;
+
+    //! NOTE Guards the device, so that files can be read concurrently (only inflating runs in parallel)
+    QMutex deviceMutex;
 };
 
 class MQZipWriterPrivate : public MQZipPrivate
@@ -967,9 +971,12 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
 
 /*!
     Fetch the file contents from the zip archive and return the uncompressed bytes.
+    Can be called from several threads at once.
 */
 QByteArray MQZipReader::fileData(const QString& fileName) const
 {
+    QMutexLocker locker(&d->deviceMutex);
+
     d->scanFiles();
     int i;
     for (i = 0; i < d->fileHeaders.size(); ++i) {
@@ -1011,6 +1018,8 @@ QByteArray MQZipReader::fileData(const QString& fileName) const
 
     //qDebug("file at %lld", d->device->pos());
     QByteArray compressed = d->device->read(compressed_size);
+    locker.unlock();
+
     if (compression_method == CompressionMethodStored) {
         // no compression
         compressed.truncate(uncompressed_size);
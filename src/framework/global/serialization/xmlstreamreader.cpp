@@ -22,22 +22,224 @@
 #include "xmlstreamreader.h"
 
 #include <cstring>
-
-#include "thirdparty/tinyxml/tinyxml2.h"
+#include <string>
 
 #include "log.h"
 
 using namespace mu;
 using namespace mu::io;
-using namespace tinyxml2;
 
+//! NOTE The reader is a pull parser: every call of readNext() tokenizes just the next
+//! piece of the document, nothing like a DOM is ever built.
+//! It owns a single NUL-terminated copy of the input, names, attribute values and texts
+//! are decoded in place (unescaping only shrinks) and handed out as views into it,
+//! so they stay valid as long as the reader itself.
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    ByteArray buffer;
+    char* pos = nullptr;
+
+    int64_t line = 1;
+    const char* lineStart = nullptr;
+    int64_t tokenLine = 0;
+    int64_t tokenColumn = 0;
+
+    //! NOTE The '<' at pos was overwritten by the terminator of the preceding text
+    bool tagOpenPending = false;
+    //! NOTE The current start element was self-closing (<tag/>)
+    bool endElementPending = false;
+    //! NOTE Something other than the xml declaration was read
+    bool contentStarted = false;
+
+    std::vector<AsciiStringView> elements;
+    AsciiStringView name;
+    AsciiStringView value;
+    std::vector<std::pair<AsciiStringView, AsciiStringView> > attributes;
+
+    Error err = NoError;
+    String errStr;
     String customErr;
 };
 
+static inline bool isSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static inline bool isNameStartChar(char c)
+{
+    unsigned char ch = static_cast<unsigned char>(c);
+    return ch >= 128 || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == ':' || ch == '_';
+}
+
+static inline bool isNameChar(char c)
+{
+    return isNameStartChar(c) || (c >= '0' && c <= '9') || c == '.' || c == '-';
+}
+
+static inline bool startsWith(const char* p, const char* prefix, size_t len)
+{
+    return std::strncmp(p, prefix, len) == 0;
+}
+
+static inline AsciiStringView makeView(const char* begin, const char* end)
+{
+    return AsciiStringView(begin, static_cast<size_t>(end - begin));
+}
+
+static inline void terminate(const AsciiStringView& view)
+{
+    const_cast<char*>(view.ascii())[view.size()] = '\0';
+}
+
+static char* skipSpaces(char* p, int64_t& line, const char*& lineStart)
+{
+    while (isSpace(*p)) {
+        if (*p == '\n') {
+            ++line;
+            lineStart = p + 1;
+        }
+        ++p;
+    }
+    return p;
+}
+
+static void countLines(const char* begin, const char* end, int64_t& line, const char*& lineStart)
+{
+    const char* p = begin;
+    while ((p = static_cast<const char*>(std::memchr(p, '\n', end - p)))) {
+        ++line;
+        lineStart = ++p;
+    }
+}
+
+static int encodeUtf8(uint32_t ucs, char* out)
+{
+    if (ucs < 0x80) {
+        out[0] = static_cast<char>(ucs);
+        return 1;
+    } else if (ucs < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (ucs >> 6));
+        out[1] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 2;
+    } else if (ucs < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (ucs >> 12));
+        out[1] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (ucs >> 18));
+    out[1] = static_cast<char>(0x80 | ((ucs >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (ucs & 0x3F));
+    return 4;
+}
+
+//! NOTE &#123; or &#x7B; at p, returns the end of the reference or nullptr if it is not a valid one
+static const char* decodeCharacterRef(const char* p, const char* end, char* out, int& len)
+{
+    const bool hex = p[2] == 'x';
+    const char* d = p + (hex ? 3 : 2);
+    uint32_t ucs = 0;
+    int digits = 0;
+    for (; d < end && *d != ';'; ++d, ++digits) {
+        int digit = -1;
+        if (*d >= '0' && *d <= '9') {
+            digit = *d - '0';
+        } else if (hex && *d >= 'a' && *d <= 'f') {
+            digit = *d - 'a' + 10;
+        } else if (hex && *d >= 'A' && *d <= 'F') {
+            digit = *d - 'A' + 10;
+        }
+
+        if (digit < 0 || digits > 8) {
+            return nullptr;
+        }
+        ucs = ucs * (hex ? 16 : 10) + static_cast<uint32_t>(digit);
+    }
+
+    if (d == end || digits == 0 || ucs == 0 || ucs > 0x10FFFF) {
+        return nullptr;
+    }
+
+    len = encodeUtf8(ucs, out);
+    return d + 1;
+}
+
+//! NOTE Normalizes line breaks and resolves the predefined and character entities
+//! of [begin, end) in place, returns the new end
+static char* decode(char* begin, char* end, bool entities)
+{
+    char* p = begin;
+    while (p < end && *p != '\r' && !(entities && *p == '&')) {
+        ++p;
+    }
+
+    if (p == end) {
+        return end;
+    }
+
+    char* q = p;
+    if (*p == '\r' && p > begin && p[-1] == '\n') {
+        ++p;
+    }
+
+    struct Entity {
+        const char* pattern;
+        size_t length;
+        char value;
+    };
+
+    static const Entity ENTITIES[] = {
+        { "quot", 4, '\"' },
+        { "amp", 3, '&' },
+        { "apos", 4, '\'' },
+        { "lt", 2, '<' },
+        { "gt", 2, '>' }
+    };
+
+    while (p < end) {
+        if (*p == '\r') {
+            p += (p + 1 < end && p[1] == '\n') ? 2 : 1;
+            *q++ = '\n';
+        } else if (*p == '\n') {
+            p += (p + 1 < end && p[1] == '\r') ? 2 : 1;
+            *q++ = '\n';
+        } else if (entities && *p == '&') {
+            bool found = false;
+            if (p + 1 < end && p[1] == '#') {
+                char buf[4];
+                int len = 0;
+                const char* next = decodeCharacterRef(p, end, buf, len);
+                if (next) {
+                    std::memcpy(q, buf, len);
+                    q += len;
+                    p = const_cast<char*>(next);
+                    found = true;
+                }
+            } else {
+                for (const Entity& entity : ENTITIES) {
+                    if (p + entity.length + 1 < end
+                        && std::strncmp(p + 1, entity.pattern, entity.length) == 0
+                        && p[entity.length + 1] == ';') {
+                        *q++ = entity.value;
+                        p += entity.length + 2;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!found) {
+                *q++ = *p++;
+            }
+        } else {
+            *q++ = *p++;
+        }
+    }
+
+    return q;
+}
+
 XmlStreamReader::XmlStreamReader()
 {
     m_xml = new Xml();
@@ -70,13 +272,31 @@ XmlStreamReader::~XmlStreamReader()
 
 void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-    m_token = m_xml->err == XML_SUCCESS ? TokenType::NoToken : TokenType::Invalid;
-    m_xml->customErr.clear();
+    delete m_xml;
+    m_xml = new Xml();
+    m_entities.clear();
 
-    if (m_xml->err != XML_SUCCESS) {
-        LOGE() << errorString();
+    //! NOTE ByteArray(size) is allocated with a trailing zero
+    m_xml->buffer = ByteArray(data.size());
+    if (!data.empty()) {
+        std::memcpy(m_xml->buffer.data(), data.constData(), data.size());
+    }
+
+    char* p = reinterpret_cast<char*>(m_xml->buffer.data());
+    m_xml->lineStart = p;
+    p = skipSpaces(p, m_xml->line, m_xml->lineStart);
+
+    static const char BOM[] = { '\xEF', '\xBB', '\xBF' };
+    if (startsWith(p, BOM, sizeof(BOM))) {
+        p += sizeof(BOM);
+        m_xml->lineStart = p;
+    }
+
+    m_xml->pos = p;
+    m_token = TokenType::NoToken;
+
+    if (*p == '\0') {
+        m_token = setError(NotWellFormedError, "empty document");
     }
 }
 
@@ -97,102 +317,383 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
+XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
+    if (m_token == TokenType::Invalid) {
+        return m_token;
+    }
+
+    Xml* xml = m_xml;
+    if (xml->err != NoError || m_token == EndDocument) {
+        m_token = TokenType::Invalid;
+        return m_token;
     }
-    return XmlStreamReader::TokenType::Unknown;
+
+    xml->attributes.clear();
+    xml->value = AsciiStringView();
+
+    if (xml->endElementPending) {
+        xml->endElementPending = false;
+        xml->name = xml->elements.back();
+        xml->elements.pop_back();
+        m_token = TokenType::EndElement;
+        return m_token;
+    }
+
+    xml->name = AsciiStringView();
+
+    if (xml->tagOpenPending) {
+        m_token = parseMarkup();
+        return m_token;
+    }
+
+    char* const start = xml->pos;
+    const int64_t startLine = xml->line;
+    const char* const startLineStart = xml->lineStart;
+
+    xml->pos = skipSpaces(xml->pos, xml->line, xml->lineStart);
+    xml->tokenLine = xml->line;
+    xml->tokenColumn = xml->pos - xml->lineStart + 1;
+
+    if (*xml->pos == '\0') {
+        if (!xml->elements.empty()) {
+            m_token = setError(PrematureEndOfDocumentError, "unexpected end of document");
+            return m_token;
+        }
+
+        m_token = TokenType::EndDocument;
+        return m_token;
+    }
+
+    if (*xml->pos == '<') {
+        m_token = parseMarkup();
+        return m_token;
+    }
+
+    //! NOTE Whitespace only text between tags is dropped,
+    //! otherwise the leading whitespace belongs to the text
+    xml->pos = start;
+    xml->line = startLine;
+    xml->lineStart = startLineStart;
+
+    m_token = parseCharacters();
+    return m_token;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::parseCharacters()
+{
+    Xml* xml = m_xml;
+    char* const begin = xml->pos;
+    char* p = begin;
+    while (*p && *p != '<') {
+        if (*p == '\n') {
+            ++xml->line;
+            xml->lineStart = p + 1;
+        }
+        ++p;
+    }
+
+    if (*p == '\0') {
+        return setError(xml->elements.empty() ? NotWellFormedError : PrematureEndOfDocumentError,
+                        "unexpected end of document in character data");
+    }
+
+    xml->value = makeView(begin, decode(begin, p, true));
+    terminate(xml->value);
+
+    xml->pos = p;
+    xml->tagOpenPending = true;
+    xml->contentStarted = true;
+
+    return TokenType::Characters;
 }
 
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
+XmlStreamReader::TokenType XmlStreamReader::parseMarkup()
 {
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
+    Xml* xml = m_xml;
+    if (xml->tagOpenPending) {
+        xml->tagOpenPending = false;
+        xml->tokenLine = xml->line;
+        xml->tokenColumn = xml->pos - xml->lineStart + 1;
+    }
+
+    char* const m = xml->pos + 1;
+
+    if (*m == '?') {
+        if (xml->contentStarted || !xml->elements.empty()) {
+            return setError(NotWellFormedError, "xml declaration is not at the start of the document");
         }
 
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
+        char* end = std::strstr(m + 1, "?>");
+        if (!end) {
+            return setError(PrematureEndOfDocumentError, "unterminated xml declaration");
         }
+
+        countLines(m, end, xml->line, xml->lineStart);
+        xml->value = makeView(m + 1, decode(m + 1, end, false));
+        terminate(xml->value);
+        xml->pos = end + 2;
+        return TokenType::StartDocument;
     }
 
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
+    xml->contentStarted = true;
+
+    if (startsWith(m, "!--", 3)) {
+        char* end = std::strstr(m + 3, "-->");
+        if (!end) {
+            return setError(PrematureEndOfDocumentError, "unterminated comment");
+        }
+
+        countLines(m, end, xml->line, xml->lineStart);
+        xml->value = makeView(m + 3, decode(m + 3, end, false));
+        terminate(xml->value);
+        xml->pos = end + 3;
+        return TokenType::Comment;
     }
 
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
+    if (startsWith(m, "![CDATA[", 8)) {
+        char* end = std::strstr(m + 8, "]]>");
+        if (!end) {
+            return setError(PrematureEndOfDocumentError, "unterminated CDATA section");
+        }
+
+        countLines(m, end, xml->line, xml->lineStart);
+        xml->value = makeView(m + 8, decode(m + 8, end, false));
+        terminate(xml->value);
+        xml->pos = end + 3;
+        return TokenType::Characters;
     }
 
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
+    if (*m == '!') {
+        //! NOTE <!DOCTYPE ...> or <!ENTITY ...>, the internal subset of a DOCTYPE ([...]) may contain '>'
+        char* end = m + 1;
+        char quote = 0;
+        bool subset = false;
+        for (; *end; ++end) {
+            const char c = *end;
+            if (quote) {
+                if (c == quote) {
+                    quote = 0;
+                }
+            } else if (subset && startsWith(end, "<!--", 4)) {
+                char* commentEnd = std::strstr(end + 4, "-->");
+                if (!commentEnd) {
+                    end += std::strlen(end);
+                    break;
+                }
+                end = commentEnd + 2;
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else if (c == '[') {
+                subset = true;
+            } else if (c == ']') {
+                subset = false;
+            } else if (c == '>' && !subset) {
+                break;
+            }
+        }
+
+        if (*end == '\0') {
+            return setError(PrematureEndOfDocumentError, "unterminated DTD");
+        }
+
+        countLines(m, end, xml->line, xml->lineStart);
+        xml->value = makeView(m + 1, decode(m + 1, end, false));
+        terminate(xml->value);
+        xml->pos = end + 1;
+
+        tryParseEntity(xml->value.ascii());
+
+        return TokenType::DTD;
+    }
+
+    char* p = skipSpaces(m, xml->line, xml->lineStart);
+    if (*p == '/') {
+        return parseEndElement(p + 1);
+    }
+
+    return parseStartElement(p);
 }
 
-XmlStreamReader::TokenType XmlStreamReader::readNext()
+XmlStreamReader::TokenType XmlStreamReader::parseStartElement(char* p)
 {
-    if (m_token == TokenType::Invalid) {
-        return m_token;
+    Xml* xml = m_xml;
+    char* const nameBegin = p;
+    if (!isNameStartChar(*p)) {
+        return setError(*p ? NotWellFormedError : PrematureEndOfDocumentError, "invalid element name");
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
-        m_token = TokenType::Invalid;
-        return m_token;
+    while (isNameChar(*++p)) {
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
-        return m_token;
+    const AsciiStringView name = makeView(nameBegin, p);
+
+    while (true) {
+        p = skipSpaces(p, xml->line, xml->lineStart);
+
+        if (isNameStartChar(*p)) {
+            char* const attrBegin = p;
+            while (isNameChar(*++p)) {
+            }
+            const AsciiStringView attrName = makeView(attrBegin, p);
+
+            p = skipSpaces(p, xml->line, xml->lineStart);
+            if (*p != '=') {
+                return setError(*p ? NotWellFormedError : PrematureEndOfDocumentError, "expected '=' after attribute name");
+            }
+
+            p = skipSpaces(p + 1, xml->line, xml->lineStart);
+            if (*p != '"' && *p != '\'') {
+                return setError(*p ? NotWellFormedError : PrematureEndOfDocumentError, "expected quoted attribute value");
+            }
+
+            const char quote = *p;
+            char* const valueBegin = ++p;
+            while (*p && *p != quote) {
+                if (*p == '\n') {
+                    ++xml->line;
+                    xml->lineStart = p + 1;
+                }
+                ++p;
+            }
+
+            if (*p == '\0') {
+                return setError(PrematureEndOfDocumentError, "unterminated attribute value");
+            }
+
+            for (const auto& attr : xml->attributes) {
+                if (attr.first == attrName) {
+                    return setError(NotWellFormedError, "duplicate attribute");
+                }
+            }
+
+            xml->attributes.emplace_back(attrName, makeView(valueBegin, decode(valueBegin, p, true)));
+            ++p;
+        } else if (*p == '>') {
+            ++p;
+            break;
+        } else if (*p == '/' && p[1] == '>') {
+            p += 2;
+            xml->endElementPending = true;
+            break;
+        } else {
+            return setError(*p ? NotWellFormedError : PrematureEndOfDocumentError, "unexpected character in element");
+        }
     }
 
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
+    //! NOTE Terminate only now, the terminators overwrite delimiters that were needed for parsing
+    terminate(name);
+    for (const auto& attr : xml->attributes) {
+        terminate(attr.first);
+        terminate(attr.second);
+    }
+
+    xml->name = name;
+    xml->elements.push_back(name);
+    xml->pos = p;
 
-    m_xml->node = p.first;
-    m_token = p.second;
+    return TokenType::StartElement;
+}
 
-    if (m_token == XmlStreamReader::TokenType::DTD) {
-        tryParseEntity(m_xml);
+XmlStreamReader::TokenType XmlStreamReader::parseEndElement(char* p)
+{
+    Xml* xml = m_xml;
+    char* const nameBegin = p;
+    if (!isNameStartChar(*p)) {
+        return setError(*p ? NotWellFormedError : PrematureEndOfDocumentError, "invalid element name");
     }
 
-    return m_token;
+    while (isNameChar(*++p)) {
+    }
+
+    const AsciiStringView name = makeView(nameBegin, p);
+
+    p = skipSpaces(p, xml->line, xml->lineStart);
+    if (*p != '>') {
+        return setError(*p ? NotWellFormedError : PrematureEndOfDocumentError, "expected '>' in end tag");
+    }
+
+    if (xml->elements.empty() || xml->elements.back() != name) {
+        return setError(NotWellFormedError, "mismatched end tag");
+    }
+
+    xml->name = xml->elements.back();
+    xml->elements.pop_back();
+    xml->pos = p + 1;
+
+    return TokenType::EndElement;
 }
 
-void XmlStreamReader::tryParseEntity(Xml* xml)
+XmlStreamReader::TokenType XmlStreamReader::setError(Error err, const char* message)
+{
+    m_xml->err = err;
+    m_xml->errStr = String::fromStdString(std::string(message)
+                                          + ", line " + std::to_string(m_xml->tokenLine)
+                                          + ", column " + std::to_string(m_xml->tokenColumn));
+
+    LOGE() << errorString();
+
+    return TokenType::Invalid;
+}
+
+void XmlStreamReader::tryParseEntity(const char* str)
 {
     static const char* ENTITY = { "ENTITY" };
+    static const char* DOCTYPE = { "DOCTYPE" };
 
-    const char* str = xml->node->Value();
-    if (std::strncmp(str, ENTITY, 6) == 0) {
-        String val(str);
-        StringList list = val.split(' ');
-        if (list.size() == 3) {
-            String name = list.at(1);
-            String val = list.at(2);
-            m_entities[u'&' + name + u';'] = val.mid(1, val.size() - 2);
-        } else {
-            LOGW() << "unknown ENTITY: " << val;
+    if (startsWith(str, ENTITY, 6)) {
+        //! NOTE ENTITY name "value"
+        const char* p = str + 6;
+        while (isSpace(*p)) {
+            ++p;
+        }
+
+        const char* nameBegin = p;
+        while (*p && !isSpace(*p)) {
+            ++p;
+        }
+        const char* nameEnd = p;
+
+        while (isSpace(*p)) {
+            ++p;
+        }
+
+        const char* valueEnd = (*p == '"' || *p == '\'') ? std::strchr(p + 1, *p) : nullptr;
+        if (nameBegin == nameEnd || !valueEnd) {
+            LOGW() << "unknown ENTITY: " << str;
+            return;
+        }
+
+        //! NOTE Entities used in the value are expected to be declared before
+        String value = String::fromStdString(std::string(p + 1, valueEnd));
+        for (const auto& e : m_entities) {
+            value.replace(e.first, e.second);
+        }
+
+        String name = String::fromStdString(std::string(nameBegin, nameEnd));
+        m_entities[u'&' + name + u';'] = value;
+    } else if (startsWith(str, DOCTYPE, 7)) {
+        //! NOTE Entities declared in the internal subset
+        const char* decl = std::strstr(str, "<!");
+        while (decl) {
+            const bool isComment = startsWith(decl, "<!--", 4);
+            const char* end = isComment ? std::strstr(decl + 4, "-->") : std::strchr(decl, '>');
+            if (!end) {
+                break;
+            }
+
+            if (!isComment) {
+                tryParseEntity(std::string(decl + 2, end).c_str());
+            }
+
+            decl = std::strstr(end, "<!");
         }
     }
 }
 
-String XmlStreamReader::nodeValue(Xml* xml) const
+String XmlStreamReader::nodeValue() const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(m_xml->value.ascii());
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -225,7 +726,16 @@ AsciiStringView XmlStreamReader::tokenString() const
 
 bool XmlStreamReader::isWhitespace() const
 {
-    return false;
+    if (m_token != TokenType::Characters) {
+        return false;
+    }
+
+    for (const char* p = m_xml->value.ascii(); *p; ++p) {
+        if (!isSpace(*p)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void XmlStreamReader::skipCurrentElement()
@@ -242,7 +752,18 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    return m_xml->name;
+}
+
+static const AsciiStringView* findAttribute(const std::vector<std::pair<AsciiStringView, AsciiStringView> >& attributes,
+                                            const char* name)
+{
+    for (const auto& attr : attributes) {
+        if (attr.first == name) {
+            return &attr.second;
+        }
+    }
+    return nullptr;
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -251,11 +772,7 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
-    }
-    return e->FindAttribute(name) != nullptr;
+    return findAttribute(m_xml->attributes, name) != nullptr;
 }
 
 String XmlStreamReader::attribute(const char* name) const
@@ -264,11 +781,11 @@ String XmlStreamReader::attribute(const char* name) const
         return String();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
+    const AsciiStringView* value = findAttribute(m_xml->attributes, name);
+    if (!value) {
         return String();
     }
-    return String(e->Attribute(name));
+    return String::fromUtf8(value->ascii());
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
@@ -282,11 +799,11 @@ AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
         return AsciiStringView();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
+    const AsciiStringView* value = findAttribute(m_xml->attributes, name);
+    if (!value) {
         return AsciiStringView();
     }
-    return e->Attribute(name);
+    return *value;
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
@@ -321,15 +838,11 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    attrs.reserve(m_xml->attributes.size());
+    for (const auto& xa : m_xml->attributes) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = xa->Value();
+        a.name = xa.first;
+        a.value = String::fromUtf8(xa.second.ascii());
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -337,16 +850,16 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
 
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return nodeValue(m_xml);
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return nodeValue();
     }
     return String();
 }
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return m_xml->value;
     }
     return AsciiStringView();
 }
@@ -358,7 +871,7 @@ String XmlStreamReader::readText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = nodeValue(m_xml);
+                result = nodeValue();
                 break;
             case EndElement:
                 return result;
@@ -366,6 +879,8 @@ String XmlStreamReader::readText()
                 break;
             case StartElement:
                 break;
+            case Invalid:
+                return result;
             default:
                 break;
             }
@@ -381,7 +896,7 @@ AsciiStringView XmlStreamReader::readAsciiText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = m_xml->value;
                 break;
             case EndElement:
                 return result;
@@ -389,6 +904,8 @@ AsciiStringView XmlStreamReader::readAsciiText()
                 break;
             case StartElement:
                 break;
+            case Invalid:
+                return result;
             default:
                 break;
             }
@@ -411,12 +928,12 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    return m_xml->tokenLine;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    return m_xml->tokenColumn;
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -425,12 +942,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
-        return NoError;
-    }
-
-    return NotWellFormedError;
+    return m_xml->err;
 }
 
 bool XmlStreamReader::isError() const
@@ -443,7 +955,7 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+    return m_xml->errStr;
 }
 
 void XmlStreamReader::raiseError(const String& message)
@@ -118,8 +118,14 @@ public:
 private:
     struct Xml;
 
-    void tryParseEntity(Xml* xml);
-    String nodeValue(Xml* xml) const;
+    TokenType parseMarkup();
+    TokenType parseCharacters();
+    TokenType parseStartElement(char* p);
+    TokenType parseEndElement(char* p);
+    TokenType setError(Error err, const char* message);
+
+    void tryParseEntity(const char* str);
+    String nodeValue() const;
 
     Xml* m_xml = nullptr;
     TokenType m_token = TokenType::NoToken;
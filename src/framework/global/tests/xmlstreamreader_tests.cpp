@@ -0,0 +1,262 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "serialization/xmlstreamreader.h"
+
+#include "log.h"
+
+using namespace mu;
+
+class Global_Ser_XmlStreamReaderTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Tokens)
+{
+    //! GIVEN Document with declaration, attributes, empty elements, comments and whitespace between tags
+    ByteArray data("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   "<museScore version='4.00'>\n"
+                   "  <Score>\n"
+                   "    <Division>480</Division>\n"
+                   "    <eid/>\n"
+                   "    <!-- comment -->\n"
+                   "    <Staff id=\"1\" />\n"
+                   "  </Score>\n"
+                   "</museScore>\n");
+
+    XmlStreamReader xml(data);
+
+    //! CHECK Token sequence
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartDocument);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "museScore");
+    EXPECT_EQ(xml.attribute("version"), u"4.00");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "Score");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "Division");
+    EXPECT_EQ(xml.readInt(), 480);
+    EXPECT_TRUE(xml.isEndElement());
+
+    //! CHECK Empty element gives end element, also when it is followed by a comment
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "eid");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "eid");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Comment);
+    EXPECT_EQ(xml.text(), u" comment ");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "Staff");
+    EXPECT_EQ(xml.intAttribute("id"), 1);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "Score");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "museScore");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndDocument);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Invalid);
+
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Text)
+{
+    //! GIVEN Texts with entities, character references, CDATA and CRLF line breaks
+    ByteArray data("<a x=\"1 &amp; 2\" y=\"&#x41;&#66;&lt;&unknown;\">"
+                   "<b>  T &amp; &quot;S&quot;\r\nline</b>"
+                   "<c><![CDATA[<raw> &amp;]]></c>"
+                   "<d>&#20013;</d>"
+                   "</a>");
+
+    XmlStreamReader xml(data);
+
+    //! CHECK Attribute values are unescaped, unknown entities are kept
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.asciiAttribute("x"), "1 & 2");
+    EXPECT_EQ(xml.asciiAttribute("y"), "AB<&unknown;");
+    EXPECT_TRUE(xml.hasAttribute("y"));
+    EXPECT_FALSE(xml.hasAttribute("z"));
+    EXPECT_EQ(xml.attributes().size(), 2u);
+
+    //! CHECK Text keeps the leading whitespace, line breaks are normalized
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readAsciiText(), "  T & \"S\"\nline");
+
+    //! CHECK CDATA is taken as is
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readAsciiText(), "<raw> &amp;");
+
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), String(u"中"));
+
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Views)
+{
+    //! GIVEN Document
+    ByteArray data("<a><b v=\"first\">12</b><c v=\"second\">text</c></a>");
+
+    XmlStreamReader xml(data);
+
+    //! DO Take views of names, attributes and texts and read further
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    AsciiStringView name = xml.name();
+    AsciiStringView attr = xml.asciiAttribute("v");
+    AsciiStringView text = xml.readAsciiText();
+
+    xml.skipCurrentElement();
+
+    //! CHECK The views point into the buffer of the reader and stay valid
+    EXPECT_EQ(name, "b");
+    EXPECT_EQ(attr, "first");
+    EXPECT_EQ(text, "12");
+    EXPECT_EQ(text.toInt(), 12);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Entities)
+{
+    //! GIVEN Document with entities declared in the internal subset of the DTD
+    ByteArray data("<?xml version=\"1.0\"?>\n"
+                   "<!DOCTYPE museScore [\n"
+                   "<!-- it's a comment with a > -->\n"
+                   "<!ENTITY two \"m:0:2 2 m:0:-2\">\n"
+                   "<!ENTITY sus2 \"sus &two;\">\n"
+                   "]>\n"
+                   "<museScore><render>&sus2;</render></museScore>\n");
+
+    XmlStreamReader xml(data);
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartDocument);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::DTD);
+
+    //! CHECK Declared entities are replaced, also nested ones
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), u"sus m:0:2 2 m:0:-2");
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Errors)
+{
+    {
+        //! GIVEN Document with mismatched end tag
+        ByteArray data("<a>\n  <b>\n  </c>\n</a>");
+        XmlStreamReader xml(data);
+
+        //! DO Read all
+        while (!xml.atEnd()) {
+            xml.readNext();
+        }
+
+        //! CHECK Error with position
+        EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError);
+        EXPECT_EQ(xml.lineNumber(), 3);
+        EXPECT_EQ(xml.columnNumber(), 3);
+        EXPECT_FALSE(xml.errorString().empty());
+    }
+
+    {
+        //! GIVEN Truncated document
+        ByteArray data("<a><b>text</b>");
+        XmlStreamReader xml(data);
+
+        //! DO Read all
+        while (!xml.atEnd()) {
+            xml.readNext();
+        }
+
+        //! CHECK Error
+        EXPECT_EQ(xml.error(), XmlStreamReader::PrematureEndOfDocumentError);
+    }
+
+    {
+        //! GIVEN Empty document
+        XmlStreamReader xml(ByteArray("  \n "));
+
+        //! CHECK Error right away
+        EXPECT_TRUE(xml.atEnd());
+        EXPECT_TRUE(xml.isError());
+    }
+}
+
+//! NOTE Only logs the timings, so it is disabled, run it with --gtest_also_run_disabled_tests
+TEST_F(Global_Ser_XmlStreamReaderTests, DISABLED_Benchmark_Read)
+{
+    using clock = std::chrono::steady_clock;
+
+    //! GIVEN Large score like document
+    std::string str = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<museScore version=\"4.00\">\n  <Score>\n";
+    for (int m = 0; m < 20000; ++m) {
+        str += "    <Measure>\n      <voice>\n";
+        for (int c = 0; c < 4; ++c) {
+            str += "        <Chord>\n"
+                   "          <durationType>quarter</durationType>\n"
+                   "          <Note>\n"
+                   "            <pitch>60</pitch>\n"
+                   "            <tpc>14</tpc>\n"
+                   "            <Spanner type=\"Tie\"><Tie/><next><location><fractions>1/4</fractions></location></next></Spanner>\n"
+                   "          </Note>\n"
+                   "        </Chord>\n";
+        }
+        str += "      </voice>\n    </Measure>\n";
+    }
+    str += "  </Score>\n</museScore>\n";
+
+    ByteArray data(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+
+    //! DO Read all tokens
+    clock::time_point start = clock::now();
+
+    XmlStreamReader xml(data);
+    size_t elements = 0;
+    int pitches = 0;
+    while (!xml.atEnd()) {
+        if (xml.readNext() == XmlStreamReader::StartElement) {
+            ++elements;
+            if (xml.name() == "pitch") {
+                pitches += xml.readInt();
+                ++elements;
+            }
+        }
+    }
+
+    int64_t readMs = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start).count();
+
+    //! CHECK Everything is read
+    EXPECT_FALSE(xml.isError());
+    EXPECT_EQ(pitches, 20000 * 4 * 60);
+
+    LOGI() << "read " << (data.size() / 1024) << " KB, " << elements << " elements: " << readMs << " ms";
+}
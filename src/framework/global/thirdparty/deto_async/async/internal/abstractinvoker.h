@@ -76,6 +76,7 @@ public:
 
     static void processEvents();
     static void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
+    static void onQueued(const std::thread::id& th, const std::function<void()>& f);
 
 protected:
     explicit AbstractInvoker();
@@ -166,6 +167,12 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     AbstractInvoker::onMainThreadInvoke(f);
 }
+
+//! f is called (from the sending thread) every time a call is queued for the thread th
+inline void onQueued(const std::thread::id& th, const std::function<void()>& f)
+{
+    AbstractInvoker::onQueued(th, f);
+}
 }
 }
 
@@ -16,8 +16,20 @@ void QueuedInvoker::invoke(const std::thread::id& th, const Functor& f, bool isA
         }
     }
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_queues[th].push(f);
+    Functor onQueued;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        m_queues[th].push(f);
+
+        auto it = m_onQueued.find(th);
+        if (it != m_onQueued.end()) {
+            onQueued = it->second;
+        }
+    }
+
+    if (onQueued) {
+        onQueued();
+    }
 }
 
 void QueuedInvoker::processEvents()
@@ -39,6 +51,16 @@ void QueuedInvoker::processEvents()
     }
 }
 
+void QueuedInvoker::onQueued(const std::thread::id& th, const Functor& f)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    if (f) {
+        m_onQueued[th] = f;
+    } else {
+        m_onQueued.erase(th);
+    }
+}
+
 void QueuedInvoker::onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f)
 {
     m_onMainThreadInvoke = f;
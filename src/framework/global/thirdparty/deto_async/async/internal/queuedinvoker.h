@@ -20,6 +20,7 @@ public:
     void invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued = false);
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
+    void onQueued(const std::thread::id& th, const Functor& f);
 
 private:
 
@@ -29,6 +30,7 @@ private:
 
     std::recursive_mutex m_mutex;
     std::map<std::thread::id, Queue > m_queues;
+    std::map<std::thread::id, Functor > m_onQueued;
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;
@@ -23,6 +23,8 @@
 #ifndef MU_MPE_EVENTS_H
 #define MU_MPE_EVENTS_H
 
+#include <algorithm>
+#include <limits>
 #include <variant>
 #include <vector>
 #include <optional>
@@ -297,10 +299,70 @@ struct PlaybackSetupData
     }
 };
 
+using TimestampRange = std::pair<timestamp_t, timestamp_t>;
+
+//! NOTE The events with the timestamps (the keys of PlaybackEventsMap) in [from, to] are replaced with `events`,
+//! i.e. the events are inserted if there were none in the range, and removed if `events` is empty
+struct PlaybackEventsRange {
+    timestamp_t from = 0;
+    timestamp_t to = 0;
+    PlaybackEventsMap events;
+};
+
+//! NOTE The changes of the events of a track. Only the changed ranges are sent,
+//! so a small edit doesn't copy the events of the whole track
+struct PlaybackEventsDelta {
+    std::vector<PlaybackEventsRange> ranges;
+
+    static PlaybackEventsDelta full(const PlaybackEventsMap& events)
+    {
+        PlaybackEventsDelta delta;
+        delta.ranges.push_back({ std::numeric_limits<timestamp_t>::min(), std::numeric_limits<timestamp_t>::max(), events });
+        return delta;
+    }
+
+    //! NOTE Takes the actual events of the given (possibly overlapping) ranges
+    static PlaybackEventsDelta fromRanges(const PlaybackEventsMap& events, std::vector<TimestampRange> changedRanges)
+    {
+        std::sort(changedRanges.begin(), changedRanges.end());
+
+        PlaybackEventsDelta delta;
+        for (const TimestampRange& range : changedRanges) {
+            if (!delta.ranges.empty() && range.first <= delta.ranges.back().to) {
+                delta.ranges.back().to = std::max(delta.ranges.back().to, range.second);
+                continue;
+            }
+
+            delta.ranges.push_back({ range.first, range.second, {} });
+        }
+
+        for (PlaybackEventsRange& range : delta.ranges) {
+            range.events.insert(events.lower_bound(range.from), events.upper_bound(range.to));
+        }
+
+        return delta;
+    }
+
+    void apply(PlaybackEventsMap& events) const
+    {
+        for (const PlaybackEventsRange& range : ranges) {
+            events.erase(events.lower_bound(range.from), events.upper_bound(range.to));
+            events.insert(range.events.cbegin(), range.events.cend());
+        }
+    }
+
+    bool empty() const
+    {
+        return ranges.empty();
+    }
+};
+
+using PlaybackEventsDeltaChanges = async::Channel<PlaybackEventsDelta>;
+
 struct PlaybackData {
     PlaybackEventsMap originEvents;
     PlaybackSetupData setupData;
-    PlaybackEventsChanges mainStream;
+    PlaybackEventsDeltaChanges mainStream;
     PlaybackEventsChanges offStream;
     DynamicLevelMap dynamicLevelMap;
     async::Channel<DynamicLevelMap> dynamicLevelChanges;
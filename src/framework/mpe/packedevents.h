@@ -0,0 +1,440 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_MPE_PACKEDEVENTS_H
+#define MU_MPE_PACKEDEVENTS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "events.h"
+
+namespace mu::mpe {
+//! NOTE Stores every distinct value once, the users keep the index of the value
+template<typename T, typename Hash, typename Equal = std::equal_to<T> >
+class InternTable
+{
+public:
+    uint32_t intern(const T& value)
+    {
+        size_t hash = Hash()(value);
+
+        auto range = m_index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (Equal()(m_values[it->second], value)) {
+                return it->second;
+            }
+        }
+
+        uint32_t idx = static_cast<uint32_t>(m_values.size());
+        m_values.push_back(value);
+        m_hashes.push_back(hash);
+        m_index.emplace(hash, idx);
+
+        return idx;
+    }
+
+    const T& at(const uint32_t idx) const
+    {
+        return m_values[idx];
+    }
+
+    size_t size() const
+    {
+        return m_values.size();
+    }
+
+    void clear()
+    {
+        m_values.clear();
+        m_hashes.clear();
+        m_index.clear();
+    }
+
+    //! NOTE Removes the values, that are not used anymore.
+    //! Returns the new index of every old one, the indices of the removed values are not valid
+    std::vector<uint32_t> compact(const std::vector<bool>& used)
+    {
+        std::vector<uint32_t> newIndices(m_values.size(), 0);
+
+        uint32_t count = 0;
+        for (size_t idx = 0; idx < m_values.size(); ++idx) {
+            if (!used[idx]) {
+                continue;
+            }
+
+            if (count != idx) {
+                m_values[count] = std::move(m_values[idx]);
+                m_hashes[count] = m_hashes[idx];
+            }
+
+            newIndices[idx] = count++;
+        }
+
+        m_values.resize(count);
+        m_hashes.resize(count);
+
+        m_index.clear();
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            m_index.emplace(m_hashes[idx], idx);
+        }
+
+        return newIndices;
+    }
+
+private:
+    std::vector<T> m_values;
+    std::vector<size_t> m_hashes;
+    std::unordered_multimap<size_t, uint32_t> m_index;
+};
+
+inline size_t hashCombine(const size_t seed, const size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+struct ValuesCurveHash {
+    template<typename T>
+    size_t operator()(const ValuesCurve<T>& curve) const
+    {
+        size_t result = curve.size();
+        for (const auto& pair : curve) {
+            result = hashCombine(result, std::hash<int64_t>()(pair.first));
+            result = hashCombine(result, std::hash<int64_t>()(pair.second));
+        }
+        return result;
+    }
+};
+
+struct ArticulationMapHash {
+    size_t operator()(const ArticulationMap& articulations) const
+    {
+        //! NOTE The order of the entries of a hash map is not defined, so the hashes of the entries are just summed up
+        size_t result = articulations.size();
+        for (auto it = articulations.cbegin(); it != articulations.cend(); ++it) {
+            size_t entry = std::hash<int>()(static_cast<int>(it->first));
+            entry = hashCombine(entry, std::hash<int64_t>()(it->second.meta.timestamp));
+            entry = hashCombine(entry, std::hash<int64_t>()(it->second.meta.overallDuration));
+            entry = hashCombine(entry, std::hash<int64_t>()(it->second.occupiedFrom));
+            entry = hashCombine(entry, std::hash<int64_t>()(it->second.occupiedTo));
+            result += entry;
+        }
+        return result;
+    }
+};
+
+struct ArticulationMapEqual {
+    bool operator()(const ArticulationMap& f, const ArticulationMap& s) const
+    {
+        return f == s
+               && f.averageDurationFactor() == s.averageDurationFactor()
+               && f.averageTimestampOffset() == s.averageTimestampOffset()
+               && f.averagePitchRange() == s.averagePitchRange()
+               && f.averageMaxAmplitudeLevel() == s.averageMaxAmplitudeLevel()
+               && f.averageDynamicRange() == s.averageDynamicRange()
+               && f.averagePitchOffsetMap() == s.averagePitchOffsetMap()
+               && f.averageDynamicOffsetMap() == s.averageDynamicOffsetMap();
+    }
+};
+
+//! NOTE A compact form of the events of a track: a flat array sorted by the origin timestamps
+//! (the keys of PlaybackEventsMap), the articulations and the curves are interned and referenced by index.
+//! The articulations are stored as they are, so the notes of a chord share them and unpacking a note
+//! doesn't need to build a new map.
+//! The values, that are not used anymore after the events were replaced, are removed from the tables
+//! once the tables have grown twice since the last compaction
+class PackedPlaybackEvents
+{
+public:
+    struct Event {
+        timestamp_t originTimestamp = 0;
+        timestamp_t nominalTimestamp = 0;
+        timestamp_t actualTimestamp = 0;
+        duration_t nominalDuration = 0;
+        duration_t actualDuration = 0;
+        int32_t nominalPitchLevel = 0;
+        int32_t nominalDynamicLevel = 0;
+        uint32_t articulationsIdx = 0;
+        uint32_t pitchCurveIdx = 0;
+        uint32_t expressionCurveIdx = 0;
+        voice_layer_idx_t voiceLayerIndex = 0;
+        bool isRest = false;
+    };
+
+    using EventList = std::vector<Event>;
+
+    const EventList& events() const
+    {
+        return m_events;
+    }
+
+    size_t size() const
+    {
+        return m_events.size();
+    }
+
+    bool empty() const
+    {
+        return m_events.empty();
+    }
+
+    void clear()
+    {
+        m_events.clear();
+        m_articulations.clear();
+        m_pitchCurves.clear();
+        m_expressionCurves.clear();
+        m_compactedTablesSize = 0;
+    }
+
+    void load(const PlaybackEventsMap& events)
+    {
+        clear();
+
+        for (const auto& pair : events) {
+            for (const PlaybackEvent& event : pair.second) {
+                m_events.push_back(pack(pair.first, event));
+            }
+        }
+
+        m_compactedTablesSize = tablesSize();
+    }
+
+    //! NOTE Inserts the events after the ones with the same origin timestamp
+    void insert(const timestamp_t originTimestamp, const PlaybackEventList& events)
+    {
+        EventList packed;
+        packed.reserve(events.size());
+        for (const PlaybackEvent& event : events) {
+            packed.push_back(pack(originTimestamp, event));
+        }
+
+        m_events.insert(upperBound(originTimestamp), packed.cbegin(), packed.cend());
+    }
+
+    //! NOTE Removes the events with the origin timestamps in [from, to]
+    void erase(const timestamp_t from, const timestamp_t to)
+    {
+        m_events.erase(lowerBound(from), upperBound(to));
+        compactIfNeeded();
+    }
+
+    //! NOTE The position of the replaced events: removedCount events starting at first were replaced by insertedCount ones
+    struct ReplacedRange {
+        size_t first = 0;
+        size_t removedCount = 0;
+        size_t insertedCount = 0;
+    };
+
+    //! NOTE Replaces the events with the origin timestamps in [range.from, range.to] by range.events
+    ReplacedRange replace(const PlaybackEventsRange& range)
+    {
+        EventList packed;
+        for (const auto& pair : range.events) {
+            for (const PlaybackEvent& event : pair.second) {
+                packed.push_back(pack(pair.first, event));
+            }
+        }
+
+        auto first = lowerBound(range.from);
+        auto last = upperBound(range.to);
+
+        ReplacedRange result;
+        result.first = static_cast<size_t>(std::distance(m_events.begin(), first));
+        result.removedCount = static_cast<size_t>(std::distance(first, last));
+        result.insertedCount = packed.size();
+
+        //! NOTE Reuse the removed slots first, so that only the difference is moved
+        size_t common = std::min(result.removedCount, packed.size());
+        std::copy(packed.cbegin(), packed.cbegin() + common, first);
+
+        if (common < packed.size()) {
+            m_events.insert(first + common, packed.cbegin() + common, packed.cend());
+        } else {
+            m_events.erase(first + common, last);
+        }
+
+        compactIfNeeded();
+
+        return result;
+    }
+
+    void apply(const PlaybackEventsDelta& delta)
+    {
+        for (const PlaybackEventsRange& range : delta.ranges) {
+            replace(range);
+        }
+    }
+
+    PlaybackEvent event(const Event& packed) const
+    {
+        ArrangementContext arrangementCtx;
+        arrangementCtx.nominalTimestamp = packed.nominalTimestamp;
+        arrangementCtx.actualTimestamp = packed.actualTimestamp;
+        arrangementCtx.nominalDuration = packed.nominalDuration;
+        arrangementCtx.actualDuration = packed.actualDuration;
+        arrangementCtx.voiceLayerIndex = packed.voiceLayerIndex;
+
+        if (packed.isRest) {
+            return RestEvent(std::move(arrangementCtx));
+        }
+
+        //! NOTE The contexts are initialized with the shared values directly,
+        //! the default constructed curves and articulations would allocate their own data first
+        PitchContext pitchCtx { static_cast<pitch_level_t>(packed.nominalPitchLevel), m_pitchCurves.at(packed.pitchCurveIdx) };
+
+        ExpressionContext expressionCtx { m_articulations.at(packed.articulationsIdx),
+                                          static_cast<dynamic_level_t>(packed.nominalDynamicLevel),
+                                          m_expressionCurves.at(packed.expressionCurveIdx) };
+
+        return NoteEvent(std::move(arrangementCtx), std::move(pitchCtx), std::move(expressionCtx));
+    }
+
+    PlaybackEventsMap toEventsMap() const
+    {
+        PlaybackEventsMap result;
+        for (const Event& packed : m_events) {
+            result[packed.originTimestamp].push_back(event(packed));
+        }
+        return result;
+    }
+
+    size_t articulationsCount() const
+    {
+        return m_articulations.size();
+    }
+
+    size_t curvesCount() const
+    {
+        return m_pitchCurves.size() + m_expressionCurves.size();
+    }
+
+private:
+    EventList::iterator lowerBound(const timestamp_t originTimestamp)
+    {
+        return std::lower_bound(m_events.begin(), m_events.end(), originTimestamp, [](const Event& event, timestamp_t timestamp) {
+            return event.originTimestamp < timestamp;
+        });
+    }
+
+    EventList::iterator upperBound(const timestamp_t originTimestamp)
+    {
+        return std::upper_bound(m_events.begin(), m_events.end(), originTimestamp, [](timestamp_t timestamp, const Event& event) {
+            return timestamp < event.originTimestamp;
+        });
+    }
+
+    size_t tablesSize() const
+    {
+        return m_articulations.size() + m_pitchCurves.size() + m_expressionCurves.size();
+    }
+
+    void compactIfNeeded()
+    {
+        static constexpr size_t MIN_TABLES_SIZE = 256;
+
+        if (tablesSize() < std::max(m_compactedTablesSize * 2, MIN_TABLES_SIZE)) {
+            return;
+        }
+
+        compact();
+    }
+
+    void compact()
+    {
+        std::vector<bool> usedArticulations(m_articulations.size(), false);
+        std::vector<bool> usedPitchCurves(m_pitchCurves.size(), false);
+        std::vector<bool> usedExpressionCurves(m_expressionCurves.size(), false);
+
+        for (const Event& event : m_events) {
+            if (event.isRest) {
+                continue;
+            }
+
+            usedArticulations[event.articulationsIdx] = true;
+            usedPitchCurves[event.pitchCurveIdx] = true;
+            usedExpressionCurves[event.expressionCurveIdx] = true;
+        }
+
+        std::vector<uint32_t> articulationsIndices = m_articulations.compact(usedArticulations);
+        std::vector<uint32_t> pitchCurvesIndices = m_pitchCurves.compact(usedPitchCurves);
+        std::vector<uint32_t> expressionCurvesIndices = m_expressionCurves.compact(usedExpressionCurves);
+
+        for (Event& event : m_events) {
+            if (event.isRest) {
+                continue;
+            }
+
+            event.articulationsIdx = articulationsIndices[event.articulationsIdx];
+            event.pitchCurveIdx = pitchCurvesIndices[event.pitchCurveIdx];
+            event.expressionCurveIdx = expressionCurvesIndices[event.expressionCurveIdx];
+        }
+
+        m_compactedTablesSize = tablesSize();
+    }
+
+    Event pack(const timestamp_t originTimestamp, const PlaybackEvent& event)
+    {
+        Event result;
+        result.originTimestamp = originTimestamp;
+
+        if (std::holds_alternative<RestEvent>(event)) {
+            const ArrangementContext& arrangementCtx = std::get<RestEvent>(event).arrangementCtx();
+            packArrangement(arrangementCtx, result);
+            result.isRest = true;
+            return result;
+        }
+
+        const NoteEvent& noteEvent = std::get<NoteEvent>(event);
+        packArrangement(noteEvent.arrangementCtx(), result);
+
+        result.nominalPitchLevel = static_cast<int32_t>(noteEvent.pitchCtx().nominalPitchLevel);
+        result.pitchCurveIdx = m_pitchCurves.intern(noteEvent.pitchCtx().pitchCurve);
+
+        result.nominalDynamicLevel = static_cast<int32_t>(noteEvent.expressionCtx().nominalDynamicLevel);
+        result.expressionCurveIdx = m_expressionCurves.intern(noteEvent.expressionCtx().expressionCurve);
+        result.articulationsIdx = m_articulations.intern(noteEvent.expressionCtx().articulations);
+
+        return result;
+    }
+
+    static void packArrangement(const ArrangementContext& arrangementCtx, Event& result)
+    {
+        result.nominalTimestamp = arrangementCtx.nominalTimestamp;
+        result.actualTimestamp = arrangementCtx.actualTimestamp;
+        result.nominalDuration = arrangementCtx.nominalDuration;
+        result.actualDuration = arrangementCtx.actualDuration;
+        result.voiceLayerIndex = arrangementCtx.voiceLayerIndex;
+    }
+
+    EventList m_events;
+
+    InternTable<ArticulationMap, ArticulationMapHash, ArticulationMapEqual> m_articulations;
+    InternTable<PitchCurve, ValuesCurveHash> m_pitchCurves;
+    InternTable<ExpressionCurve, ValuesCurveHash> m_expressionCurves;
+    size_t m_compactedTablesSize = 0;
+};
+}
+
+#endif // MU_MPE_PACKEDEVENTS_H
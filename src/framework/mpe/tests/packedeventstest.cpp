@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mpe/packedevents.h"
+
+using namespace mu;
+using namespace mu::mpe;
+
+class PackedEventsTest : public ::testing::Test
+{
+protected:
+    //! NOTE Every value gives a note with its own articulations, pitch curve and expression curve
+    static PlaybackEvent noteEvent(const timestamp_t timestamp, const int value)
+    {
+        ArrangementContext arrangementCtx;
+        arrangementCtx.nominalTimestamp = timestamp;
+        arrangementCtx.actualTimestamp = timestamp;
+        arrangementCtx.nominalDuration = 500;
+        arrangementCtx.actualDuration = 500;
+
+        PitchContext pitchCtx;
+        pitchCtx.nominalPitchLevel = pitchLevel(PitchClass::A, 4);
+        pitchCtx.pitchCurve.emplace(0, value);
+
+        ArticulationMeta meta;
+        meta.type = ArticulationType::Standard;
+        meta.timestamp = timestamp;
+        meta.overallDuration = 500 + value;
+
+        ExpressionContext expressionCtx;
+        expressionCtx.articulations.emplace(ArticulationType::Standard, ArticulationAppliedData(meta, 0, HUNDRED_PERCENT));
+        expressionCtx.nominalDynamicLevel = dynamicLevelFromType(DynamicType::Natural);
+        expressionCtx.expressionCurve.emplace(0, value);
+
+        return NoteEvent(std::move(arrangementCtx), std::move(pitchCtx), std::move(expressionCtx));
+    }
+};
+
+/**
+ * @brief PackedEventsTest_ReplaceEvents_TablesDontGrow
+ * @details The same note is replaced many times by a different one, as while editing it.
+ *          The articulations and curves of the replaced notes must not be kept forever
+ */
+TEST_F(PackedEventsTest, ReplaceEvents_TablesDontGrow)
+{
+    // [GIVEN] Packed events of a few notes
+    PlaybackEventsMap events;
+    for (int i = 0; i < 10; ++i) {
+        events[i * 500].push_back(noteEvent(i * 500, i));
+    }
+
+    PackedPlaybackEvents packed;
+    packed.load(events);
+
+    // [WHEN] The first note is replaced many times, every time with new articulations and curves
+    for (int i = 0; i < 10000; ++i) {
+        events[0] = { noteEvent(0, 100 + i) };
+        packed.apply(PlaybackEventsDelta::fromRanges(events, { { 0, 0 } }));
+    }
+
+    // [THEN] The tables only keep a bounded number of values, that are not used anymore
+    EXPECT_LT(packed.articulationsCount(), size_t(1000));
+    EXPECT_LT(packed.curvesCount(), size_t(1000));
+
+    // [THEN] The events are still the same as the events map
+    EXPECT_EQ(packed.toEventsMap(), events);
+}
@@ -210,6 +210,21 @@ void MuseSamplerWrapper::setupSound(const mpe::PlaybackSetupData& setupData)
 }
 
 void MuseSamplerWrapper::loadMainStreamEvents(const mpe::PlaybackEventsMap& events)
+{
+    AbstractSynthesizer::loadMainStreamEvents(events);
+
+    reloadTrack();
+}
+
+void MuseSamplerWrapper::applyMainStreamDelta(const mpe::PlaybackEventsDelta& delta)
+{
+    AbstractSynthesizer::applyMainStreamDelta(delta);
+
+    //! NOTE The sampler track can't be changed partially, so it is refilled from the updated events
+    reloadTrack();
+}
+
+void MuseSamplerWrapper::reloadTrack()
 {
     IF_ASSERT_FAILED(m_samplerLib && m_sampler && m_track) {
         return;
@@ -217,16 +232,13 @@ void MuseSamplerWrapper::loadMainStreamEvents(const mpe::PlaybackEventsMap& even
 
     m_samplerLib->clearTrack(m_sampler, m_track);
 
-    for (const auto& pair : events) {
-        for (const auto& event : pair.second) {
-            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
-                continue;
-            }
-
-            const mpe::NoteEvent& noteEvent = std::get<mpe::NoteEvent>(event);
-
-            addNoteEvent(noteEvent);
+    const mpe::PackedPlaybackEvents& events = m_mainStreamEvents.events();
+    for (const mpe::PackedPlaybackEvents::Event& event : events.events()) {
+        if (event.isRest) {
+            continue;
         }
+
+        addNoteEvent(std::get<mpe::NoteEvent>(events.event(event)));
     }
 
     if (m_samplerLib->finalizeScore(m_sampler) != ms_Result_OK) {
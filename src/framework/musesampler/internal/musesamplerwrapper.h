@@ -51,10 +51,12 @@ protected:
     void setupSound(const mpe::PlaybackSetupData& setupData) override;
 
     void loadMainStreamEvents(const mpe::PlaybackEventsMap& events) override;
+    void applyMainStreamDelta(const mpe::PlaybackEventsDelta& delta) override;
     void loadOffStreamEvents(const mpe::PlaybackEventsMap& events) override;
     void loadDynamicLevelChanges(const mpe::DynamicLevelMap& dynamicLevels) override;
 
     void extractOutputSamples(audio::samples_t samples, float* output);
+    void reloadTrack();
     void addNoteEvent(const mpe::NoteEvent& noteEvent);
     int pitchIndex(const mpe::pitch_level_t pitchLevel) const;
 
@@ -182,13 +182,10 @@ void VstSynthesiser::handleMainStreamEvents(const audio::msecs_t nextMsecs)
 
     audio::msecs_t to = from + nextMsecs;
 
-    EventsMapIteratorList range = m_mainStreamEvents.findEventsRange(from, to);
-
-    for (const auto& it : range) {
-        for (const mpe::PlaybackEvent& event : it->second) {
-            if (m_vstAudioClient->handleNoteOnEvents(event, from, from + nextMsecs)) {
-                m_playingEvents.emplace_back(event);
-            }
+    for (uint32_t idx : m_mainStreamEvents.findEvents(from, to)) {
+        mpe::PlaybackEvent event = m_mainStreamEvents.event(idx);
+        if (m_vstAudioClient->handleNoteOnEvents(event, from, from + nextMsecs)) {
+            m_playingEvents.emplace_back(std::move(event));
         }
     }
 
@@ -202,13 +199,10 @@ void VstSynthesiser::handleOffStreamEvents(const audio::msecs_t nextMsecs)
     audio::msecs_t from = m_offStreamEvents.from;
     audio::msecs_t to = m_offStreamEvents.to;
 
-    EventsMapIteratorList range = m_offStreamEvents.findEventsRange(from, to);
-
-    for (const auto& it : range) {
-        for (const mpe::PlaybackEvent& event : it->second) {
-            if (m_vstAudioClient->handleNoteOnEvents(event, from, from + nextMsecs)) {
-                m_playingEvents.emplace_back(event);
-            }
+    for (uint32_t idx : m_offStreamEvents.findEvents(from, from + nextMsecs)) {
+        mpe::PlaybackEvent event = m_offStreamEvents.event(idx);
+        if (m_vstAudioClient->handleNoteOnEvents(event, from, from + nextMsecs)) {
+            m_playingEvents.emplace_back(std::move(event));
         }
     }
 
@@ -93,6 +93,10 @@ void AbstractAudioWriter::doWriteAndWait(io::Device& destinationDevice, const au
     playback()->sequenceIdList()
     .onResolve(this, [this, path, &format](const audio::TrackSequenceIdList& sequenceIdList) {
         for (const audio::TrackSequenceId sequenceId : sequenceIdList) {
+            playback()->audioOutput()->saveSoundTrackProgress(sequenceId).onReceive(this, [this](const framework::Progress& progress) {
+                m_progress.send(progress);
+            });
+
             playback()->audioOutput()->saveSoundTrack(sequenceId, io::path_t(path), std::move(format))
             .onResolve(this, [this, path](const bool /*result*/) {
                 LOGD() << "Successfully saved sound track by path: " << path;
@@ -1055,6 +1055,7 @@ QString ExportBrailleImpl::brailleMeasure(Measure* measure, int staffCount)
     }
 
     auto spanners = score->spannerMap().findOverlapping(measure->tick().ticks(), measure->endTick().ticks());
+    SpannerMap::sortByPosition(spanners);
     for (auto interval : spanners) {
         Spanner* s = interval.value;
         if (s && s->isVolta()) {
@@ -2166,6 +2167,7 @@ std::vector<Slur*> ExportBrailleImpl::slurs(ChordRest* chordRest)
     std::vector<Slur*> result;
     SpannerMap& smap = score->spannerMap();
     auto spanners = smap.findOverlapping(chordRest->tick().ticks(), chordRest->tick().ticks());
+    SpannerMap::sortByPosition(spanners);
     for (auto interval : spanners) {
         Spanner* spanner = interval.value;
         if (spanner && spanner->isSlur()
@@ -2183,6 +2185,7 @@ std::vector<Hairpin*> ExportBrailleImpl::hairpins(ChordRest* chordRest)
     std::vector<Hairpin*> result;
     SpannerMap& smap = score->spannerMap();
     auto spanners = smap.findOverlapping(chordRest->tick().ticks(), chordRest->tick().ticks());
+    SpannerMap::sortByPosition(spanners);
     for (auto interval : spanners) {
         Spanner* spanner = interval.value;
         if (spanner && spanner->isHairpin()
@@ -51,9 +51,9 @@ void ImagesExportModule::resolveImports()
 {
     auto writers = modularity::ioc()->resolve<INotationWritersRegister>(moduleName());
     if (writers) {
-        writers->reg({ "pdf" }, std::make_shared<PdfWriter>());
-        writers->reg({ "svg" }, std::make_shared<SvgWriter>());
-        writers->reg({ "png" }, std::make_shared<PngWriter>());
+        writers->regCreator({ "pdf" }, []() { return std::make_shared<PdfWriter>(); });
+        writers->regCreator({ "svg" }, []() { return std::make_shared<SvgWriter>(); });
+        writers->regCreator({ "png" }, []() { return std::make_shared<PngWriter>(); });
     }
 }
 
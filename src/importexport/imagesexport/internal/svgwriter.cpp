@@ -56,13 +56,7 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    mu::engraving::MScore::pdfPrinting = true;
-    mu::engraving::MScore::svgPrinting = true;
-
     const std::vector<mu::engraving::Page*>& pages = score->pages();
-    double pixelRationBackup = mu::engraving::MScore::pixelRatio;
 
     const size_t PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
     if (PAGE_NUMBER >= pages.size()) {
@@ -72,6 +66,14 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
     mu::engraving::Page* page = pages.at(PAGE_NUMBER);
 
     SvgGenerator printer;
+
+    mu::engraving::RenderContext renderContext;
+    renderContext.pixelRatio = mu::engraving::DPI / printer.logicalDpiX();
+    renderContext.printing = true; // don’t print page break symbols etc.
+    renderContext.pdfPrinting = true;
+    renderContext.svgPrinting = true;
+    mu::engraving::RenderContext::Scope renderScope(renderContext);
+
     QString title(score->name());
     printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(PAGE_NUMBER + 1) : title);
     printer.setOutputDevice(&destinationDevice);
@@ -94,8 +96,6 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
         painter.translate(-pageRect.topLeft());
     }
 
-    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / printer.logicalDpiX();
-
     if (!options[OptionKey::TRANSPARENT_BACKGROUND].toBool()) {
         painter.fillRect(pageRect, mu::draw::Color::white);
     }
@@ -175,7 +175,10 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
                     continue;
                 }
 
+                //! NOTE The colors are set only if they differ, so once the first page is written,
+                //! the other pages can be written concurrently without modifying the score
                 if (beatsColors.contains(beatIndex)) {
+                    const mu::draw::Color color = beatsColors.value(beatIndex);
                     for (EngravingItem* element : segment->elist()) {
                         if (!element) {
                             continue;
@@ -183,10 +186,12 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
 
                         if (element->isChord()) {
                             for (Note* note : toChord(element)->notes()) {
-                                note->setColor(beatsColors[beatIndex]);
+                                if (note->color() != color) {
+                                    note->setColor(color);
+                                }
                             }
-                        } else if (element->isChordRest()) {
-                            element->setColor(beatsColors[beatIndex]);
+                        } else if (element->isChordRest() && element->color() != color) {
+                            element->setColor(color);
                         }
                     }
                 }
@@ -224,12 +229,6 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
 
     painter.endDraw(); // Writes MuseScore SVG file to disk, finally
 
-    // Clean up and return
-    mu::engraving::MScore::pixelRatio = pixelRationBackup;
-    score->setPrinting(false);
-    mu::engraving::MScore::pdfPrinting = false;
-    mu::engraving::MScore::svgPrinting = false;
-
     return true;
 }
 
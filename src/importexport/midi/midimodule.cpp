@@ -56,7 +56,7 @@ void MidiModule::resolveImports()
 
     auto writers = modularity::ioc()->resolve<INotationWritersRegister>(moduleName());
     if (writers) {
-        writers->reg({ "mid", "midi", "kar" }, std::make_shared<NotationMidiWriter>());
+        writers->regCreator({ "mid", "midi", "kar" }, []() { return std::make_shared<NotationMidiWriter>(); });
     }
 }
 
@@ -39,6 +39,14 @@ public:
     virtual bool musicxmlImportLayout() const = 0;
     virtual void setMusicxmlImportLayout(bool value) = 0;
 
+    //! NOTE DuringImport validates the file on a separate thread, while the first pass of the import runs
+    enum class MusicxmlImportValidationType {
+        BeforeImport, DuringImport, Skip
+    };
+
+    virtual MusicxmlImportValidationType musicxmlImportValidationType() const = 0;
+    virtual void setMusicxmlImportValidationType(MusicxmlImportValidationType validationType) = 0;
+
     virtual bool musicxmlExportLayout() const = 0;
     virtual void setMusicxmlExportLayout(bool value) = 0;
 
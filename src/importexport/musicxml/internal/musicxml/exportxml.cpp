@@ -1683,6 +1683,7 @@ static Volta* findVolta(const Measure* const m, bool left)
     Fraction stick = m->tick();
     Fraction etick = m->tick() + m->ticks();
     auto spanners = m->score()->spannerMap().findOverlapping(stick.ticks(), etick.ticks());
+    SpannerMap::sortByPosition(spanners);
     for (auto i : spanners) {
         Spanner* el = i.value;
         if (el->type() != ElementType::VOLTA) {
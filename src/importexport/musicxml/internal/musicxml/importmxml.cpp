@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QElapsedTimer>
 #include <QMessageBox>
 
 #include "importmxml.h"
@@ -27,6 +28,8 @@
 #include "importmxmlpass1.h"
 #include "importmxmlpass2.h"
 
+#include "log.h"
+
 namespace mu::engraving {
 //---------------------------------------------------------
 //   musicXMLImportErrorDialog
@@ -50,9 +53,12 @@ static int musicXMLImportErrorDialog(QString text, QString detailedText)
 
 //---------------------------------------------------------
 //   importMusicXMLfromBuffer
+//    afterPass1, if set, is called between the passes,
+//    an error returned by it stops the import
 //---------------------------------------------------------
 
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev)
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev,
+                                          const std::function<Score::FileError()>& afterPass1)
 {
     //LOGD("importMusicXMLfromBuffer(score %p, name '%s', dev %p)",
     //       score, qPrintable(name), dev);
@@ -62,18 +68,31 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
     //logger.setLoggingLevel(MxmlLogger::Level::MXML_INFO);
     //logger.setLoggingLevel(MxmlLogger::Level::MXML_TRACE); // also include tracing
 
+    QElapsedTimer timer;
+    timer.start();
+
     // pass 1
     dev->seek(0);
     MusicXMLParserPass1 pass1(score, &logger);
     Score::FileError res = pass1.parse(dev);
     const auto pass1_errors = pass1.errors();
+    const qint64 pass1Time = timer.elapsed();
+
+    if (res == Score::FileError::FILE_NO_ERROR && afterPass1) {
+        res = afterPass1();
+        if (res != Score::FileError::FILE_NO_ERROR) {
+            return res;
+        }
+    }
 
     // pass 2
+    timer.restart();
     MusicXMLParserPass2 pass2(score, pass1, &logger);
     if (res == Score::FileError::FILE_NO_ERROR) {
         dev->seek(0);
         res = pass2.parse(dev);
     }
+    LOGI("MusicXML import: pass 1 %lld ms, pass 2 %lld ms", pass1Time, timer.elapsed());
 
     // report result
     const auto pass2_errors = pass2.errors();
@@ -24,16 +24,33 @@
  MusicXML import.
  */
 
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <QMessageBox>
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
 #include <QBuffer>
+#include <QElapsedTimer>
 
 #include "serialization/internal/qzipreader_p.h"
 #include "importmxml.h"
+#include "modularity/ioc.h"
+#include "importexport/musicxml/imusicxmlconfiguration.h"
 
+#include "runtime.h"
 #include "log.h"
 
+using MusicxmlImportValidationType = mu::iex::musicxml::IMusicXmlConfiguration::MusicxmlImportValidationType;
+
+static MusicxmlImportValidationType musicxmlImportValidationType()
+{
+    auto conf = mu::modularity::ioc()->resolve<mu::iex::musicxml::IMusicXmlConfiguration>("iex_musicxml");
+    return conf ? conf->musicxmlImportValidationType() : MusicxmlImportValidationType::BeforeImport;
+}
+
 namespace mu::engraving {
 //---------------------------------------------------------
 //   tupletAssert -- check assertions for tuplet handling
@@ -104,6 +121,48 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
     return true;
 }
 
+//---------------------------------------------------------
+//   takeMusicXmlSchema, returnMusicXmlSchema
+//    QXmlSchema is reentrant, but not thread safe, so a compiled
+//    schema may only be used by one validation at a time.
+//    A validation takes a schema and returns it when done,
+//    a schema is compiled only if all of them are in use,
+//    so usually only one is compiled per process
+//---------------------------------------------------------
+
+static std::mutex s_musicXmlSchemasMutex;
+static std::vector<std::unique_ptr<QXmlSchema> > s_musicXmlSchemas;
+
+static std::unique_ptr<QXmlSchema> takeMusicXmlSchema()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_musicXmlSchemasMutex);
+        if (!s_musicXmlSchemas.empty()) {
+            std::unique_ptr<QXmlSchema> schema = std::move(s_musicXmlSchemas.back());
+            s_musicXmlSchemas.pop_back();
+            return schema;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::unique_ptr<QXmlSchema> schema = std::make_unique<QXmlSchema>();
+    if (!initMusicXmlSchema(*schema)) {
+        return nullptr;
+    }
+
+    LOGI("MusicXML schema compiled in %lld ms", timer.elapsed());
+
+    return schema;
+}
+
+static void returnMusicXmlSchema(std::unique_ptr<QXmlSchema> schema)
+{
+    std::lock_guard<std::mutex> lock(s_musicXmlSchemasMutex);
+    s_musicXmlSchemas.push_back(std::move(schema));
+}
+
 //---------------------------------------------------------
 //   musicXMLValidationErrorDialog
 //---------------------------------------------------------
@@ -183,37 +242,65 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 }
 
 //---------------------------------------------------------
-//   doValidate
+//   ValidationResult
+//---------------------------------------------------------
+
+struct ValidationResult {
+    bool valid = true;
+    QString errors;
+};
+
+//---------------------------------------------------------
+//   validate
 //---------------------------------------------------------
 
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Validate MusicXML data from file \a name contained in QIODevice \a dev against the compiled schema.
+ Doesn't interact with the user and uses a schema of its own, so it may run on any thread,
+ also at the same time as other validations.
  */
 
-static Score::FileError doValidate(const QString& name, QIODevice* dev)
+static Score::FileError validate(const QString& name, QIODevice* dev, ValidationResult& result)
 {
-    //QElapsedTimer t;
-    //t.start();
-
-    // initialize the schema
-    ValidatorMessageHandler messageHandler;
-    QXmlSchema schema;
-    schema.setMessageHandler(&messageHandler);
-    if (!initMusicXmlSchema(schema)) {
+    std::unique_ptr<QXmlSchema> schema = takeMusicXmlSchema();
+    if (!schema) {
         return Score::FileError::FILE_BAD_FORMAT;      // appropriate error message has been printed by initMusicXmlSchema
     }
+
+    QElapsedTimer timer;
+    timer.start();
+
     // validate the data
-    QXmlSchemaValidator validator(schema);
-    bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
-    //LOGD("Validation time elapsed: %d ms", t.elapsed());
+    ValidatorMessageHandler messageHandler;
+    QXmlSchemaValidator validator(*schema);
+    validator.setMessageHandler(&messageHandler);
+    result.valid = validator.validate(dev, QUrl::fromLocalFile(name));
+    result.errors = messageHandler.getErrors();
+
+    LOGI("MusicXML validation: %lld ms", timer.elapsed());
+
+    returnMusicXmlSchema(std::move(schema));
+
+    return Score::FileError::FILE_NO_ERROR;
+}
+
+//---------------------------------------------------------
+//   checkValidationResult
+//---------------------------------------------------------
+
+/**
+ Report an invalid MusicXML file \a name and ask the user whether to import it anyway.
+ */
 
-    if (!valid) {
+static Score::FileError checkValidationResult(const QString& name, const ValidationResult& result)
+{
+    if (!result.valid) {
         LOGD("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
         MScore::lastError = QObject::tr("File '%1' is not a valid MusicXML file").arg(name);
         if (MScore::noGui) {
             return Score::FileError::FILE_NO_ERROR;         // might as well try anyhow in converter mode
         }
-        if (musicXMLValidationErrorDialog(MScore::lastError, messageHandler.getErrors()) != QMessageBox::Yes) {
+        if (musicXMLValidationErrorDialog(MScore::lastError, result.errors) != QMessageBox::Yes) {
             return Score::FileError::FILE_USER_ABORT;
         }
     }
@@ -222,6 +309,82 @@ static Score::FileError doValidate(const QString& name, QIODevice* dev)
     return Score::FileError::FILE_NO_ERROR;
 }
 
+//---------------------------------------------------------
+//   doValidate
+//---------------------------------------------------------
+
+/**
+ Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ */
+
+static Score::FileError doValidate(const QString& name, QIODevice* dev)
+{
+    ValidationResult result;
+    Score::FileError res = validate(name, dev, result);
+    if (res != Score::FileError::FILE_NO_ERROR) {
+        return res;
+    }
+
+    return checkValidationResult(name, result);
+}
+
+//---------------------------------------------------------
+//   doValidateDuringImport
+//---------------------------------------------------------
+
+/**
+ Validate MusicXML data from file \a name contained in QIODevice \a dev on a separate thread
+ while the first pass of the import runs, and import it into score \a score.
+ The result of the validation is checked before the second pass.
+ */
+
+static Score::FileError doValidateDuringImport(Score* score, const QString& name, QIODevice* dev)
+{
+    // compile the schema here, so that the errors are reported on this thread
+    std::unique_ptr<QXmlSchema> schema = takeMusicXmlSchema();
+    if (!schema) {
+        return Score::FileError::FILE_BAD_FORMAT;      // appropriate error message has been printed by initMusicXmlSchema
+    }
+    returnMusicXmlSchema(std::move(schema));
+
+    // the validation and the import read the data through their own buffers
+    dev->seek(0);
+    const QByteArray data = dev->readAll();
+
+    ValidationResult validationResult;
+    Score::FileError validationRes = Score::FileError::FILE_NO_ERROR;
+
+    std::thread validationThread([&name, &data, &validationResult, &validationRes]() {
+        runtime::setThreadName("mxml_validation");
+
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        validationRes = validate(name, &buffer, validationResult);
+    });
+
+    auto waitValidation = [&validationThread, &validationRes, &validationResult, &name]() {
+        validationThread.join();
+        if (validationRes != Score::FileError::FILE_NO_ERROR) {
+            return validationRes;
+        }
+        return checkValidationResult(name, validationResult);
+    };
+
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    Score::FileError res = importMusicXMLfromBuffer(score, name, &buffer, waitValidation);
+
+    // pass 1 has failed, the validation result is not needed
+    if (validationThread.joinable()) {
+        validationThread.join();
+    }
+
+    return res;
+}
+
 //---------------------------------------------------------
 //   doValidateAndImport
 //---------------------------------------------------------
@@ -235,6 +398,15 @@ static Score::FileError doValidateAndImport(Score* score, const QString& name, Q
     // verify tuplet DurationType dependencies
     tupletAssert();
 
+    switch (musicxmlImportValidationType()) {
+    case MusicxmlImportValidationType::BeforeImport:
+        break;
+    case MusicxmlImportValidationType::DuringImport:
+        return doValidateDuringImport(score, name, dev);
+    case MusicxmlImportValidationType::Skip:
+        return importMusicXMLfromBuffer(score, name, dev);
+    }
+
     // validate the file
     Score::FileError res;
     res = doValidate(name, dev);
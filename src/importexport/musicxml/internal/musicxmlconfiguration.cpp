@@ -30,6 +30,7 @@ static const std::string module_name("iex_musicxml");
 
 static const Settings::Key MUSICXML_IMPORT_BREAKS_KEY(module_name, "import/musicXML/importBreaks");
 static const Settings::Key MUSICXML_IMPORT_LAYOUT_KEY(module_name, "import/musicXML/importLayout");
+static const Settings::Key MUSICXML_IMPORT_VALIDATION_KEY(module_name, "import/musicXML/validation");
 static const Settings::Key MUSICXML_EXPORT_LAYOUT_KEY(module_name, "export/musicXML/exportLayout");
 static const Settings::Key MUSICXML_EXPORT_BREAKS_TYPE_KEY(module_name, "export/musicXML/exportBreaks");
 static const Settings::Key MUSICXML_EXPORT_INVISIBLE_ELEMENTS_KEY(module_name, "export/musicXML/exportInvisibleElements");
@@ -41,6 +42,7 @@ void MusicXmlConfiguration::init()
 {
     settings()->setDefaultValue(MUSICXML_IMPORT_BREAKS_KEY, Val(true));
     settings()->setDefaultValue(MUSICXML_IMPORT_LAYOUT_KEY, Val(true));
+    settings()->setDefaultValue(MUSICXML_IMPORT_VALIDATION_KEY, Val(MusicxmlImportValidationType::BeforeImport));
     settings()->setDefaultValue(MUSICXML_EXPORT_LAYOUT_KEY, Val(true));
     settings()->setDefaultValue(MUSICXML_EXPORT_BREAKS_TYPE_KEY, Val(MusicxmlExportBreaksType::All));
     settings()->setDefaultValue(MUSICXML_EXPORT_INVISIBLE_ELEMENTS_KEY, Val(false));
@@ -67,6 +69,16 @@ void MusicXmlConfiguration::setMusicxmlImportLayout(bool value)
     settings()->setSharedValue(MUSICXML_IMPORT_LAYOUT_KEY, Val(value));
 }
 
+MusicXmlConfiguration::MusicxmlImportValidationType MusicXmlConfiguration::musicxmlImportValidationType() const
+{
+    return settings()->value(MUSICXML_IMPORT_VALIDATION_KEY).toEnum<MusicxmlImportValidationType>();
+}
+
+void MusicXmlConfiguration::setMusicxmlImportValidationType(MusicxmlImportValidationType validationType)
+{
+    settings()->setSharedValue(MUSICXML_IMPORT_VALIDATION_KEY, Val(validationType));
+}
+
 bool MusicXmlConfiguration::musicxmlExportLayout() const
 {
     return settings()->value(MUSICXML_EXPORT_LAYOUT_KEY).toBool();
@@ -36,6 +36,9 @@ public:
     bool musicxmlImportLayout() const override;
     void setMusicxmlImportLayout(bool value) override;
 
+    MusicxmlImportValidationType musicxmlImportValidationType() const override;
+    void setMusicxmlImportValidationType(MusicxmlImportValidationType validationType) override;
+
     bool musicxmlExportLayout() const override;
     void setMusicxmlExportLayout(bool value) override;
 
@@ -70,7 +70,7 @@ void MusicXmlModule::resolveImports()
 
     auto writers = modularity::ioc()->resolve<INotationWritersRegister>(moduleName());
     if (writers) {
-        writers->reg({ "musicxml", "xml" }, std::make_shared<MusicXmlWriter>());
-        writers->reg({ "mxl", "mxml" }, std::make_shared<MxlWriter>());
+        writers->regCreator({ "musicxml", "xml" }, []() { return std::make_shared<MusicXmlWriter>(); });
+        writers->regCreator({ "mxl", "mxml" }, []() { return std::make_shared<MxlWriter>(); });
     }
 }
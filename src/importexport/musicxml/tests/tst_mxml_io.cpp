@@ -52,6 +52,7 @@ static const std::string PREF_EXPORT_MUSICXML_EXPORTBREAKS("export/musicXML/expo
 static const std::string PREF_IMPORT_MUSICXML_IMPORTBREAKS("import/musicXML/importBreaks");
 static const std::string PREF_EXPORT_MUSICXML_EXPORTLAYOUT("export/musicXML/exportLayout");
 static const std::string PREF_EXPORT_MUSICXML_EXPORTINVISIBLE("export/musicXML/exportInvisibleElements");
+static const std::string PREF_IMPORT_MUSICXML_VALIDATION("import/musicXML/validation");
 
 //---------------------------------------------------------
 //   TestMxmlIO
@@ -70,6 +71,7 @@ class TestMxmlIO : public QObject, public MTest
     void mxmlReadTestCompr(const char* file);
     void mxmlReadWriteTestCompr(const char* file);
     void mxmlImportTestRef(const char* file);
+    void mxmlIoTestValidation(const char* file, IMusicXmlConfiguration::MusicxmlImportValidationType validationType);
 
     // The list of MusicXML regression tests
     // Currently failing tests are commented out and annotated with the failure reason
@@ -259,6 +261,8 @@ private slots:
     void uninitializedDivisions() { mxmlIoTestRef("testUninitializedDivisions"); }
     void unnecessaryBarlines() { mxmlImportTestRef("testUnnecessaryBarlines"); }
     void unusualDurations() { mxmlIoTestRef("testUnusualDurations"); }
+    void validationDuringImport() { mxmlIoTestValidation("testHello", IMusicXmlConfiguration::MusicxmlImportValidationType::DuringImport); }
+    void validationSkipped() { mxmlIoTestValidation("testHello", IMusicXmlConfiguration::MusicxmlImportValidationType::Skip); }
     void virtualInstruments() { mxmlIoTestRef("testVirtualInstruments"); }
     void voiceMapper1() { mxmlIoTestRef("testVoiceMapper1"); }
     void voiceMapper2() { mxmlIoTestRef("testVoiceMapper2"); }
@@ -537,5 +541,18 @@ void TestMxmlIO::mxmlImportTestRef(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   mxmlIoTestValidation
+//   read a MusicXML file, validating it along with the import or not at all,
+//   write to a new file and verify both files are identical
+//---------------------------------------------------------
+
+void TestMxmlIO::mxmlIoTestValidation(const char* file, IMusicXmlConfiguration::MusicxmlImportValidationType validationType)
+{
+    setValue(PREF_IMPORT_MUSICXML_VALIDATION, Val(validationType));
+    mxmlIoTest(file);
+    setValue(PREF_IMPORT_MUSICXML_VALIDATION, Val(IMusicXmlConfiguration::MusicxmlImportValidationType::BeforeImport));
+}
+
 QTEST_MAIN(TestMxmlIO)
 #include "tst_mxml_io.moc"
@@ -136,6 +136,9 @@ public:
     virtual void setIsLimitCanvasScrollArea(bool limited) = 0;
     virtual async::Notification isLimitCanvasScrollAreaChanged() const = 0;
 
+    virtual bool isCanvasTileCacheEnabled() const = 0;
+    virtual void setIsCanvasTileCacheEnabled(bool enabled) = 0;
+
     virtual bool colorNotesOutsideOfUsablePitchRange() const = 0;
     virtual void setColorNotesOutsideOfUsablePitchRange(bool value) = 0;
 
@@ -132,6 +132,7 @@ void Notation::setScore(mu::engraving::Score* score)
     }
 
     m_score = score;
+
     m_scoreInited.notify();
 }
 
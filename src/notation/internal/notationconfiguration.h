@@ -142,6 +142,9 @@ public:
     void setIsLimitCanvasScrollArea(bool limited) override;
     async::Notification isLimitCanvasScrollAreaChanged() const override;
 
+    bool isCanvasTileCacheEnabled() const override;
+    void setIsCanvasTileCacheEnabled(bool enabled) override;
+
     bool colorNotesOutsideOfUsablePitchRange() const override;
     void setColorNotesOutsideOfUsablePitchRange(bool value) override;
 
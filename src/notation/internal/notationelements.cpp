@@ -39,10 +39,7 @@ NotationElements::NotationElements(IGetScore* getScore)
 
 mu::engraving::Score* NotationElements::msScore() const
 {
-    IF_ASSERT_FAILED(m_getScore) {
-        return nullptr;
-    }
-    return m_getScore->score();
+    return score();
 }
 
 EngravingItem* NotationElements::search(const std::string& searchText) const
@@ -187,7 +184,14 @@ mu::engraving::Score* NotationElements::score() const
         return nullptr;
     }
 
-    return m_getScore->score();
+    mu::engraving::Score* score = m_getScore->score();
+
+    //! NOTE The layout of parts, that are not open, is deferred until their pages are needed
+    if (score) {
+        score->ensureLayout();
+    }
+
+    return score;
 }
 
 ElementPattern* NotationElements::constructElementPattern(const FilterElementsOptions* elementOptions) const
@@ -398,6 +398,8 @@ Staff* NotationInteraction::hitStaff(const PointF& pos) const
 
 mu::engraving::Page* NotationInteraction::point2page(const PointF& p) const
 {
+    score()->ensureLayout();
+
     if (score()->linearMode()) {
         return score()->pages().empty() ? 0 : score()->pages().front();
     }
@@ -1833,6 +1835,8 @@ void NotationInteraction::doAddSlur(ChordRest* firstChordRest, ChordRest* second
 
 bool NotationInteraction::scoreHasMeasure() const
 {
+    score()->ensureLayout();
+
     mu::engraving::Page* page = score()->pages().empty() ? nullptr : score()->pages().front();
     const std::vector<mu::engraving::System*>* systems = page ? &page->systems() : nullptr;
     if (systems == nullptr || systems->empty() || systems->front()->measures().empty()) {
@@ -44,7 +44,14 @@ NotationPainting::NotationPainting(Notation* notation)
 
 mu::engraving::Score* NotationPainting::score() const
 {
-    return m_notation->score();
+    mu::engraving::Score* score = m_notation->score();
+
+    //! NOTE The layout of parts, that are not open, is deferred until their pages are needed
+    if (score) {
+        score->ensureLayout();
+    }
+
+    return score;
 }
 
 void NotationPainting::setViewMode(const ViewMode& viewMode)
@@ -144,9 +151,20 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
     }
 
     // Setup score draw system
-    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / DEVICE_DPI;
-    score()->setPrinting(opt.isPrinting);
-    mu::engraving::MScore::pdfPrinting = opt.isPrinting;
+    //! NOTE The context is bound to the calling thread for the time of painting,
+    //! so different pages and notations can be painted concurrently
+    mu::engraving::RenderContext renderContext = mu::engraving::RenderContext::current();
+    renderContext.pixelRatio = mu::engraving::DPI / DEVICE_DPI;
+    renderContext.printing = opt.isPrinting;
+    renderContext.pdfPrinting = opt.isPrinting;
+    mu::engraving::RenderContext::Scope renderScope(renderContext);
+
+    //! NOTE Full pages in printing mode (export, print) are painted from the retained display lists,
+    //! so repeated exports of an unchanged score skip the traversal of the elements
+    bool useDisplayLists = opt.isPrinting && !opt.frameRect.isValid();
+    if (useDisplayLists) {
+        m_pageDisplayLists.removeStale(pages);
+    }
 
     // Setup page counts
     int fromPage = opt.fromPage >= 0 ? opt.fromPage : 0;
@@ -202,8 +220,10 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
             // Draw page elements
             painter->setClipping(true);
             painter->setClipRect(pageRect);
-            std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
-            engraving::Paint::paintElements(*painter, elements, opt.isPrinting);
+            if (!useDisplayLists || !m_pageDisplayLists.paintPage(*painter, page)) {
+                std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
+                engraving::Paint::paintElements(*painter, elements, opt.isPrinting);
+            }
             painter->setClipping(false);
 
 #ifdef ENGRAVING_PAINT_DEBUGGER_ENABLED
@@ -224,10 +244,6 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
                 }
             }
         }
-
-        if (!opt.isPrinting) {
-            static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
-        }
     }
 }
 
@@ -287,6 +303,32 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     opt.deviceDpi = uiConfiguration()->logicalDpi();
     opt.isPrinting = isPrinting;
     doPaint(painter, opt);
+
+    if (!isPrinting) {
+        paintViewInteraction(painter);
+    }
+}
+
+void NotationPainting::paintViewPage(Painter* painter, int pageIndex, const RectF& frameRect, bool isPrinting)
+{
+    Options opt;
+    opt.isSetViewport = false;
+    opt.isMultiPage = true;
+    opt.frameRect = frameRect;
+    opt.fromPage = pageIndex;
+    opt.toPage = pageIndex;
+    opt.deviceDpi = uiConfiguration()->logicalDpi();
+    opt.isPrinting = isPrinting;
+    doPaint(painter, opt);
+}
+
+void NotationPainting::paintViewInteraction(Painter* painter)
+{
+    if (!score()) {
+        return;
+    }
+
+    static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
 }
 
 void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
@@ -29,6 +29,7 @@
 #include "../inotationconfiguration.h"
 #include "engraving/iengravingconfiguration.h"
 #include "ui/iuiconfiguration.h"
+#include "engraving/paint/pagedisplaylists.h"
 
 namespace mu::engraving {
 class Score;
@@ -53,6 +54,8 @@ public:
     SizeF pageSizeInch() const override;
 
     void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    void paintViewPage(draw::Painter* painter, int pageIndex, const RectF& frameRect, bool isPrinting) override;
+    void paintViewInteraction(draw::Painter* painter) override;
     void paintPdf(draw::Painter* painter, const Options& opt) override;
     void paintPrint(draw::Painter* painter, const Options& opt) override;
     void paintPng(draw::Painter* painter, const Options& opt) override;
@@ -67,6 +70,7 @@ private:
                         bool printPageBackground) const;
 
     Notation* m_notation = nullptr;
+    mu::engraving::PageDisplayLists m_pageDisplayLists;
 };
 }
 
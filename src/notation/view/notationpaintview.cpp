@@ -21,7 +21,13 @@
  */
 #include "notationpaintview.h"
 
+#include <cmath>
+
+#include <QElapsedTimer>
 #include <QPainter>
+#include <QQuickWindow>
+
+#include "engraving/libmscore/page.h"
 
 #include "actions/actiontypes.h"
 #include "stringutils.h"
@@ -35,6 +41,8 @@ using namespace mu::notation;
 static constexpr qreal SCROLL_LIMIT_OFF_OFFSET = 0.75;
 static constexpr qreal SCROLL_LIMIT_ON_OFFSET = 0.02;
 
+static constexpr size_t PAINT_STATISTICS_INTERVAL = 100;
+
 NotationPaintView::NotationPaintView(QQuickItem* parent)
     : QQuickPaintedItem(parent)
 {
@@ -226,8 +234,13 @@ void NotationPaintView::onCurrentNotationChanged()
 
     INotationInteractionPtr interaction = notationInteraction();
 
+    invalidateTiles();
+
+    //! NOTE The tiles of the pages, that the edit didn't touch, are kept, see NotationTileCache::tile
     m_notation->notationChanged().onNotify(this, [this, interaction]() {
         interaction->hideShadowNote();
+        m_selectedElementsRects = selectedElementsRects();
+        m_notationChangedSinceLastPaint = true;
         update();
     });
 
@@ -237,6 +250,7 @@ void NotationPaintView::onCurrentNotationChanged()
     });
 
     interaction->selectionChanged().onNotify(this, [this]() {
+        invalidateSelectionTiles();
         update();
     });
 
@@ -434,6 +448,9 @@ void NotationPaintView::paint(QPainter* qp)
 {
     TRACEFUNC;
 
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+
     mu::draw::Painter mup(qp, objectName().toStdString());
     mu::draw::Painter* painter = &mup;
 
@@ -448,10 +465,18 @@ void NotationPaintView::paint(QPainter* qp)
     Transform guiScalingCompensation;
     guiScalingCompensation.scale(guiScaling, guiScaling);
 
-    painter->setWorldTransform(m_matrix * guiScalingCompensation);
+    Transform transform = m_matrix * guiScalingCompensation;
 
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    if (paintTiles(painter, rect, transform, isPrinting)) {
+        painter->setWorldTransform(transform);
+        if (!isPrinting) {
+            notation()->painting()->paintViewInteraction(painter);
+        }
+    } else {
+        painter->setWorldTransform(transform);
+        notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    }
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -466,6 +491,160 @@ void NotationPaintView::paint(QPainter* qp)
         ctx.fromLogical = [this](const PointF& pos) -> PointF { return fromLogical(pos); };
         m_continuousPanel->paint(*painter, ctx);
     }
+
+    updatePaintStatistics(paintTimer.nsecsElapsed() / 1000000.0);
+}
+
+bool NotationPaintView::paintTiles(draw::Painter* painter, const RectF& rect, const Transform& transform, bool isPrinting)
+{
+    TRACEFUNC;
+
+    if (!configuration()->isCanvasTileCacheEnabled()) {
+        return false;
+    }
+
+    //! NOTE Right after an edit paint directly, so that continuous edits (ex. dragging)
+    //! don't pay for rendering tiles, that are thrown away with the next edit
+    if (m_notationChangedSinceLastPaint) {
+        m_notationChangedSinceLastPaint = false;
+        return false;
+    }
+
+    const qreal scaling = transform.m11();
+    const qreal devicePixelRatio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    const qreal tileSize = NotationTileCache::TILE_SIZE;
+
+    //! NOTE The page border is drawn across the page edge
+    const qreal margin = std::ceil(configuration()->borderWidth() * scaling) + 2.0;
+
+    auto snapToDevicePixel = [devicePixelRatio](qreal value) {
+        return std::round(value * devicePixelRatio) / devicePixelRatio;
+    };
+
+    m_tileCache.beginFrame();
+    painter->setWorldTransform(Transform());
+
+    const PageList pages = notationElements()->pages();
+    for (int pageIndex = 0; pageIndex < static_cast<int>(pages.size()); ++pageIndex) {
+        const Page* page = pages.at(pageIndex);
+        const PointF pagePos = page->pos();
+        const RectF pageRect = transform.map(page->bbox().translated(pagePos));
+
+        //! NOTE Tiles are anchored at the page, so their content doesn't depend on the scroll position.
+        //! The page is only moved to whole device pixels.
+        const PointF origin(snapToDevicePixel(pageRect.left() - margin), snapToDevicePixel(pageRect.top() - margin));
+        const RectF tiledRect(origin, SizeF(pageRect.width() + 2 * margin, pageRect.height() + 2 * margin));
+        const RectF visibleRect = tiledRect.intersected(rect);
+        if (visibleRect.isEmpty()) {
+            continue;
+        }
+
+        const int firstColumn = static_cast<int>(std::floor((visibleRect.left() - origin.x()) / tileSize));
+        const int lastColumn = static_cast<int>(std::ceil((visibleRect.right() - origin.x()) / tileSize)) - 1;
+        const int firstRow = static_cast<int>(std::floor((visibleRect.top() - origin.y()) / tileSize));
+        const int lastRow = static_cast<int>(std::ceil((visibleRect.bottom() - origin.y()) / tileSize)) - 1;
+
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                const PointF tileOffset(column * tileSize - margin, row * tileSize - margin);
+                const RectF canvasRect(pagePos + tileOffset / scaling, SizeF(tileSize / scaling, tileSize / scaling));
+
+                NotationTileCache::TileKey key;
+                key.pageIndex = pageIndex;
+                key.column = column;
+                key.row = row;
+                key.scaling = scaling;
+                key.devicePixelRatio = devicePixelRatio;
+                key.isPrinting = isPrinting;
+
+                const QPixmap& tile = m_tileCache.tile(key, canvasRect, page->contentRevision(), [&](QPixmap& pixmap) {
+                    Transform tileTransform;
+                    tileTransform.translate(-tileOffset.x(), -tileOffset.y());
+                    tileTransform.scale(scaling, scaling);
+                    tileTransform.translate(-pagePos.x(), -pagePos.y());
+
+                    mu::draw::Painter tilePainter(&pixmap, "notationtile");
+                    tilePainter.setWorldTransform(tileTransform);
+                    notation()->painting()->paintViewPage(&tilePainter, pageIndex, canvasRect, isPrinting);
+                });
+
+                painter->drawPixmap(origin + PointF(column * tileSize, row * tileSize), tile);
+            }
+        }
+    }
+
+    return true;
+}
+
+void NotationPaintView::updatePaintStatistics(qreal paintTimeMs)
+{
+    m_lastPaintTimeMs = paintTimeMs;
+    m_totalPaintTimeMs += paintTimeMs;
+    ++m_paintCount;
+
+    if (m_paintCount < PAINT_STATISTICS_INTERVAL) {
+        return;
+    }
+
+    const NotationTileCache::Statistics& statistics = m_tileCache.statistics();
+    LOGD() << "paint time: average " << m_totalPaintTimeMs / m_paintCount << " ms, last " << m_lastPaintTimeMs << " ms"
+           << ", tile cache hit rate: " << statistics.hitRate() * 100.0 << "% (" << statistics.hits << " hits, "
+           << statistics.misses << " misses, " << m_tileCache.tileCount() << " tiles, "
+           << m_tileCache.memoryUsage() / 1024 << " KB)";
+
+    m_paintCount = 0;
+    m_totalPaintTimeMs = 0.0;
+    m_tileCache.resetStatistics();
+}
+
+const NotationTileCache::Statistics& NotationPaintView::tileCacheStatistics() const
+{
+    return m_tileCache.statistics();
+}
+
+qreal NotationPaintView::lastPaintTimeMs() const
+{
+    return m_lastPaintTimeMs;
+}
+
+void NotationPaintView::invalidateTiles()
+{
+    m_tileCache.invalidate();
+    m_selectedElementsRects = selectedElementsRects();
+}
+
+void NotationPaintView::invalidateSelectionTiles()
+{
+    //! NOTE Selecting an element only changes its color,
+    //! so only the tiles of the elements, that were or are selected, need to be painted again
+    std::vector<RectF> rects = selectedElementsRects();
+
+    for (const RectF& rect : m_selectedElementsRects) {
+        m_tileCache.invalidate(rect);
+    }
+
+    for (const RectF& rect : rects) {
+        m_tileCache.invalidate(rect);
+    }
+
+    m_selectedElementsRects = std::move(rects);
+}
+
+std::vector<RectF> NotationPaintView::selectedElementsRects() const
+{
+    std::vector<RectF> rects;
+
+    INotationSelectionPtr selection = notationSelection();
+    if (!selection) {
+        return rects;
+    }
+
+    for (const EngravingItem* element : selection->elements()) {
+        qreal margin = element->spatium();
+        rects.push_back(element->canvasBoundingRect().adjusted(-margin, -margin, margin, margin));
+    }
+
+    return rects;
 }
 
 void NotationPaintView::onNotationSetup()
@@ -487,14 +666,22 @@ void NotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        invalidateTiles();
         update();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        invalidateTiles();
         update();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        invalidateTiles();
+        update();
+    });
+
+    engravingConfiguration()->selectionColorChanged().onReceive(this, [this](engraving::voice_idx_t, const draw::Color&) {
+        invalidateTiles();
         update();
     });
 }
@@ -1034,6 +1221,7 @@ void NotationPaintView::setNotation(INotationPtr notation)
 {
     clear();
     m_notation = notation;
+    invalidateTiles();
     update();
 }
 
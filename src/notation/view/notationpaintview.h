@@ -45,6 +45,7 @@
 #include "playbackcursor.h"
 #include "loopmarker.h"
 #include "continuouspanel.h"
+#include "notationtilecache.h"
 
 namespace mu::notation {
 class NotationPaintView : public QQuickPaintedItem, public IControlledView, public async::Asyncable, public actions::Actionable
@@ -132,6 +133,9 @@ public:
     bool accessibilityEnabled() const;
     void setAccessibilityEnabled(bool accessibilityEnabled);
 
+    const NotationTileCache::Statistics& tileCacheStatistics() const;
+    qreal lastPaintTimeMs() const;
+
 signals:
     void showContextMenuRequested(int elementType, const QPointF& viewPos);
     void hideContextMenuRequested();
@@ -221,6 +225,12 @@ private:
     PointF alignToCurrentPageBorder(const RectF& showRect, const PointF& pos) const;
 
     void paintBackground(const RectF& rect, draw::Painter* painter);
+    bool paintTiles(draw::Painter* painter, const RectF& rect, const Transform& transform, bool isPrinting);
+    void updatePaintStatistics(qreal paintTimeMs);
+
+    void invalidateTiles();
+    void invalidateSelectionTiles();
+    std::vector<RectF> selectedElementsRects() const;
 
     PointF canvasCenter() const;
     std::pair<qreal, qreal> constraintCanvas(qreal dx, qreal dy) const;
@@ -244,6 +254,14 @@ private:
 
     bool m_autoScrollEnabled = true;
     QTimer m_enableAutoScrollTimer;
+
+    NotationTileCache m_tileCache;
+    bool m_notationChangedSinceLastPaint = false;
+    std::vector<RectF> m_selectedElementsRects;
+
+    size_t m_paintCount = 0;
+    qreal m_lastPaintTimeMs = 0.0;
+    qreal m_totalPaintTimeMs = 0.0;
 };
 }
 
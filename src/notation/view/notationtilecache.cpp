@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtilecache.h"
+
+#include <tuple>
+
+using namespace mu::notation;
+
+bool NotationTileCache::TileKey::operator<(const TileKey& other) const
+{
+    return std::tie(scaling, devicePixelRatio, isPrinting, pageIndex, row, column)
+           < std::tie(other.scaling, other.devicePixelRatio, other.isPrinting, other.pageIndex, other.row, other.column);
+}
+
+qreal NotationTileCache::Statistics::hitRate() const
+{
+    size_t total = hits + misses;
+    return total > 0 ? static_cast<qreal>(hits) / static_cast<qreal>(total) : 0.0;
+}
+
+NotationTileCache::NotationTileCache(size_t maxMemoryBytes)
+    : m_maxMemoryBytes(maxMemoryBytes)
+{
+}
+
+void NotationTileCache::beginFrame()
+{
+    ++m_frame;
+}
+
+const QPixmap& NotationTileCache::tile(const TileKey& key, const RectF& canvasRect, uint64_t pageRevision, const RenderFunc& render)
+{
+    auto it = m_tiles.find(key);
+    if (it != m_tiles.end()) {
+        if (it->second.pageRevision == pageRevision) {
+            ++m_statistics.hits;
+            it->second.lastUsedFrame = m_frame;
+            return it->second.pixmap;
+        }
+
+        m_memoryBytes -= tileBytes(it->second.pixmap);
+        m_tiles.erase(it);
+    }
+
+    ++m_statistics.misses;
+
+    Tile tile;
+    tile.canvasRect = canvasRect;
+    tile.pageRevision = pageRevision;
+    tile.lastUsedFrame = m_frame;
+    tile.pixmap = QPixmap(qRound(TILE_SIZE * key.devicePixelRatio), qRound(TILE_SIZE * key.devicePixelRatio));
+    tile.pixmap.setDevicePixelRatio(key.devicePixelRatio);
+    tile.pixmap.fill(Qt::transparent);
+    render(tile.pixmap);
+
+    m_memoryBytes += tileBytes(tile.pixmap);
+    evict();
+
+    return m_tiles.emplace(key, std::move(tile)).first->second.pixmap;
+}
+
+void NotationTileCache::invalidate()
+{
+    m_tiles.clear();
+    m_memoryBytes = 0;
+}
+
+void NotationTileCache::invalidate(const RectF& canvasRect)
+{
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (it->second.canvasRect.intersects(canvasRect)) {
+            m_memoryBytes -= tileBytes(it->second.pixmap);
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t NotationTileCache::tileCount() const
+{
+    return m_tiles.size();
+}
+
+size_t NotationTileCache::memoryUsage() const
+{
+    return m_memoryBytes;
+}
+
+const NotationTileCache::Statistics& NotationTileCache::statistics() const
+{
+    return m_statistics;
+}
+
+void NotationTileCache::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+size_t NotationTileCache::tileBytes(const QPixmap& pixmap)
+{
+    return static_cast<size_t>(pixmap.width()) * static_cast<size_t>(pixmap.height()) * static_cast<size_t>(pixmap.depth() / 8);
+}
+
+void NotationTileCache::evict()
+{
+    while (m_memoryBytes > m_maxMemoryBytes) {
+        auto oldest = m_tiles.end();
+        for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+            if (it->second.lastUsedFrame == m_frame) {
+                continue;
+            }
+
+            if (oldest == m_tiles.end() || it->second.lastUsedFrame < oldest->second.lastUsedFrame) {
+                oldest = it;
+            }
+        }
+
+        if (oldest == m_tiles.end()) {
+            return;
+        }
+
+        m_memoryBytes -= tileBytes(oldest->second.pixmap);
+        m_tiles.erase(oldest);
+    }
+}
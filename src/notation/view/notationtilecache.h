@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <functional>
+#include <map>
+
+#include <QPixmap>
+
+#include "engraving/infrastructure/draw/geometry.h"
+
+namespace mu::notation {
+//! NOTE Raster tiles of the painted pages, so that scrolling, zooming back
+//! and repainting overlays (cursors, lasso, ...) don't need to paint the score again.
+//! The tiles are anchored at the page they belong to. A tile is painted again when the
+//! content revision of its page changes or when the area of the canvas it shows is invalidated.
+class NotationTileCache
+{
+public:
+    //! NOTE Size of a tile in view pixels
+    static constexpr int TILE_SIZE = 256;
+
+    struct TileKey {
+        int pageIndex = 0;
+        int column = 0;
+        int row = 0;
+        qreal scaling = 0.0;
+        qreal devicePixelRatio = 0.0;
+        bool isPrinting = false;
+
+        bool operator<(const TileKey& other) const;
+    };
+
+    struct Statistics {
+        size_t hits = 0;
+        size_t misses = 0;
+
+        qreal hitRate() const;
+    };
+
+    using RenderFunc = std::function<void (QPixmap& pixmap)>;
+
+    NotationTileCache(size_t maxMemoryBytes = DEFAULT_MAX_MEMORY_BYTES);
+
+    //! NOTE Tiles used since the last call are never evicted
+    void beginFrame();
+
+    //! NOTE canvasRect is the area of the canvas (in logical coordinates) painted on the tile,
+    //! pageRevision is the content revision of the page (see Page::contentRevision)
+    const QPixmap& tile(const TileKey& key, const RectF& canvasRect, uint64_t pageRevision, const RenderFunc& render);
+
+    void invalidate();
+    void invalidate(const RectF& canvasRect);
+
+    size_t tileCount() const;
+    size_t memoryUsage() const;
+
+    const Statistics& statistics() const;
+    void resetStatistics();
+
+private:
+    static constexpr size_t DEFAULT_MAX_MEMORY_BYTES = 128 * 1024 * 1024;
+
+    struct Tile {
+        QPixmap pixmap;
+        RectF canvasRect;
+        uint64_t pageRevision = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    static size_t tileBytes(const QPixmap& pixmap);
+    void evict();
+
+    std::map<TileKey, Tile> m_tiles;
+    size_t m_maxMemoryBytes = 0;
+    size_t m_memoryBytes = 0;
+    uint64_t m_frame = 0;
+    Statistics m_statistics;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
@@ -164,7 +164,9 @@ void PaletteCellIconEngine::paintScoreElement(Painter& painter, EngravingItem* e
 
     painter.save();
 
-    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / uiConfiguration()->logicalDpi();
+    mu::engraving::RenderContext renderContext = mu::engraving::RenderContext::current();
+    renderContext.pixelRatio = mu::engraving::DPI / uiConfiguration()->logicalDpi();
+    mu::engraving::RenderContext::Scope renderScope(renderContext);
 
     const qreal sizeRatio = spatium / gpaletteScore->spatium();
     painter.scale(sizeRatio, sizeRatio); // scale coordinates so element is drawn at correct size
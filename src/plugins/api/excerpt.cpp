@@ -32,6 +32,9 @@ namespace PluginAPI {
 
 Score* Excerpt::partScore()
 {
+    if (e->excerptScore()) {
+        e->excerptScore()->ensureLayout();
+    }
     return wrap<Score>(e->excerptScore(), Ownership::SCORE);
 }
 
@@ -23,6 +23,8 @@
 #ifndef MU_PROJECT_INOTATIONWRITERSREGISTER_H
 #define MU_PROJECT_INOTATIONWRITERSREGISTER_H
 
+#include <functional>
+
 #include "modularity/imoduleexport.h"
 #include "inotationwriter.h"
 
@@ -34,8 +36,15 @@ class INotationWritersRegister : MODULE_EXPORT_INTERFACE
 public:
     virtual ~INotationWritersRegister() = default;
 
+    using WriterCreator = std::function<INotationWriterPtr()>;
+
     virtual void reg(const std::vector<std::string>& suffixes, INotationWriterPtr writer) = 0;
     virtual INotationWriterPtr writer(const std::string& suffix) const = 0;
+
+    //! NOTE Writers registered with a creator can be used from several threads at once,
+    //! each thread with its own instance returned by newWriter
+    virtual void regCreator(const std::vector<std::string>& suffixes, const WriterCreator& creator) = 0;
+    virtual INotationWriterPtr newWriter(const std::string& suffix) const = 0;
 };
 }
 
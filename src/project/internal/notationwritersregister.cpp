@@ -40,3 +40,22 @@ INotationWriterPtr NotationWritersRegister::writer(const std::string& suffix) co
 
     return nullptr;
 }
+
+void NotationWritersRegister::regCreator(const std::vector<std::string>& suffixes, const WriterCreator& creator)
+{
+    reg(suffixes, creator());
+
+    for (const std::string& suffix : suffixes) {
+        m_creators.insert({ suffix, creator });
+    }
+}
+
+INotationWriterPtr NotationWritersRegister::newWriter(const std::string& suffix) const
+{
+    auto it = m_creators.find(suffix);
+    if (it != m_creators.end()) {
+        return it->second();
+    }
+
+    return nullptr;
+}
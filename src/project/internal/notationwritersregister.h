@@ -32,8 +32,12 @@ public:
     void reg(const std::vector<std::string>& suffixes, INotationWriterPtr writer) override;
     INotationWriterPtr writer(const std::string& suffix) const override;
 
+    void regCreator(const std::vector<std::string>& suffixes, const WriterCreator& creator) override;
+    INotationWriterPtr newWriter(const std::string& suffix) const override;
+
 private:
     std::map<std::string, INotationWriterPtr> m_writers;
+    std::map<std::string, WriterCreator> m_creators;
 };
 }
 
@@ -43,6 +43,11 @@ unsigned int AudioConfigurationStub::driverBufferSize() const
     return 0;
 }
 
+size_t AudioConfigurationStub::mixerThreadsCount() const
+{
+    return 0;
+}
+
 bool AudioConfigurationStub::isShowControlsInMixer() const
 {
     return false;
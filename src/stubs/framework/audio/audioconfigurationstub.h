@@ -37,6 +37,8 @@ public:
     int audioChannelsCount() const override;
     unsigned int driverBufferSize() const override;  // samples
 
+    size_t mixerThreadsCount() const override;
+
     // synthesizers
     std::vector<io::path_t> soundFontPaths() const override;
     const synth::SynthesizerState& synthesizerState() const override;
@@ -25,6 +25,11 @@
  *
  * This is a wrapper around fluid_sffile_read_sample_data that attempts to cache the read
  * data across all FluidSynth instances in a global (process-wide) list.
+ *
+ * MuseScore patch: the entries that aren't referenced anymore are kept up to
+ * fluid_samplecache_set_unused_limit() bytes and dropped least recently used first,
+ * so that the samples of a preset selected again don't have to be decoded again.
+ * Entries pointing into a memory-mapped file cost nothing to recreate and are never kept.
  */
 
 #include "fluid_samplecache.h"
@@ -54,16 +59,24 @@ struct _fluid_samplecache_entry_t
 
     int num_references;
     int mlocked;
+    int mapped;
+    unsigned int last_used;
 };
 
 static fluid_list_t *samplecache_list = NULL;
 static fluid_mutex_t samplecache_mutex = FLUID_MUTEX_INIT;
 
+static size_t samplecache_unused_limit = 0;
+static size_t samplecache_unused_size = 0;
+static unsigned int samplecache_clock = 0;
+
 static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf, unsigned int sample_start,
         unsigned int sample_end, int sample_type, time_t mtime);
 static fluid_samplecache_entry_t *get_samplecache_entry(SFData *sf, unsigned int sample_start,
         unsigned int sample_end, int sample_type, time_t mtime);
 static void delete_samplecache_entry(fluid_samplecache_entry_t *entry);
+static size_t samplecache_entry_size(const fluid_samplecache_entry_t *entry);
+static void drop_unused_samplecache_entries(void);
 
 static int fluid_get_file_modification_time(char *filename, time_t *modification_time);
 
@@ -99,6 +112,11 @@ int fluid_samplecache_load(SFData *sf,
 
         samplecache_list = fluid_list_prepend(samplecache_list, entry);
     }
+    else if(entry->num_references == 0)
+    {
+        /* The entry is taken back from the unused ones */
+        samplecache_unused_size -= samplecache_entry_size(entry);
+    }
 
     if(try_mlock && !entry->mlocked)
     {
@@ -161,10 +179,21 @@ int fluid_samplecache_unload(const short *sample_data)
                     {
                         fluid_munlock(entry->sample_data24, entry->sample_count);
                     }
+
+                    entry->mlocked = FALSE;
                 }
 
-                samplecache_list = fluid_list_remove(samplecache_list, entry);
-                delete_samplecache_entry(entry);
+                if(!entry->mapped && samplecache_unused_limit > 0)
+                {
+                    entry->last_used = ++samplecache_clock;
+                    samplecache_unused_size += samplecache_entry_size(entry);
+                    drop_unused_samplecache_entries();
+                }
+                else
+                {
+                    samplecache_list = fluid_list_remove(samplecache_list, entry);
+                    delete_samplecache_entry(entry);
+                }
             }
 
             ret = FLUID_OK;
@@ -182,6 +211,16 @@ unlock_exit:
     return ret;
 }
 
+void fluid_samplecache_set_unused_limit(size_t limit)
+{
+    fluid_mutex_lock(samplecache_mutex);
+
+    samplecache_unused_limit = limit;
+    drop_unused_samplecache_entries();
+
+    fluid_mutex_unlock(samplecache_mutex);
+}
+
 
 /* Private functions */
 static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf,
@@ -220,7 +259,7 @@ static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf,
     entry->modification_time = mtime;
 
     entry->sample_count = fluid_sffile_read_sample_data(sf, sample_start, sample_end, sample_type,
-                          &entry->sample_data, &entry->sample_data24);
+                          &entry->sample_data, &entry->sample_data24, &entry->mapped);
 
     if(entry->sample_count < 0)
     {
@@ -239,11 +278,61 @@ static void delete_samplecache_entry(fluid_samplecache_entry_t *entry)
     fluid_return_if_fail(entry != NULL);
 
     FLUID_FREE(entry->filename);
-    FLUID_FREE(entry->sample_data);
+
+    if(!entry->mapped)
+    {
+        FLUID_FREE(entry->sample_data);
+    }
+
     FLUID_FREE(entry->sample_data24);
     FLUID_FREE(entry);
 }
 
+static size_t samplecache_entry_size(const fluid_samplecache_entry_t *entry)
+{
+    size_t size = entry->sample_count * sizeof(short);
+
+    if(entry->sample_data24 != NULL)
+    {
+        size += entry->sample_count;
+    }
+
+    return size;
+}
+
+/* Drops the least recently used unreferenced entries until they fit into the limit */
+static void drop_unused_samplecache_entries(void)
+{
+    fluid_list_t *entry_list;
+    fluid_samplecache_entry_t *entry;
+    fluid_samplecache_entry_t *oldest;
+
+    while(samplecache_unused_size > samplecache_unused_limit)
+    {
+        oldest = NULL;
+
+        for(entry_list = samplecache_list; entry_list; entry_list = fluid_list_next(entry_list))
+        {
+            entry = (fluid_samplecache_entry_t *)fluid_list_get(entry_list);
+
+            if(entry->num_references == 0 && (oldest == NULL || entry->last_used < oldest->last_used))
+            {
+                oldest = entry;
+            }
+        }
+
+        if(oldest == NULL)
+        {
+            samplecache_unused_size = 0;
+            break;
+        }
+
+        samplecache_unused_size -= samplecache_entry_size(oldest);
+        samplecache_list = fluid_list_remove(samplecache_list, oldest);
+        delete_samplecache_entry(oldest);
+    }
+}
+
 static fluid_samplecache_entry_t *get_samplecache_entry(SFData *sf,
         unsigned int sample_start,
         unsigned int sample_end,
@@ -31,4 +31,7 @@ int fluid_samplecache_load(SFData *sf,
 
 int fluid_samplecache_unload(const short *sample_data);
 
+/* MuseScore patch: how many bytes of the sample data that isn't used anymore are kept cached */
+void fluid_samplecache_set_unused_limit(size_t limit);
+
 #endif /* _FLUID_SAMPLECACHE_H */
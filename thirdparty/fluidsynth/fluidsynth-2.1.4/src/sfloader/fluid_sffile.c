@@ -326,7 +326,7 @@ static void delete_inst(SFInst *inst);
 static void delete_zone(SFZone *zone);
 
 static int fluid_sffile_read_vorbis(SFData *sf, unsigned int start_byte, unsigned int end_byte, short **data);
-static int fluid_sffile_read_wav(SFData *sf, unsigned int start, unsigned int end, short **data, char **data24);
+static int fluid_sffile_read_wav(SFData *sf, unsigned int start, unsigned int end, short **data, char **data24, int *mapped);
 
 /**
  * Check if a file is a SoundFont file.
@@ -491,21 +491,25 @@ int fluid_sffile_parse_presets(SFData *sf)
  * @param data pointer to sample data pointer, will point to loaded sample data on success
  * @param data24 pointer to 24-bit sample data pointer if 24-bit data present, will point to loaded
  *               24-bit sample data on success or NULL if no 24-bit data is present in file
+ * @param mapped set to TRUE if data points into the memory-mapped file instead of an allocated
+ *               buffer, so it must not be freed (MuseScore patch)
  *
  * @return The number of sample words in returned buffers or -1 on failure
  */
 int fluid_sffile_read_sample_data(SFData *sf, unsigned int sample_start, unsigned int sample_end,
-                                  int sample_type, short **data, char **data24)
+                                  int sample_type, short **data, char **data24, int *mapped)
 {
     int num_samples;
 
+    *mapped = FALSE;
+
     if(sample_type & FLUID_SAMPLETYPE_OGG_VORBIS)
     {
         num_samples = fluid_sffile_read_vorbis(sf, sample_start, sample_end, data);
     }
     else
     {
-        num_samples = fluid_sffile_read_wav(sf, sample_start, sample_end, data, data24);
+        num_samples = fluid_sffile_read_wav(sf, sample_start, sample_end, data, data24, mapped);
     }
 
     return num_samples;
@@ -2375,10 +2379,11 @@ static int valid_preset_genid(unsigned short genid)
 }
 
 
-static int fluid_sffile_read_wav(SFData *sf, unsigned int start, unsigned int end, short **data, char **data24)
+static int fluid_sffile_read_wav(SFData *sf, unsigned int start, unsigned int end, short **data, char **data24, int *mapped)
 {
     short *loaded_data = NULL;
     char *loaded_data24 = NULL;
+    const short *mapped_data = NULL;
 
     int num_samples = (end + 1) - start;
     fluid_return_val_if_fail(num_samples > 0, -1);
@@ -2389,6 +2394,20 @@ static int fluid_sffile_read_wav(SFData *sf, unsigned int start, unsigned int en
         goto error_exit;
     }
 
+    /* MuseScore patch: the 16 bit samples are stored little endian, so on little endian machines
+     * they can be used right from the memory-mapped file, shared by all the synths and processes */
+    if(!FLUID_IS_BIG_ENDIAN && sf->fcbs->fmap != NULL)
+    {
+        mapped_data = sf->fcbs->fmap(sf->sffd, sf->samplepos + (start * sizeof(short)), num_samples * sizeof(short));
+
+        if(mapped_data != NULL && ((uintptr_t)mapped_data % sizeof(short)) == 0)
+        {
+            *data = (short *)mapped_data;
+            *mapped = TRUE;
+            goto load_data24;
+        }
+    }
+
     /* Load 16-bit sample data */
     if(sf->fcbs->fseek(sf->sffd, sf->samplepos + (start * sizeof(short)), SEEK_SET) == FLUID_FAILED)
     {
@@ -2423,6 +2442,7 @@ static int fluid_sffile_read_wav(SFData *sf, unsigned int start, unsigned int en
 
     *data = loaded_data;
 
+load_data24:
     /* Optionally load additional 8 bit sample data for 24-bit support. Any failures while loading
      * the 24-bit sample data will be logged as errors but won't prevent the sample reading to
      * fail, as sound output is still possible with the 16-bit sample data. */
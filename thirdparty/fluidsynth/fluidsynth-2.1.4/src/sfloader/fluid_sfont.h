@@ -57,6 +57,13 @@ int fluid_sample_sanitize_loop(fluid_sample_t *sample, unsigned int max_end);
 
 
 
+/**
+ * Optional callback returning a read-only pointer to \a count bytes at \a offset of the file,
+ * or NULL if that part of the file can't be accessed directly (MuseScore patch).
+ * The pointer has to stay valid as long as the soundfont file is cached by the loader.
+ */
+typedef const void *(* fluid_sfloader_callback_map_t)(void *handle, long offset, long count);
+
 /**
  * File callback structure to enable custom soundfont loading (e.g. from memory).
  */
@@ -67,6 +74,7 @@ struct _fluid_file_callbacks_t
     fluid_sfloader_callback_seek_t  fseek;
     fluid_sfloader_callback_close_t fclose;
     fluid_sfloader_callback_tell_t  ftell;
+    fluid_sfloader_callback_map_t   fmap; /* may be NULL */
 };
 
 /**
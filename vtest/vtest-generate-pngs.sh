@@ -27,12 +27,14 @@ SCORES_DIR="$HERE/scores"
 OUTPUT_DIR="./vtest_pngs"
 MSCORE_BIN=build.debug/install/bin/mscore
 DPI=130
+JOB_WORKERS=""
 
 while [[ "$#" -gt 0 ]]; do
     case $1 in
         -s|--scores) SCORES_DIR="$2"; shift ;;
         -o|--output-dir) OUTPUT_DIR="$2"; shift ;;
         -m|--mscore) MSCORE_BIN="$2"; shift ;;
+        -w|--job-workers) JOB_WORKERS="$2"; shift ;;
         *) echo "Unknown parameter passed: $1"; exit 1 ;;
     esac
     shift
@@ -43,6 +45,7 @@ echo "SCORES_DIR: $SCORES_DIR"
 echo "OUTPUT_DIR: $OUTPUT_DIR"
 echo "MSCORE_BIN: $MSCORE_BIN"
 echo "DPI: $DPI"
+echo "JOB_WORKERS: $JOB_WORKERS"
 echo "::endgroup::"
 
 rm -rf $OUTPUT_DIR
@@ -50,6 +53,7 @@ mkdir -p $OUTPUT_DIR
 
 LOG_FILE=$OUTPUT_DIR/convert.log
 JSON_FILE=$OUTPUT_DIR/vtestjob.json
+REPORT_FILE=$OUTPUT_DIR/vtestreport.json
 
 echo "::group::Generating JSON job file"
 echo "[" >> $JSON_FILE
@@ -63,9 +67,33 @@ cat $JSON_FILE
 echo "::endgroup::"
 
 echo "::group::Generating PNG files"
-$MSCORE_BIN -j $JSON_FILE -r $DPI 2>&1 | tee $LOG_FILE && SUCCESS="true"
+if [ -z "$JOB_WORKERS" ]; then
+    $MSCORE_BIN -j $JSON_FILE -r $DPI 2>&1 | tee $LOG_FILE && SUCCESS="true"
+else
+    $MSCORE_BIN -j $JSON_FILE -r $DPI --job-workers $JOB_WORKERS --job-report $REPORT_FILE 2>&1 | tee $LOG_FILE && SUCCESS="true"
+fi
 echo "::endgroup::"
 
+if [ -n "$JOB_WORKERS" ]; then
+    echo "::group::Checking job report"
+    cat $REPORT_FILE
+    echo ""
+
+    SCORES_COUNT=$(echo "$SCORES_LIST" | wc -w)
+    if ! grep -q "\"total\":$SCORES_COUNT[,}]" $REPORT_FILE || ! grep -q "\"failed\":0," $REPORT_FILE; then
+        echo "The report doesn't list $SCORES_COUNT succeeded jobs"
+        SUCCESS=""
+    fi
+
+    for score in $SCORES_LIST ; do
+        if ! test -f $OUTPUT_DIR/${score%.*}-1.png; then
+            echo "No output for: $score"
+            SUCCESS=""
+        fi
+    done
+    echo "::endgroup::"
+fi
+
 if [ -z "$SUCCESS" ]; then
     echo -e "\033[0;31mGenerating PNGs failed!\033[0m"
 fi